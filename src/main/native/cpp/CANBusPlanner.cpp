@@ -0,0 +1,226 @@
+#include "ctre/phoenix/CANBusPlanner.h"
+#include "ctre/phoenix/CANifier.h"
+#include "ctre/phoenix/motorcontrol/can/BaseMotorController.h"
+#include "ctre/phoenix/sensors/PigeonIMU.h"
+#include <stdio.h>
+
+using namespace ctre::phoenix::motorcontrol;
+using namespace ctre::phoenix::motorcontrol::can;
+using namespace ctre::phoenix::sensors;
+
+namespace ctre {
+namespace phoenix {
+
+static std::string FrameName(const char * device, int deviceNumber, const char * kind, int frameId) {
+	char name[64];
+	snprintf(name, sizeof(name), "%s %d %s 0x%X", device, deviceNumber, kind, (unsigned)frameId);
+	return name;
+}
+static double BitsPerSecond(const CANBusFrame & frame, int periodMs) {
+	if (periodMs <= 0)
+		return 0;
+	return CANBusPlanner::GetFrameBits(frame.dataBytes) * 1000.0 / periodMs;
+}
+
+int CANBusPlanner::AddFrame(const CANBusFrame & frame) {
+	_frames.push_back(frame);
+	return (int)_frames.size() - 1;
+}
+ErrorCode CANBusPlanner::AddMotorController(BaseMotorController & motor, int priority,
+		int controlPeriodMs, int timeoutMs) {
+	static const StatusFrameEnhanced frames[] = {
+		StatusFrameEnhanced::Status_1_General,
+		StatusFrameEnhanced::Status_2_Feedback0,
+		StatusFrameEnhanced::Status_3_Quadrature,
+		StatusFrameEnhanced::Status_4_AinTempVbat,
+		StatusFrameEnhanced::Status_8_PulseWidth,
+		StatusFrameEnhanced::Status_10_Targets,
+		StatusFrameEnhanced::Status_12_Feedback1,
+		StatusFrameEnhanced::Status_13_Base_PIDF0,
+		StatusFrameEnhanced::Status_14_Turn_PIDF1,
+	};
+	int deviceId = motor.GetDeviceID();
+	int added = 0;
+	for (StatusFrameEnhanced statusFrame : frames) {
+		int periodMs = motor.GetStatusFramePeriod(statusFrame, timeoutMs);
+		if (periodMs <= 0)
+			continue;
+		CANBusFrame frame;
+		frame.name = FrameName("motor controller", deviceId, "status", statusFrame);
+		frame.periodMs = periodMs;
+		frame.priority = priority;
+		BaseMotorController * pMotor = &motor;
+		frame.setter = [pMotor, statusFrame](int newPeriodMs) {
+			return pMotor->SetStatusFramePeriod(statusFrame, (uint8_t)newPeriodMs, 0);
+		};
+		AddFrame(frame);
+		++added;
+	}
+	if (added == 0)
+		return RxTimeout;
+
+	CANBusFrame control;
+	control.name = FrameName("motor controller", deviceId, "control", ControlFrame::Control_3_General);
+	control.periodMs = controlPeriodMs;
+	control.priority = priority;
+	BaseMotorController * pMotor = &motor;
+	control.setter = [pMotor](int newPeriodMs) {
+		return pMotor->SetControlFramePeriod(ControlFrame::Control_3_General, newPeriodMs);
+	};
+	AddFrame(control);
+	return OK;
+}
+ErrorCode CANBusPlanner::AddPigeonIMU(PigeonIMU & pigeon, int priority, int timeoutMs) {
+	static const PigeonIMU_StatusFrame frames[] = {
+		PigeonIMU_CondStatus_1_General,
+		PigeonIMU_CondStatus_9_SixDeg_YPR,
+		PigeonIMU_CondStatus_6_SensorFusion,
+		PigeonIMU_CondStatus_11_GyroAccum,
+		PigeonIMU_CondStatus_2_GeneralCompass,
+		PigeonIMU_CondStatus_3_GeneralAccel,
+		PigeonIMU_CondStatus_10_SixDeg_Quat,
+		PigeonIMU_BiasedStatus_2_Gyro,
+		PigeonIMU_BiasedStatus_4_Mag,
+		PigeonIMU_BiasedStatus_6_Accel,
+	};
+	int deviceId = pigeon.GetDeviceNumber();
+	int added = 0;
+	for (PigeonIMU_StatusFrame statusFrame : frames) {
+		int periodMs = pigeon.GetStatusFramePeriod(statusFrame, timeoutMs);
+		if (periodMs <= 0)
+			continue;
+		CANBusFrame frame;
+		frame.name = FrameName("pigeon", deviceId, "status", statusFrame);
+		frame.periodMs = periodMs;
+		frame.priority = priority;
+		PigeonIMU * pPigeon = &pigeon;
+		frame.setter = [pPigeon, statusFrame](int newPeriodMs) {
+			return pPigeon->SetStatusFramePeriod(statusFrame, (uint8_t)newPeriodMs, 0);
+		};
+		AddFrame(frame);
+		++added;
+	}
+	return (added == 0) ? RxTimeout : OK;
+}
+ErrorCode CANBusPlanner::AddCANifier(CANifier & canifier, int priority, int timeoutMs) {
+	static const CANifierStatusFrame frames[] = {
+		CANifierStatusFrame_Status_1_General,
+		CANifierStatusFrame_Status_2_General,
+		CANifierStatusFrame_Status_3_PwmInputs0,
+		CANifierStatusFrame_Status_4_PwmInputs1,
+		CANifierStatusFrame_Status_5_PwmInputs2,
+		CANifierStatusFrame_Status_6_PwmInputs3,
+		CANifierStatusFrame_Status_8_Misc,
+	};
+	int deviceId = canifier.GetDeviceNumber();
+	int added = 0;
+	for (CANifierStatusFrame statusFrame : frames) {
+		int periodMs = canifier.GetStatusFramePeriod(statusFrame, timeoutMs);
+		if (periodMs <= 0)
+			continue;
+		CANBusFrame frame;
+		frame.name = FrameName("canifier", deviceId, "status", statusFrame);
+		frame.periodMs = periodMs;
+		frame.priority = priority;
+		CANifier * pCanifier = &canifier;
+		frame.setter = [pCanifier, statusFrame](int newPeriodMs) {
+			return pCanifier->SetStatusFramePeriod(statusFrame, (uint8_t)newPeriodMs, 0);
+		};
+		AddFrame(frame);
+		++added;
+	}
+	return (added == 0) ? RxTimeout : OK;
+}
+int CANBusPlanner::GetFrameBits(int dataBytes) {
+	if (dataBytes < 0)
+		dataBytes = 0;
+	if (dataBytes > 8)
+		dataBytes = 8;
+	/* SOF, 29 bit ID with SRR/IDE, RTR, r1/r0, DLC, data, CRC - the stuffed region */
+	int stuffedBits = 54 + 8 * dataBytes;
+	/* CRC delimiter, ACK slot and delimiter, EOF, interframe space */
+	int fixedBits = 1 + 2 + 7 + 3;
+	/* worst case, a stuff bit after every four bits following the first five */
+	int stuffBits = (stuffedBits - 1) / 4;
+	return stuffedBits + stuffBits + fixedBits;
+}
+double CANBusPlanner::GetBitsPerSecond() const {
+	double bps = 0;
+	for (const CANBusFrame & frame : _frames)
+		bps += BitsPerSecond(frame, frame.periodMs);
+	return bps;
+}
+double CANBusPlanner::GetUtilization() const {
+	return GetBitsPerSecond() / kBitRate;
+}
+double CANBusPlanner::GetPlannedUtilization() const {
+	double bps = 0;
+	for (const CANBusFrame & frame : _frames)
+		bps += BitsPerSecond(frame, frame.plannedPeriodMs);
+	return bps / kBitRate;
+}
+bool CANBusPlanner::IsOversubscribed(double targetUtilization) const {
+	return GetUtilization() > targetUtilization;
+}
+ErrorCode CANBusPlanner::Plan(double targetUtilization) {
+	if (targetUtilization <= 0)
+		return InvalidParamValue;
+
+	double bps = 0;
+	for (CANBusFrame & frame : _frames) {
+		int periodMs = frame.periodMs;
+		/* a frame without a setter cannot be changed, so it keeps its load */
+		if (!frame.setter) {
+			frame.plannedPeriodMs = periodMs;
+			bps += BitsPerSecond(frame, periodMs);
+			continue;
+		}
+		if (periodMs < frame.minPeriodMs)
+			periodMs = frame.minPeriodMs;
+		if (periodMs > frame.maxPeriodMs)
+			periodMs = frame.maxPeriodMs;
+		frame.plannedPeriodMs = periodMs;
+		bps += BitsPerSecond(frame, periodMs);
+	}
+
+	const double targetBps = targetUtilization * kBitRate;
+	while (bps > targetBps) {
+		/* slow the lowest priority frame, the most frequent one first */
+		CANBusFrame * slowest = nullptr;
+		for (CANBusFrame & frame : _frames) {
+			if (!frame.setter || frame.plannedPeriodMs >= frame.maxPeriodMs)
+				continue;
+			if (slowest == nullptr || frame.priority < slowest->priority ||
+					(frame.priority == slowest->priority && frame.plannedPeriodMs < slowest->plannedPeriodMs))
+				slowest = &frame;
+		}
+		if (slowest == nullptr)
+			return GeneralError; /* every changeable frame is already at its slowest */
+
+		int periodMs = slowest->plannedPeriodMs * 3 / 2;
+		if (periodMs <= slowest->plannedPeriodMs)
+			periodMs = slowest->plannedPeriodMs + 1;
+		if (periodMs > slowest->maxPeriodMs)
+			periodMs = slowest->maxPeriodMs;
+
+		bps -= BitsPerSecond(*slowest, slowest->plannedPeriodMs);
+		slowest->plannedPeriodMs = periodMs;
+		bps += BitsPerSecond(*slowest, periodMs);
+	}
+	return OK;
+}
+ErrorCode CANBusPlanner::Apply() {
+	ErrorCollection errorCollection;
+	for (CANBusFrame & frame : _frames) {
+		if (frame.plannedPeriodMs <= 0 || frame.plannedPeriodMs == frame.periodMs || !frame.setter)
+			continue;
+		ErrorCode er = frame.setter(frame.plannedPeriodMs);
+		errorCollection.NewError(er);
+		if (er == OK)
+			frame.periodMs = frame.plannedPeriodMs;
+	}
+	return errorCollection._worstError;
+}
+
+} // namespace phoenix
+} // namespace ctre
@@ -25,6 +25,18 @@
 #include "ctre/phoenix/cci/CANifier_CCI.h"
 #include "ctre/phoenix/CTRLogger.h"
 
+/**
+ * Single parameter getter used by batched config readbacks.
+ */
+static ctre::phoenix::ErrorCode GetParamForReadback(void * handle, ctre::phoenix::ParamEnum param, int ordinal, double & value, int timeoutMs) {
+	return c_CANifier_ConfigGetParameter(handle, param, &value, ordinal, timeoutMs);
+}
+static bool PollResetForShadow(void * handle) {
+	bool hasReset = false;
+	c_CANifier_HasResetOccurred(handle, &hasReset);
+	return hasReset;
+}
+
 namespace ctre {
 namespace phoenix {
 	
@@ -130,13 +142,26 @@ int CANifier::GetQuadraturePosition() {
 	(void)c_CANifier_GetQuadraturePosition(m_handle, &retval);
 	return retval;
 }
+/**
+ * Gets the quadrature encoder's position with the time of the read, see Timestamped.
+ *
+ * @param position Caller's value to update.
+ * @return Error Code of the read. 0 indicates the value is fresh.
+ */
+ErrorCode CANifier::GetQuadraturePosition(Timestamped<int> & position) {
+	int param = 0;
+	ErrorCode retval = (ErrorCode)c_CANifier_GetQuadraturePosition(m_handle, &param);
+	position.Update(param, retval, GetMonotonicUs());
+	return retval;
+}
 /**
  * Sets the position of the quadrature encoder.
  * @param newPosition
  * @return ErrorCode generated by function. 0 indicates no error.
  */
 ErrorCode CANifier::SetQuadraturePosition(int newPosition, int timeoutMs) {
-	return c_CANifier_SetQuadraturePosition(m_handle, newPosition, timeoutMs);
+	return _stats.Record(c_CANifier_SetQuadraturePosition(m_handle, newPosition, timeoutMs), __func__,
+			DeviceStats::Call_General, timeoutMs);
 }
 /**
  * Gets the velocity of the quadrature encoder.
@@ -147,6 +172,18 @@ int CANifier::GetQuadratureVelocity() {
 	(void)c_CANifier_GetQuadratureVelocity(m_handle, &retval);
 	return retval;
 }
+/**
+ * Gets the quadrature encoder's velocity with the time of the read, see Timestamped.
+ *
+ * @param velocity Caller's value to update.
+ * @return Error Code of the read. 0 indicates the value is fresh.
+ */
+ErrorCode CANifier::GetQuadratureVelocity(Timestamped<int> & velocity) {
+	int param = 0;
+	ErrorCode retval = (ErrorCode)c_CANifier_GetQuadratureVelocity(m_handle, &param);
+	velocity.Update(param, retval, GetMonotonicUs());
+	return retval;
+}
 /**
  * Configures the period of each velocity sample.
  * Every 1ms a position value is sampled, and the delta between that sample
@@ -162,7 +199,11 @@ int CANifier::GetQuadratureVelocity() {
  * @return Error Code generated by function. 0 indicates no error.
  */
 ErrorCode CANifier::ConfigVelocityMeasurementPeriod(CANifierVelocityMeasPeriod period, int timeoutMs) {
-	return c_CANifier_ConfigVelocityMeasurementPeriod(m_handle, period, timeoutMs);
+	if (Shadow().IsCurrent(eSampleVelocityPeriod, 0, period))
+		return OK;
+	DeviceStats::Call call(_stats, __func__, DeviceStats::Call_ConfigSet, timeoutMs);
+	return _configShadow.RecordWrite(call.Done(c_CANifier_ConfigVelocityMeasurementPeriod(m_handle, period, timeoutMs)),
+			eSampleVelocityPeriod, 0, period, timeoutMs);
 }
 /**
  * Sets the number of velocity samples used in the rolling average velocity
@@ -179,7 +220,11 @@ ErrorCode CANifier::ConfigVelocityMeasurementPeriod(CANifierVelocityMeasPeriod p
  * @return Error Code generated by function. 0 indicates no error.
  */
 ErrorCode CANifier::ConfigVelocityMeasurementWindow(int windowSize, int timeoutMs) {
-	return c_CANifier_ConfigVelocityMeasurementWindow(m_handle, windowSize, timeoutMs);
+	if (Shadow().IsCurrent(eSampleVelocityWindow, 0, windowSize))
+		return OK;
+	DeviceStats::Call call(_stats, __func__, DeviceStats::Call_ConfigSet, timeoutMs);
+	return _configShadow.RecordWrite(call.Done(c_CANifier_ConfigVelocityMeasurementWindow(m_handle, windowSize, timeoutMs)),
+			eSampleVelocityWindow, 0, windowSize, timeoutMs);
 }
 /**
  * Enables clearing the position of the feedback sensor when the forward 
@@ -193,7 +238,11 @@ ErrorCode CANifier::ConfigVelocityMeasurementWindow(int windowSize, int timeoutM
  * @return Error Code generated by function. 0 indicates no error.
  */
 ErrorCode CANifier::ConfigClearPositionOnLimitF(bool clearPositionOnLimitF, int timeoutMs) {
-	return c_CANifier_ConfigClearPositionOnLimitF(m_handle, clearPositionOnLimitF, timeoutMs);
+	if (Shadow().IsCurrent(eClearPositionOnLimitF, 0, clearPositionOnLimitF))
+		return OK;
+	DeviceStats::Call call(_stats, __func__, DeviceStats::Call_ConfigSet, timeoutMs);
+	return _configShadow.RecordWrite(call.Done(c_CANifier_ConfigClearPositionOnLimitF(m_handle, clearPositionOnLimitF, timeoutMs)),
+			eClearPositionOnLimitF, 0, clearPositionOnLimitF, timeoutMs);
 }
 /**
  * Enables clearing the position of the feedback sensor when the reverse 
@@ -207,7 +256,11 @@ ErrorCode CANifier::ConfigClearPositionOnLimitF(bool clearPositionOnLimitF, int
  * @return Error Code generated by function. 0 indicates no error.
  */
 ErrorCode CANifier::ConfigClearPositionOnLimitR(bool clearPositionOnLimitR, int timeoutMs) {
-	return c_CANifier_ConfigClearPositionOnLimitR(m_handle, clearPositionOnLimitR, timeoutMs);
+	if (Shadow().IsCurrent(eClearPositionOnLimitR, 0, clearPositionOnLimitR))
+		return OK;
+	DeviceStats::Call call(_stats, __func__, DeviceStats::Call_ConfigSet, timeoutMs);
+	return _configShadow.RecordWrite(call.Done(c_CANifier_ConfigClearPositionOnLimitR(m_handle, clearPositionOnLimitR, timeoutMs)),
+			eClearPositionOnLimitR, 0, clearPositionOnLimitR, timeoutMs);
 }
 /**
  * Enables clearing the position of the feedback sensor when the quadrature index signal
@@ -221,7 +274,11 @@ ErrorCode CANifier::ConfigClearPositionOnLimitR(bool clearPositionOnLimitR, int
  * @return Error Code generated by function. 0 indicates no error.
  */
 ErrorCode CANifier::ConfigClearPositionOnQuadIdx(bool clearPositionOnQuadIdx, int timeoutMs) {
-	return c_CANifier_ConfigClearPositionOnQuadIdx(m_handle, clearPositionOnQuadIdx, timeoutMs);
+	if (Shadow().IsCurrent(eClearPositionOnQuadIdx, 0, clearPositionOnQuadIdx))
+		return OK;
+	DeviceStats::Call call(_stats, __func__, DeviceStats::Call_ConfigSet, timeoutMs);
+	return _configShadow.RecordWrite(call.Done(c_CANifier_ConfigClearPositionOnQuadIdx(m_handle, clearPositionOnQuadIdx, timeoutMs)),
+			eClearPositionOnQuadIdx, 0, clearPositionOnQuadIdx, timeoutMs);
 }
 /**
  * Gets the bus voltage seen by the device.
@@ -233,6 +290,18 @@ double CANifier::GetBusVoltage() {
 	c_CANifier_GetBusVoltage(m_handle, &param);
 	return param;
 }
+/**
+ * Gets the bus voltage (in volts) with the time of the read, see Timestamped.
+ *
+ * @param busVoltage Caller's value to update.
+ * @return Error Code of the read. 0 indicates the value is fresh.
+ */
+ErrorCode CANifier::GetBusVoltage(Timestamped<double> & busVoltage) {
+	double param = 0;
+	ErrorCode retval = (ErrorCode)c_CANifier_GetBusVoltage(m_handle, &param);
+	busVoltage.Update(param, retval, GetMonotonicUs());
+	return retval;
+}
 
 /**
  * Call GetLastError() generated by this object.
@@ -296,6 +365,19 @@ ErrorCode CANifier::GetPWMInput(PWMChannel pwmChannel, double pulseWidthAndPerio
 	return c_CANifier_GetPWMInput(m_handle, pwmChannel,
 			pulseWidthAndPeriod);
 }
+/**
+ * Gets the PWM input duty cycle [0] and period [1] with the time of the read, see Timestamped.
+ *
+ * @param pwmChannel PWM channel to get.
+ * @param pulseWidthAndPeriod Caller's value to update.
+ * @return Error Code of the read. 0 indicates the value is fresh.
+ */
+ErrorCode CANifier::GetPWMInput(PWMChannel pwmChannel, Timestamped<std::array<double, 2>> & pulseWidthAndPeriod) {
+	std::array<double, 2> param = {};
+	ErrorCode retval = (ErrorCode)c_CANifier_GetPWMInput(m_handle, pwmChannel, param.data());
+	pulseWidthAndPeriod.Update(param, retval, GetMonotonicUs());
+	return retval;
+}
 
 //------ Custom Persistent Params ----------//
 
@@ -318,7 +400,11 @@ ErrorCode CANifier::GetPWMInput(PWMChannel pwmChannel, double pulseWidthAndPerio
  */
 ErrorCode CANifier::ConfigSetCustomParam(int newValue,
 		int paramIndex, int timeoutMs) {
-	return c_CANifier_ConfigSetCustomParam(m_handle, newValue, paramIndex, timeoutMs);
+	if (Shadow().IsCurrent(eCustomParam, paramIndex, newValue))
+		return OK;
+	DeviceStats::Call call(_stats, __func__, DeviceStats::Call_ConfigSet, timeoutMs);
+	return _configShadow.RecordWrite(call.Done(c_CANifier_ConfigSetCustomParam(m_handle, newValue, paramIndex, timeoutMs)),
+			eCustomParam, paramIndex, newValue, timeoutMs);
 }
 /**
  * Gets the value of a custom parameter. This is for arbitrary use.
@@ -337,8 +423,13 @@ ErrorCode CANifier::ConfigSetCustomParam(int newValue,
  */
 int CANifier::ConfigGetCustomParam(
 		int paramIndex, int timeoutMs) {
-	int readValue;
-	c_CANifier_ConfigGetCustomParam(m_handle, &readValue, paramIndex, timeoutMs);
+	double shadowed = 0;
+	if (Shadow().Get(eCustomParam, paramIndex, shadowed))
+		return (int) shadowed;
+	int readValue = 0;
+	DeviceStats::Call call(_stats, __func__, DeviceStats::Call_ConfigGet, timeoutMs);
+	ErrorCode retval = call.Done(c_CANifier_ConfigGetCustomParam(m_handle, &readValue, paramIndex, timeoutMs));
+	_configShadow.RecordRead(retval, eCustomParam, paramIndex, readValue);
 	return readValue;
 }
 
@@ -366,8 +457,15 @@ int CANifier::ConfigGetCustomParam(
  */
 ErrorCode CANifier::ConfigSetParameter(ParamEnum param, double value,
 		uint8_t subValue, int ordinal, int timeoutMs) {
-	return c_CANifier_ConfigSetParameter(m_handle, param, value, subValue, ordinal, timeoutMs);
-
+	/* sub value is not shadowed, so only plain writes can be skipped */
+	if (subValue == 0 && Shadow().IsCurrent(param, ordinal, value))
+		return OK;
+	DeviceStats::Call call(_stats, __func__, DeviceStats::Call_ConfigSet, timeoutMs);
+	ErrorCode retval = call.Done(c_CANifier_ConfigSetParameter(m_handle, param, value, subValue, ordinal, timeoutMs));
+	if (subValue == 0)
+		return _configShadow.RecordWrite(retval, param, ordinal, value, timeoutMs);
+	_configShadow.Invalidate(param, ordinal);
+	return retval;
 }
 /**
  * Gets a parameter. Generally this is not used.
@@ -388,7 +486,11 @@ ErrorCode CANifier::ConfigSetParameter(ParamEnum param, double value,
  */
 double CANifier::ConfigGetParameter(ParamEnum param, int ordinal, int timeoutMs) {
 	double value = 0;
-	c_CANifier_ConfigGetParameter(m_handle, param, &value, ordinal, timeoutMs);
+	if (Shadow().Get(param, ordinal, value))
+		return value;
+	DeviceStats::Call call(_stats, __func__, DeviceStats::Call_ConfigGet, timeoutMs);
+	ErrorCode retval = call.Done(c_CANifier_ConfigGetParameter(m_handle, param, &value, ordinal, timeoutMs));
+	_configShadow.RecordRead(retval, param, ordinal, value);
 	return value;
 }
 
@@ -420,7 +522,8 @@ double CANifier::ConfigGetParameter(ParamEnum param, int ordinal, int timeoutMs)
 ErrorCode CANifier::ConfigGetParameter(ParamEnum param, int32_t valueToSend,
             int32_t & valueReceived, uint8_t & subValue, int32_t ordinal,
             int32_t timeoutMs) {
-	return c_CANifier_ConfigGetParameter_6(m_handle, param, valueToSend, &valueReceived, &subValue, ordinal, timeoutMs);
+	DeviceStats::Call call(_stats, __func__, DeviceStats::Call_ConfigGet, timeoutMs);
+	return call.Done(c_CANifier_ConfigGetParameter_6(m_handle, param, valueToSend, &valueReceived, &subValue, ordinal, timeoutMs));
 }
 
 //------ Frames ----------//
@@ -439,8 +542,8 @@ ErrorCode CANifier::ConfigGetParameter(ParamEnum param, int32_t valueToSend,
  */
 ErrorCode CANifier::SetStatusFramePeriod(CANifierStatusFrame statusFrame, uint8_t periodMs,
 		int timeoutMs) {
-	return c_CANifier_SetStatusFramePeriod(m_handle, statusFrame, periodMs,
-			timeoutMs);
+	return _stats.Record(c_CANifier_SetStatusFramePeriod(m_handle, statusFrame, periodMs,
+			timeoutMs), __func__, DeviceStats::Call_General, timeoutMs);
 }
 /**
  * Gets the period of the given status frame.
@@ -470,7 +573,7 @@ int CANifier::GetStatusFramePeriod(CANifierStatusFrame frame,
  */
 ErrorCode CANifier::SetControlFramePeriod(CANifierControlFrame frame,
 		int periodMs) {
-	return c_CANifier_SetControlFramePeriod(m_handle, frame, periodMs);
+	return _stats.Record(c_CANifier_SetControlFramePeriod(m_handle, frame, periodMs), __func__);
 }
 //------ Firmware ----------//
 /**
@@ -489,9 +592,53 @@ int CANifier::GetFirmwareVersion() {
  * @return Has a Device Reset Occurred?
  */
 bool CANifier::HasResetOccurred() {
-	bool retval = false;
-	c_CANifier_HasResetOccurred(m_handle, &retval);
-	return retval;
+	_configShadow.PollReset(m_handle, &PollResetForShadow);
+	/* include any reset consumed by the config shadow */
+	return _configShadow.TakeReset();
+}
+/**
+ * @return config shadow, invalidated first if the device has reset.
+ */
+ConfigShadow & CANifier::Shadow() {
+	return _configShadow.Checked(m_handle, &PollResetForShadow);
+}
+/**
+ * Enables the client-side config shadow, see ConfigShadow.
+ *
+ * @param enable
+ *            true to enable the shadow, false to disable and clear it.
+ * @param maxAgeMs
+ *            Entries older than this are read from the device again.
+ *            Zero to keep entries until the device resets.
+ */
+void CANifier::EnableConfigShadow(bool enable, int maxAgeMs) {
+	_configShadow.Enable(enable, maxAgeMs);
+}
+/**
+ * Clears the config shadow so the next config reads go to the device.
+ */
+void CANifier::InvalidateConfigShadow() {
+	_configShadow.Invalidate();
+}
+/**
+ * @return Checksum over the config shadow. Compare against a previously
+ *         saved checksum to detect that the shadowed configuration changed.
+ */
+uint32_t CANifier::GetConfigShadowChecksum() {
+	return Shadow().GetChecksum();
+}
+/**
+ * Reads back every shadowed parameter in a single batch and drops any entry
+ * that no longer matches the device, so the next write of it goes through.
+ *
+ * @param mismatches
+ *            Filled with the number of shadowed parameters that did not match.
+ * @param timeoutMs
+ *            Timeout value in ms for the entire readback.
+ * @return Error Code generated by function. 0 indicates every parameter was read.
+ */
+ErrorCode CANifier::VerifyConfigShadow(int & mismatches, int timeoutMs) {
+	return Shadow().Verify(m_handle, &GetParamForReadback, timeoutMs, mismatches);
 }
 //------ Faults ----------//
 /**
@@ -503,7 +650,7 @@ bool CANifier::HasResetOccurred() {
  */
 ErrorCode CANifier::GetFaults(CANifierFaults & toFill) {
 	int faultBits;
-	ErrorCode retval = c_CANifier_GetFaults(m_handle, &faultBits);
+	ErrorCode retval = _stats.Record(c_CANifier_GetFaults(m_handle, &faultBits), __func__);
 	toFill = CANifierFaults(faultBits);
 	return retval;
 }
@@ -516,7 +663,7 @@ ErrorCode CANifier::GetFaults(CANifierFaults & toFill) {
  */
 ErrorCode CANifier::GetStickyFaults(CANifierStickyFaults & toFill) {
 	int faultBits;
-	ErrorCode retval = c_CANifier_GetFaults(m_handle, &faultBits);
+	ErrorCode retval = _stats.Record(c_CANifier_GetFaults(m_handle, &faultBits), __func__);
 	toFill = CANifierStickyFaults(faultBits);
 	return retval;
 }
@@ -526,7 +673,8 @@ ErrorCode CANifier::GetStickyFaults(CANifierStickyFaults & toFill) {
  * @return Error Code generated by function. 0 indicates no error.
  */
 ErrorCode CANifier::ClearStickyFaults(int timeoutMs) {
-	return c_CANifier_ClearStickyFaults(m_handle, timeoutMs);
+	return _stats.Record(c_CANifier_ClearStickyFaults(m_handle, timeoutMs), __func__,
+			DeviceStats::Call_General, timeoutMs);
 }
 
 /**
@@ -577,6 +725,36 @@ void CANifier::GetAllConfigs(CANifierConfiguration &allConfigs, int timeoutMs) {
 
 }
 
+/**
+ * Gets all persistant settings using a single batched readback.
+ * All parameter requests are sent immediately, and the returned readback
+ * collects the responses in any order.  The entire readback is bounded by
+ * timeoutMs rather than one timeout per parameter.
+ *
+ * @param allConfigs        Object to fill with all of the persistant settings.
+ *                          Must outlive the returned readback.
+ * @param timeoutMs
+ *              Timeout value in ms for the entire readback.
+ *              If zero, no blocking is performed.
+ *
+ * @return Readback to Poll() or Wait() on.
+ */
+ConfigReadback CANifier::GetAllConfigsAsync(CANifierConfiguration &allConfigs, int timeoutMs) {
+
+	ConfigReadback readback(m_handle, &GetParamForReadback, timeoutMs);
+
+	readback.Add(eSampleVelocityPeriod, 0, allConfigs.velocityMeasurementPeriod);
+	readback.Add(eSampleVelocityWindow, 0, allConfigs.velocityMeasurementWindow);
+	readback.Add(eClearPositionOnLimitF, 0, allConfigs.clearPositionOnLimitF);
+	readback.Add(eClearPositionOnLimitR, 0, allConfigs.clearPositionOnLimitR);
+	readback.Add(eClearPositionOnQuadIdx, 0, allConfigs.clearPositionOnQuadIdx);
+	readback.Add(eCustomParam, 0, allConfigs.customParam0);
+	readback.Add(eCustomParam, 1, allConfigs.customParam1);
+
+	readback.Send();
+	return readback;
+}
+
 /**
  * Configures all peristant settings to defaults.
  *
@@ -588,7 +766,9 @@ void CANifier::GetAllConfigs(CANifierConfiguration &allConfigs, int timeoutMs) {
  * @return Error Code generated by function. 0 indicates no error. 
  */
 ErrorCode CANifier::ConfigFactoryDefault(int timeoutMs) {
-    return c_CANifier_ConfigFactoryDefault(m_handle, timeoutMs);	
+	_configShadow.Invalidate();
+	DeviceStats::Call call(_stats, __func__, DeviceStats::Call_ConfigSet, timeoutMs);
+	return call.Done(c_CANifier_ConfigFactoryDefault(m_handle, timeoutMs));
 }
 
 } // phoenix
@@ -1,40 +1,534 @@
 #include "ctre/phoenix/CTRLogger.h"
+#include "ctre/phoenix/SpscQueue.h"
+#include "ctre/phoenix/Timestamped.h"
 #include "ctre/phoenix/cci/Logger_CCI.h" // c_Logger_*
 #include "ctre/phoenix/platform/Platform.h"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <stdio.h>
+#include <thread>
+#include <vector>
 
 namespace ctre {
 namespace phoenix {
 
+/*
+ * Logged errors are deduplicated by (code, dev, func) in a fixed lock-free
+ * table.  The first occurrence of an event captures the caller's stack trace,
+ * every later occurrence only bumps a counter.  A background thread reports
+ * each event, then reports repeats at most once per report interval with
+ * their count.  Events that do not fit in the table are reported directly,
+ * at most one per report interval, and the rest are only counted.
+ *
+ * When a sink is open every call is also recorded as a fixed-size record
+ * (timestamp, code, device name ID, function name ID) in a ring owned by the
+ * calling thread.  The same thread drains the rings and writes the records
+ * to the sink, as text or in the binary format described in CTRLogger.h.
+ */
+namespace {
+
+const int kEventCount = 256; /* power of two */
+const int kMaxProbes = 16;
+const int kNameLength = 64;
+const int kReporterPeriodMs = 50;
+
+struct Event {
+	/* hash of (code, dev, func), 0 while the slot is free */
+	std::atomic<uint64_t> key;
+	/* set once the fields below are filled in */
+	std::atomic<bool> ready;
+	ErrorCode code;
+	char dev[kNameLength];
+	char func[kNameLength];
+	std::string stackTrace;
+	uint16_t devId;
+	uint16_t funcId;
+	std::atomic<uint32_t> count;
+	/* reporter thread only */
+	uint32_t reported;
+	std::chrono::steady_clock::time_point lastReport;
+};
+
+Event _events[kEventCount];
+std::atomic<uint32_t> _droppedEvents(0);
+/* steady clock time of the last event reported without a slot */
+std::atomic<int64_t> _lastUnslottedReportMs(INT64_MIN / 2);
+std::atomic<int> _reportIntervalMs(1000);
+
+const int kNameCount = 512;
+const int kRingCount = 16;
+const int kRingCapacity = 512;
+const char kBinaryMagic[8] = { 'C', 'T', 'R', 'L', 'O', 'G', '0', '1' };
+const uint8_t kTagName = 'N';
+const uint8_t kTagRecord = 'R';
+const uint8_t kTagOverflow = 'O';
+
+struct LogRecord {
+	int64_t timestampUs;
+	int32_t code;
+	uint16_t devId;
+	uint16_t funcId;
+};
+
+/* interned device and function names, ID is index + 1 */
+struct Name {
+	std::atomic<uint64_t> key;
+	std::atomic<bool> ready;
+	char text[kNameLength];
+	/* drainer only, name entry written to the binary sink */
+	bool written;
+};
+
+/* per-thread record ring, claimed by one producer thread at a time */
+struct Ring {
+	Ring() : claimed(false), used(false), queue(kRingCapacity), overflow(0) {
+	}
+	std::atomic<bool> claimed;
+	/* set once a thread has claimed the ring, never cleared */
+	std::atomic<bool> used;
+	SpscQueue<LogRecord> queue;
+	std::atomic<uint32_t> overflow;
+};
+
+/* releases the thread's ring when the thread exits */
+struct RingLease {
+	Ring * ring = nullptr;
+	~RingLease() {
+		if (ring != nullptr)
+			ring->claimed.store(false, std::memory_order_release);
+	}
+};
+
+Name _names[kNameCount];
+Ring _rings[kRingCount];
+thread_local RingLease _ringLease;
+/* records of threads without a ring */
+std::atomic<uint32_t> _unringedOverflow(0);
+std::atomic<uint32_t> _totalOverflow(0);
+
+std::mutex _sinkLck;
+FILE * _sink = nullptr;
+bool _sinkBinary = false;
+std::atomic<bool> _sinkOpen(false);
+
+std::mutex _reporterLck;
+std::thread _reporter;
+std::atomic<bool> _reporterRunning(false);
+
+uint64_t Hash(uint64_t hash, const char * str) {
+	/* FNV-1a */
+	for (; *str; ++str) {
+		hash ^= (unsigned char)*str;
+		hash *= 0x100000001b3ULL;
+	}
+	return hash;
+}
+void CopyName(char (&dest)[kNameLength], const char * src) {
+	strncpy(dest, src, kNameLength - 1);
+	dest[kNameLength - 1] = '\0';
+}
+uint16_t InternName(const char * text) {
+	uint64_t key = Hash(0xcbf29ce484222325ULL, text);
+	if (key == 0)
+		key = 1;
+	for (int i = 0; i < kMaxProbes; ++i) {
+		int idx = (int)((key + i) & (kNameCount - 1));
+		Name & name = _names[idx];
+		uint64_t existing = name.key.load(std::memory_order_acquire);
+		if (existing == 0) {
+			if (name.key.compare_exchange_strong(existing, key, std::memory_order_acq_rel)) {
+				CopyName(name.text, text);
+				name.ready.store(true, std::memory_order_release);
+				return (uint16_t)(idx + 1);
+			}
+		}
+		if (existing == key)
+			return (uint16_t)(idx + 1);
+	}
+	/* table full, recorded as unknown */
+	return 0;
+}
+Ring * AcquireRing() {
+	if (_ringLease.ring != nullptr)
+		return _ringLease.ring;
+	for (Ring & ring : _rings) {
+		if (ring.claimed.load(std::memory_order_relaxed))
+			continue;
+		bool claimed = false;
+		if (ring.claimed.compare_exchange_strong(claimed, true, std::memory_order_acquire)) {
+			ring.used.store(true, std::memory_order_relaxed);
+			_ringLease.ring = &ring;
+			return &ring;
+		}
+	}
+	return nullptr;
+}
+void Record(ErrorCode code, uint16_t devId, uint16_t funcId) {
+	Ring * ring = AcquireRing();
+	if (ring == nullptr) {
+		_unringedOverflow.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+	LogRecord record;
+	record.timestampUs = GetMonotonicUs();
+	record.code = (int32_t)code;
+	record.devId = devId;
+	record.funcId = funcId;
+	if (!ring->queue.TryPush(record))
+		ring->overflow.fetch_add(1, std::memory_order_relaxed);
+}
+
+/* binary entries are little endian regardless of host */
+void PutLE(uint8_t *& pos, uint64_t value, int bytes) {
+	for (int i = 0; i < bytes; ++i) {
+		*pos++ = (uint8_t)value;
+		value >>= 8;
+	}
+}
+uint64_t GetLE(const uint8_t * pos, int bytes) {
+	uint64_t value = 0;
+	for (int i = bytes - 1; i >= 0; --i)
+		value = (value << 8) | pos[i];
+	return value;
+}
+const char * NameText(const char * text) {
+	return (text[0] == '\0') ? "?" : text;
+}
+/* a name is interned before its ID is used, but may still be being copied by a racing thread */
+bool NameReady(uint16_t id) {
+	return id != 0 && _names[id - 1].ready.load(std::memory_order_acquire);
+}
+void WriteRecordText(FILE * out, int64_t timestampUs, int32_t code, const char * dev, const char * func) {
+	fprintf(out, "%lld.%06lld\t%d\t%s\t%s\n", (long long)(timestampUs / 1000000),
+			(long long)(timestampUs % 1000000), (int)code, dev, func);
+}
+void WriteOverflowText(FILE * out, int64_t timestampUs, uint32_t count) {
+	fprintf(out, "%lld.%06lld\toverflow\t%u records dropped\n", (long long)(timestampUs / 1000000),
+			(long long)(timestampUs % 1000000), (unsigned)count);
+}
+void WriteNameBinary(FILE * out, uint16_t id) {
+	Name & name = _names[id - 1];
+	uint8_t entry[4 + kNameLength];
+	uint8_t * pos = entry;
+	size_t length = strlen(name.text);
+	PutLE(pos, kTagName, 1);
+	PutLE(pos, id, 2);
+	PutLE(pos, length, 1);
+	memcpy(pos, name.text, length);
+	fwrite(entry, 1, 4 + length, out);
+	name.written = true;
+}
+void WriteRecord(const LogRecord & record) {
+	if (!_sinkBinary) {
+		const char * dev = NameReady(record.devId) ? _names[record.devId - 1].text : "";
+		const char * func = NameReady(record.funcId) ? _names[record.funcId - 1].text : "";
+		WriteRecordText(_sink, record.timestampUs, record.code, NameText(dev), NameText(func));
+		return;
+	}
+	if (NameReady(record.devId) && !_names[record.devId - 1].written)
+		WriteNameBinary(_sink, record.devId);
+	if (NameReady(record.funcId) && !_names[record.funcId - 1].written)
+		WriteNameBinary(_sink, record.funcId);
+	uint8_t entry[17];
+	uint8_t * pos = entry;
+	PutLE(pos, kTagRecord, 1);
+	PutLE(pos, (uint64_t)record.timestampUs, 8);
+	PutLE(pos, (uint32_t)record.code, 4);
+	PutLE(pos, record.devId, 2);
+	PutLE(pos, record.funcId, 2);
+	fwrite(entry, 1, sizeof(entry), _sink);
+}
+void WriteOverflow(uint32_t count) {
+	int64_t now = GetMonotonicUs();
+	if (!_sinkBinary) {
+		WriteOverflowText(_sink, now, count);
+		return;
+	}
+	uint8_t entry[13];
+	uint8_t * pos = entry;
+	PutLE(pos, kTagOverflow, 1);
+	PutLE(pos, (uint64_t)now, 8);
+	PutLE(pos, count, 4);
+	fwrite(entry, 1, sizeof(entry), _sink);
+}
+void DrainRings() {
+	std::lock_guard<std::mutex> lock(_sinkLck);
+	uint32_t overflow = _unringedOverflow.exchange(0, std::memory_order_relaxed);
+	LogRecord record;
+	for (Ring & ring : _rings) {
+		if (!ring.used.load(std::memory_order_relaxed))
+			continue;
+		overflow += ring.overflow.exchange(0, std::memory_order_relaxed);
+		while (ring.queue.TryPop(record)) {
+			if (_sink != nullptr)
+				WriteRecord(record);
+		}
+	}
+	if (overflow == 0)
+		return;
+	_totalOverflow.fetch_add(overflow, std::memory_order_relaxed);
+	if (_sink != nullptr)
+		WriteOverflow(overflow);
+}
+void CloseSinkFile() {
+	if (_sink == nullptr)
+		return;
+	if (_sink == stderr)
+		fflush(_sink);
+	else
+		fclose(_sink);
+	_sink = nullptr;
+}
+void Report(Event & event, uint32_t count) {
+	std::string stackTrace;
+	uint32_t repeats = count - event.reported;
+	if (event.reported > 0) {
+		char line[64];
+		snprintf(line, sizeof(line), "Repeated %u times\n", (unsigned)repeats);
+		stackTrace += line;
+	}
+	stackTrace += event.stackTrace;
+	c_Logger_Log(event.code, event.dev, event.func, 3, stackTrace.c_str());
+}
+void ReportPending(bool flush) {
+	std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+	std::chrono::milliseconds interval(_reportIntervalMs.load(std::memory_order_relaxed));
+	for (Event & event : _events) {
+		if (!event.ready.load(std::memory_order_acquire))
+			continue;
+		uint32_t count = event.count.load(std::memory_order_relaxed);
+		if (count == event.reported)
+			continue;
+		/* first occurrence right away, repeats rate limited */
+		if (event.reported > 0 && !flush && now - event.lastReport < interval)
+			continue;
+		Report(event, count);
+		event.reported = count;
+		event.lastReport = now;
+	}
+}
+void RunReporter() {
+	while (_reporterRunning) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(kReporterPeriodMs));
+		DrainRings();
+		ReportPending(false);
+	}
+	DrainRings();
+	ReportPending(true);
+}
+void StartReporter() {
+	std::lock_guard<std::mutex> lock(_reporterLck);
+	if (_reporterRunning)
+		return;
+	if (_reporter.joinable())
+		_reporter.join();
+	_reporterRunning = true;
+	_reporter = std::thread(RunReporter);
+}
+
+/* stops the reporter before its thread object is destroyed at exit */
+struct ReporterGuard {
+	~ReporterGuard() {
+		CTRLogger::Close();
+	}
+} _reporterGuard;
+
+} // namespace
+
 void CTRLogger::Open(int language) {
 	language++;
     //c_Logger_Open(language, true);
 }
 
-static void GetStackTrace(std::string & stackTrace)
-{
-	stackTrace = ctre::phoenix::platform::GetStackTrace(1);
-}
-/* original implem before multi-platform support */
-//#include <execinfo.h>
-//void GetStackTrace(std::string & stackTrace)
-//{
-//	void *buf[100];
-//	char **strings;
-//	int size = backtrace(buf, 100);
-//	strings = backtrace_symbols(buf, size);
-//	for (int i = 1; i < size; i++) {
-//		stackTrace += strings[i];
-//		stackTrace += "\n";
-//	}
-//}
-
 ErrorCode CTRLogger::Log(ErrorCode code, const char * dev, const char * func) {
-	std::string stackTrace;
-	GetStackTrace(stackTrace);
-	return c_Logger_Log(code, dev, func, 3, stackTrace.c_str());
+	if (code == OK)
+		return OK;
+	if (dev == nullptr)
+		dev = "";
+	if (func == nullptr)
+		func = "";
+
+	uint64_t key = Hash(Hash(0xcbf29ce484222325ULL ^ (uint32_t)code, dev), func);
+	if (key == 0)
+		key = 1;
+
+	for (int i = 0; i < kMaxProbes; ++i) {
+		Event & event = _events[(key + i) & (kEventCount - 1)];
+		uint64_t existing = event.key.load(std::memory_order_acquire);
+		if (existing == 0) {
+			/* claim the free slot, unless another thread just did */
+			if (event.key.compare_exchange_strong(existing, key, std::memory_order_acq_rel)) {
+				event.code = code;
+				CopyName(event.dev, dev);
+				CopyName(event.func, func);
+				event.stackTrace = platform::GetStackTrace(1);
+				event.devId = InternName(dev);
+				event.funcId = InternName(func);
+				event.count.fetch_add(1, std::memory_order_relaxed);
+				event.ready.store(true, std::memory_order_release);
+				if (_sinkOpen.load(std::memory_order_relaxed))
+					Record(code, event.devId, event.funcId);
+				StartReporter();
+				return code;
+			}
+		}
+		if (existing == key) {
+			event.count.fetch_add(1, std::memory_order_relaxed);
+			if (_sinkOpen.load(std::memory_order_relaxed)) {
+				/* names are cached in the event once it is filled in */
+				if (event.ready.load(std::memory_order_acquire))
+					Record(code, event.devId, event.funcId);
+				else
+					Record(code, InternName(dev), InternName(func));
+			}
+			return code;
+		}
+	}
+	/* table full, report directly at most once per report interval and count the rest */
+	int64_t nowMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count();
+	int64_t lastMs = _lastUnslottedReportMs.load(std::memory_order_relaxed);
+	if (nowMs - lastMs >= _reportIntervalMs.load(std::memory_order_relaxed) &&
+			_lastUnslottedReportMs.compare_exchange_strong(lastMs, nowMs, std::memory_order_relaxed)) {
+		std::string stackTrace = platform::GetStackTrace(1);
+		c_Logger_Log(code, dev, func, 3, stackTrace.c_str());
+	} else {
+		_droppedEvents.fetch_add(1, std::memory_order_relaxed);
+	}
+	if (_sinkOpen.load(std::memory_order_relaxed))
+		Record(code, InternName(dev), InternName(func));
+	return code;
+}
+void CTRLogger::SetReportInterval(int intervalMs) {
+	_reportIntervalMs = (intervalMs < 0) ? 0 : intervalMs;
+}
+uint32_t CTRLogger::GetDroppedCount() {
+	return _droppedEvents;
+}
+ErrorCode CTRLogger::LogToFile(const char * path, bool binary) {
+	if (path == nullptr)
+		return InvalidParamValue;
+	FILE * file = fopen(path, binary ? "wb" : "w");
+	if (file == nullptr)
+		return GeneralError;
+	if (binary) {
+		uint8_t header[24];
+		uint8_t * pos = header;
+		memcpy(pos, kBinaryMagic, sizeof(kBinaryMagic));
+		pos += sizeof(kBinaryMagic);
+		int64_t wallUs = std::chrono::duration_cast<std::chrono::microseconds>(
+				std::chrono::system_clock::now().time_since_epoch()).count();
+		PutLE(pos, (uint64_t)wallUs, 8);
+		PutLE(pos, (uint64_t)GetMonotonicUs(), 8);
+		fwrite(header, 1, sizeof(header), file);
+	}
+	{
+		std::lock_guard<std::mutex> lock(_sinkLck);
+		CloseSinkFile();
+		_sink = file;
+		_sinkBinary = binary;
+		/* a new binary file needs its own name entries */
+		for (Name & name : _names)
+			name.written = false;
+	}
+	_sinkOpen = true;
+	StartReporter();
+	return OK;
+}
+void CTRLogger::LogToStderr() {
+	{
+		std::lock_guard<std::mutex> lock(_sinkLck);
+		CloseSinkFile();
+		_sink = stderr;
+		_sinkBinary = false;
+	}
+	_sinkOpen = true;
+	StartReporter();
+}
+uint32_t CTRLogger::GetOverflowCount() {
+	return _totalOverflow;
+}
+ErrorCode CTRLogger::DecodeFile(const char * binaryPath, const char * textPath) {
+	if (binaryPath == nullptr)
+		return InvalidParamValue;
+	FILE * in = fopen(binaryPath, "rb");
+	if (in == nullptr)
+		return GeneralError;
+	FILE * out = (textPath == nullptr) ? stdout : fopen(textPath, "w");
+	if (out == nullptr) {
+		fclose(in);
+		return GeneralError;
+	}
+	ErrorCode retval = OK;
+	uint8_t header[24];
+	if (fread(header, 1, sizeof(header), in) != sizeof(header)
+			|| memcmp(header, kBinaryMagic, sizeof(kBinaryMagic)) != 0) {
+		retval = InvalidParamValue;
+	} else {
+		fprintf(out, "# wall clock %lld us at monotonic %lld us\n", (long long)(int64_t)GetLE(header + 8, 8),
+				(long long)(int64_t)GetLE(header + 16, 8));
+		std::vector<std::string> names(kNameCount);
+		uint8_t entry[16 + kNameLength];
+		int tag;
+		while (retval == OK && (tag = fgetc(in)) != EOF) {
+			if (tag == kTagName) {
+				if (fread(entry, 1, 3, in) != 3) {
+					retval = GeneralError;
+					break;
+				}
+				uint16_t id = (uint16_t)GetLE(entry, 2);
+				size_t length = entry[2];
+				if (id == 0 || id > kNameCount || length >= kNameLength
+						|| fread(entry, 1, length, in) != length) {
+					retval = GeneralError;
+					break;
+				}
+				names[id - 1].assign((const char *)entry, length);
+			} else if (tag == kTagRecord) {
+				if (fread(entry, 1, 16, in) != 16) {
+					retval = GeneralError;
+					break;
+				}
+				uint16_t devId = (uint16_t)GetLE(entry + 12, 2);
+				uint16_t funcId = (uint16_t)GetLE(entry + 14, 2);
+				if (devId > kNameCount || funcId > kNameCount) {
+					retval = GeneralError;
+					break;
+				}
+				WriteRecordText(out, (int64_t)GetLE(entry, 8), (int32_t)GetLE(entry + 8, 4),
+						NameText(devId ? names[devId - 1].c_str() : ""),
+						NameText(funcId ? names[funcId - 1].c_str() : ""));
+			} else if (tag == kTagOverflow) {
+				if (fread(entry, 1, 12, in) != 12) {
+					retval = GeneralError;
+					break;
+				}
+				WriteOverflowText(out, (int64_t)GetLE(entry, 8), (uint32_t)GetLE(entry + 8, 4));
+			} else {
+				retval = GeneralError;
+			}
+		}
+	}
+	fclose(in);
+	if (out != stdout)
+		fclose(out);
+	return retval;
 }
 void CTRLogger::Close() {
 	//c_Logger_Close();
+	/* report and write anything outstanding before the reporter exits */
+	{
+		std::lock_guard<std::mutex> lock(_reporterLck);
+		_reporterRunning = false;
+		if (_reporter.joinable())
+			_reporter.join();
+	}
+	_sinkOpen = false;
+	std::lock_guard<std::mutex> lock(_sinkLck);
+	CloseSinkFile();
 }
 //void CTRLogger::Description(ErrorCode code, const char *&shrt, const char *&lng) {
 //	c_Logger_Description(code, shrt, lng);
@@ -0,0 +1,134 @@
+#include "ctre/phoenix/ConfigEngine.h"
+#include "ctre/phoenix/Stopwatch.h"
+#include <atomic>
+#include <thread>
+
+using namespace ctre::phoenix::motorcontrol::can;
+using namespace ctre::phoenix::sensors;
+
+namespace ctre {
+namespace phoenix {
+
+/* 1Mbps bus */
+static const double kBusBitsPerSecond = 1000000.0;
+/* 29-bit ID, 8 data bytes, worst case bit stuffing */
+static const double kBitsPerFrame = 160.0;
+/* one request frame and one response frame per config */
+static const double kFramesPerConfig = 2.0;
+/* a device turns a config around no faster than this */
+static const double kNominalRoundTripMs = 2.0;
+
+ConfigEngine::ConfigEngine() :
+		_busCeiling(0.5), _maxInFlight(0), _reconcile(false) {
+}
+void ConfigEngine::Add(TalonSRX & talon, const TalonSRXConfiguration & allConfigs) {
+	TalonSRX * device = &talon;
+	TalonSRXConfiguration configs = allConfigs;
+	AddJob("TalonSRX", talon.GetDeviceID(), [device, configs](int timeoutMs, bool reconcile) {
+		if (reconcile) {
+			ConfigReconcileReport report;
+			return device->ConfigReconcileAllSettings(configs, report, timeoutMs);
+		}
+		return device->ConfigAllSettings(configs, timeoutMs);
+	});
+}
+void ConfigEngine::Add(VictorSPX & victor, const VictorSPXConfiguration & allConfigs) {
+	VictorSPX * device = &victor;
+	VictorSPXConfiguration configs = allConfigs;
+	AddJob("VictorSPX", victor.GetDeviceID(), [device, configs](int timeoutMs, bool reconcile) {
+		if (reconcile) {
+			ConfigReconcileReport report;
+			return device->ConfigReconcileAllSettings(configs, report, timeoutMs);
+		}
+		return device->ConfigAllSettings(configs, timeoutMs);
+	});
+}
+void ConfigEngine::Add(PigeonIMU & pigeon, const PigeonIMUConfiguration & allConfigs) {
+	PigeonIMU * device = &pigeon;
+	PigeonIMUConfiguration configs = allConfigs;
+	AddJob("PigeonIMU", pigeon.GetDeviceNumber(), [device, configs](int timeoutMs, bool) {
+		return device->ConfigAllSettings(configs, timeoutMs);
+	});
+}
+void ConfigEngine::Add(CANifier & canifier, const CANifierConfiguration & allConfigs) {
+	CANifier * device = &canifier;
+	CANifierConfiguration configs = allConfigs;
+	AddJob("CANifier", canifier.GetDeviceNumber(), [device, configs](int timeoutMs, bool) {
+		return device->ConfigAllSettings(configs, timeoutMs);
+	});
+}
+void ConfigEngine::SetBusUtilizationCeiling(double ceiling) {
+	if (ceiling > 1) ceiling = 1;
+	if (ceiling <= 0) ceiling = 0;
+	_busCeiling = ceiling;
+}
+void ConfigEngine::SetMaxInFlight(int maxInFlight) {
+	_maxInFlight = (maxInFlight > 0) ? maxInFlight : 0;
+}
+void ConfigEngine::SetReconcile(bool reconcile) {
+	_reconcile = reconcile;
+}
+int ConfigEngine::GetInFlightLimit() const {
+	double bitsPerDevice = kBitsPerFrame * kFramesPerConfig * (1000.0 / kNominalRoundTripMs);
+	int limit = (int)(_busCeiling * kBusBitsPerSecond / bitsPerDevice);
+	/* always make progress */
+	if (limit < 1)
+		limit = 1;
+	if (_maxInFlight > 0 && limit > _maxInFlight)
+		limit = _maxInFlight;
+	return limit;
+}
+ErrorCode ConfigEngine::Run(int timeoutMs) {
+	std::atomic<int> next(0);
+	bool reconcile = _reconcile;
+
+	auto worker = [this, &next, timeoutMs, reconcile]() {
+		for (;;) {
+			int idx = next++;
+			if (idx >= (int)_jobs.size())
+				return;
+			Job & job = _jobs[idx];
+			Stopwatch stopwatch;
+			stopwatch.Start();
+			job.result.errors = ErrorCollection();
+			job.result.errors.NewError(job.configure(timeoutMs, reconcile));
+			job.result.durationMs = stopwatch.DurationMs();
+		}
+	};
+
+	int threadCount = GetInFlightLimit();
+	if (threadCount > (int)_jobs.size())
+		threadCount = (int)_jobs.size();
+
+	std::vector<std::thread> threads;
+	for (int i = 0; i < threadCount; ++i)
+		threads.push_back(std::thread(worker));
+	for (std::thread & thread : threads)
+		thread.join();
+
+	ErrorCollection errorCollection;
+	_results.clear();
+	for (const Job & job : _jobs) {
+		_results.push_back(job.result);
+		errorCollection.NewError(job.result.errors._worstError);
+	}
+	return errorCollection._worstError;
+}
+const std::vector<ConfigEngine::Result> & ConfigEngine::GetResults() const {
+	return _results;
+}
+void ConfigEngine::Clear() {
+	_jobs.clear();
+	_results.clear();
+}
+void ConfigEngine::AddJob(const std::string & deviceType, int deviceID, std::function<ErrorCode(int, bool)> configure) {
+	Job job;
+	job.configure = configure;
+	job.result.deviceType = deviceType;
+	job.result.deviceID = deviceID;
+	job.result.durationMs = 0;
+	_jobs.push_back(job);
+}
+
+} // namespace phoenix
+} // namespace ctre
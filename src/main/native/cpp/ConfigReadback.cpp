@@ -0,0 +1,113 @@
+#include "ctre/phoenix/ConfigReadback.h"
+
+namespace ctre {
+namespace phoenix {
+
+ConfigReadback::ConfigReadback(void * handle, ParamGetter getter, int timeoutMs) :
+		_handle(handle), _getter(getter), _timeoutMs(timeoutMs) {
+	if (_timeoutMs < 0)
+		_timeoutMs = 0;
+}
+void ConfigReadback::Send() {
+	_stopwatch.Start();
+	_pending = 0;
+	for (Entry & entry : _entries) {
+		if (entry.received)
+			continue;
+		/* zero timeout transmits the request without waiting on the response,
+		 * so the whole burst goes out back to back */
+		Collect(entry, 0);
+		if (!entry.received)
+			++_pending;
+	}
+	_sent = true;
+}
+bool ConfigReadback::Poll() {
+	if (!_sent)
+		Send();
+	for (Entry & entry : _entries) {
+		if (_pending == 0)
+			break;
+		if (entry.received)
+			continue;
+		/* a non-blocking read transmits the request again, so do not flood the bus */
+		if (_stopwatch.DurationMs() - entry.requestedMs < kRequestIntervalMs)
+			continue;
+		if (Collect(entry, 0))
+			--_pending;
+	}
+	if (IsDone())
+		Expire();
+	return IsDone();
+}
+ErrorCode ConfigReadback::Wait() {
+	Poll();
+	for (Entry & entry : _entries) {
+		if (_pending == 0)
+			break;
+		if (entry.received)
+			continue;
+		/* block on this response only as long as the shared budget allows,
+		 * later responses are usually already in by the time it arrives */
+		int remainingMs = RemainingMs();
+		if (remainingMs > 0 && Collect(entry, remainingMs))
+			--_pending;
+		else if (remainingMs <= 0)
+			break;
+	}
+	Expire();
+	return GetError();
+}
+bool ConfigReadback::IsDone() {
+	if (!_sent)
+		return false;
+	return (_pending == 0) || (RemainingMs() <= 0);
+}
+int ConfigReadback::GetPendingCount() const {
+	if (!_sent)
+		return (int)_entries.size();
+	return _pending;
+}
+int ConfigReadback::GetCount() const {
+	return (int)_entries.size();
+}
+bool ConfigReadback::IsReceived(int index) const {
+	if (index < 0 || index >= (int)_entries.size())
+		return false;
+	return _entries[index].received;
+}
+ErrorCode ConfigReadback::GetError() const {
+	for (const Entry & entry : _entries) {
+		/* outstanding requests are not errors until the readback expires */
+		if (!entry.received && !_expired)
+			continue;
+		if (entry.error != OK)
+			return entry.error;
+	}
+	return OK;
+}
+bool ConfigReadback::Collect(Entry & entry, int timeoutMs) {
+	double value = 0;
+	entry.requestedMs = _stopwatch.DurationMs();
+	entry.error = _getter(_handle, entry.param, entry.ordinal, value, timeoutMs);
+	if (entry.error == OK) {
+		entry.assign(entry.dest, value);
+		entry.received = true;
+	}
+	return entry.received;
+}
+void ConfigReadback::Expire() {
+	/* anything left is out of time */
+	for (Entry & entry : _entries) {
+		if (!entry.received)
+			entry.error = RxTimeout;
+	}
+	_expired = true;
+}
+int ConfigReadback::RemainingMs() {
+	long long int remaining = (long long int)_timeoutMs - _stopwatch.DurationMs();
+	return (remaining > 0) ? (int)remaining : 0;
+}
+
+} // namespace phoenix
+} // namespace ctre
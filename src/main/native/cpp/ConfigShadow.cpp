@@ -0,0 +1,135 @@
+#include "ctre/phoenix/ConfigShadow.h"
+#include "ctre/phoenix/ConfigReconcile.h"
+#include <cstring>
+
+namespace ctre {
+namespace phoenix {
+
+void ConfigShadow::Enable(bool enable, int maxAgeMs) {
+	std::lock_guard<std::mutex> lock(_lck);
+	_enabled = enable;
+	_maxAgeMs = (maxAgeMs > 0) ? maxAgeMs : 0;
+	if (!_enabled)
+		_entries.clear();
+}
+bool ConfigShadow::IsEnabled() const {
+	return _enabled;
+}
+bool ConfigShadow::Get(ParamEnum param, int ordinal, double & value) {
+	std::lock_guard<std::mutex> lock(_lck);
+	if (!_enabled)
+		return false;
+	auto it = _entries.find(Key(param, ordinal));
+	if (it == _entries.end() || !IsFresh(it->second))
+		return false;
+	value = it->second.value;
+	return true;
+}
+bool ConfigShadow::IsCurrent(ParamEnum param, int ordinal, double value) {
+	double shadowed = 0;
+	if (!Get(param, ordinal, shadowed))
+		return false;
+	return shadowed == value;
+}
+ErrorCode ConfigShadow::RecordWrite(ErrorCode error, ParamEnum param, int ordinal, double value, int timeoutMs) {
+	/* a zero timeout write is never acknowledged, so the device state is unknown */
+	if (error == OK && timeoutMs > 0) {
+		RecordRead(error, param, ordinal, value);
+	} else {
+		Invalidate(param, ordinal);
+	}
+	return error;
+}
+void ConfigShadow::RecordRead(ErrorCode error, ParamEnum param, int ordinal, double value) {
+	std::lock_guard<std::mutex> lock(_lck);
+	if (!_enabled || error != OK)
+		return;
+	Entry & entry = _entries[Key(param, ordinal)];
+	entry.value = value;
+	entry.stamp = std::chrono::steady_clock::now();
+}
+void ConfigShadow::Invalidate() {
+	std::lock_guard<std::mutex> lock(_lck);
+	_entries.clear();
+}
+void ConfigShadow::Invalidate(ParamEnum param, int ordinal) {
+	std::lock_guard<std::mutex> lock(_lck);
+	_entries.erase(Key(param, ordinal));
+}
+int ConfigShadow::GetCount() {
+	std::lock_guard<std::mutex> lock(_lck);
+	return (int)_entries.size();
+}
+uint32_t ConfigShadow::GetChecksum() {
+	std::lock_guard<std::mutex> lock(_lck);
+	uint32_t hash = 2166136261u;
+	for (const auto & kv : _entries) {
+		int32_t words[2] = { kv.first.first, kv.first.second };
+		uint8_t bytes[sizeof(words) + sizeof(double)];
+		std::memcpy(bytes, words, sizeof(words));
+		std::memcpy(bytes + sizeof(words), &kv.second.value, sizeof(double));
+		for (uint8_t b : bytes) {
+			hash ^= b;
+			hash *= 16777619u;
+		}
+	}
+	return hash;
+}
+ErrorCode ConfigShadow::Verify(void * handle, ConfigReadback::ParamGetter getter, int timeoutMs, int & mismatches) {
+	std::vector<Key> keys;
+	std::vector<double> expected;
+	{
+		std::lock_guard<std::mutex> lock(_lck);
+		for (const auto & kv : _entries) {
+			keys.push_back(kv.first);
+			expected.push_back(kv.second.value);
+		}
+	}
+	/* sized up front, readback holds pointers into this */
+	std::vector<double> actual(keys.size(), 0);
+
+	ConfigReadback readback(handle, getter, timeoutMs);
+	for (size_t i = 0; i < keys.size(); ++i)
+		readback.Add((ParamEnum)keys[i].first, keys[i].second, actual[i]);
+	readback.Send();
+	ErrorCode error = readback.Wait();
+
+	mismatches = 0;
+	for (size_t i = 0; i < keys.size(); ++i) {
+		/* entries that were not read back are left alone */
+		if (!readback.IsReceived((int)i))
+			continue;
+		if (!ConfigReconcileUtil::IsClose(expected[i], actual[i])) {
+			Invalidate((ParamEnum)keys[i].first, keys[i].second);
+			++mismatches;
+		}
+	}
+	return error;
+}
+void ConfigShadow::PollReset(void * handle, ResetGetter getter) {
+	if (getter(handle)) {
+		Invalidate();
+		_resetLatched = true;
+		++_resetCount;
+	}
+}
+ConfigShadow & ConfigShadow::Checked(void * handle, ResetGetter getter) {
+	if (_enabled)
+		PollReset(handle, getter);
+	return *this;
+}
+bool ConfigShadow::TakeReset() {
+	return _resetLatched.exchange(false);
+}
+uint32_t ConfigShadow::GetResetCount() const {
+	return _resetCount;
+}
+bool ConfigShadow::IsFresh(const Entry & entry) const {
+	if (_maxAgeMs == 0)
+		return true;
+	auto age = std::chrono::steady_clock::now() - entry.stamp;
+	return age < std::chrono::milliseconds(_maxAgeMs);
+}
+
+} // namespace phoenix
+} // namespace ctre
@@ -0,0 +1,238 @@
+#include "ctre/phoenix/DeviceStats.h"
+#include <cstring>
+
+namespace ctre {
+namespace phoenix {
+
+namespace {
+const int64_t kFirstBucketUs = 256;
+
+uint32_t HashName(const char * name) {
+	/* FNV-1a */
+	uint32_t hash = 2166136261u;
+	for (; *name; ++name) {
+		hash ^= (unsigned char)*name;
+		hash *= 16777619u;
+	}
+	return hash;
+}
+}
+
+DeviceStats::DeviceStats() {
+	for (CodeSlot & slot : _codes)
+		slot.code = OK;
+	for (FunctionSlot & slot : _functions)
+		slot.function = nullptr;
+	for (std::atomic<int> & order : _functionOrder)
+		order = -1;
+	_functionCount = 0;
+	Reset();
+}
+ErrorCode DeviceStats::Record(ErrorCode error, const char * function, CallType type, int timeoutMs,
+		int64_t latencyUs) {
+	_calls.fetch_add(1, std::memory_order_relaxed);
+	bool counted = (error == OK);
+	if (!counted) {
+		for (int i = 0; i < kMaxErrorCodes && !counted; ++i) {
+			CodeSlot & slot = _codes[((uint32_t)error + i) & (kMaxErrorCodes - 1)];
+			int32_t existing = slot.code.load(std::memory_order_acquire);
+			if (existing == OK && slot.code.compare_exchange_strong(existing, error, std::memory_order_acq_rel))
+				existing = error;
+			if (existing == error) {
+				slot.count.fetch_add(1, std::memory_order_relaxed);
+				counted = true;
+			}
+		}
+	}
+	FunctionSlot * slot = (function != nullptr) ? FindFunction(function, true) : nullptr;
+	if (slot != nullptr) {
+		slot->calls.fetch_add(1, std::memory_order_relaxed);
+		if (error != OK) {
+			slot->errors.fetch_add(1, std::memory_order_relaxed);
+			slot->lastError.store(error, std::memory_order_relaxed);
+		}
+		if (IsTimeout(error))
+			slot->timeouts.fetch_add(1, std::memory_order_relaxed);
+	}
+	if (!counted || (function != nullptr && slot == nullptr))
+		_dropped.fetch_add(1, std::memory_order_relaxed);
+
+	if (timeoutMs <= 0)
+		_nonBlocking.fetch_add(1, std::memory_order_relaxed);
+	else if (error == OK)
+		_completed.fetch_add(1, std::memory_order_relaxed);
+	else if (IsTimeout(error))
+		_timedOut.fetch_add(1, std::memory_order_relaxed);
+	else
+		_failed.fetch_add(1, std::memory_order_relaxed);
+
+	/* a zero timeout config call returns before the device responds */
+	if (latencyUs >= 0 && timeoutMs > 0) {
+		if (type == Call_ConfigSet)
+			RecordLatency(_configSetLatency, latencyUs);
+		else if (type == Call_ConfigGet)
+			RecordLatency(_configGetLatency, latencyUs);
+	}
+	return error;
+}
+uint32_t DeviceStats::GetCallCount() const {
+	return _calls.load(std::memory_order_relaxed);
+}
+uint32_t DeviceStats::GetErrorCount(ErrorCode code) const {
+	if (code == OK)
+		return 0;
+	for (int i = 0; i < kMaxErrorCodes; ++i) {
+		const CodeSlot & slot = _codes[((uint32_t)code + i) & (kMaxErrorCodes - 1)];
+		int32_t existing = slot.code.load(std::memory_order_acquire);
+		if (existing == OK)
+			return 0;
+		if (existing == code)
+			return slot.count.load(std::memory_order_relaxed);
+	}
+	return 0;
+}
+int DeviceStats::GetErrorCounts(ErrorCode * codes, uint32_t * counts, int capacity) const {
+	int filled = 0;
+	for (const CodeSlot & slot : _codes) {
+		if (filled >= capacity)
+			break;
+		int32_t code = slot.code.load(std::memory_order_acquire);
+		if (code == OK)
+			continue;
+		codes[filled] = (ErrorCode)code;
+		counts[filled] = slot.count.load(std::memory_order_relaxed);
+		++filled;
+	}
+	return filled;
+}
+ErrorCode DeviceStats::GetWorstError() const {
+	ErrorCollection errorCollection;
+	for (const CodeSlot & slot : _codes) {
+		int32_t code = slot.code.load(std::memory_order_acquire);
+		if (code == OK || slot.count.load(std::memory_order_relaxed) == 0)
+			continue;
+		errorCollection.NewError((ErrorCode)code);
+	}
+	return errorCollection._worstError;
+}
+int DeviceStats::GetFunctionCount() const {
+	return _functionCount.load(std::memory_order_acquire);
+}
+bool DeviceStats::GetFunctionStats(int idx, FunctionStats & stats) const {
+	if (idx < 0 || idx >= GetFunctionCount())
+		return false;
+	int slotIdx = _functionOrder[idx].load(std::memory_order_acquire);
+	/* claimed but not yet published */
+	if (slotIdx < 0)
+		return false;
+	const FunctionSlot & slot = _functions[slotIdx];
+	stats.function = slot.function.load(std::memory_order_acquire);
+	stats.calls = slot.calls.load(std::memory_order_relaxed);
+	stats.errors = slot.errors.load(std::memory_order_relaxed);
+	stats.timeouts = slot.timeouts.load(std::memory_order_relaxed);
+	stats.lastError = (ErrorCode)slot.lastError.load(std::memory_order_relaxed);
+	return true;
+}
+bool DeviceStats::GetFunctionStats(const char * function, FunctionStats & stats) const {
+	const FunctionSlot * slot = FindFunction(function);
+	if (slot == nullptr)
+		return false;
+	stats.function = slot->function.load(std::memory_order_acquire);
+	stats.calls = slot->calls.load(std::memory_order_relaxed);
+	stats.errors = slot->errors.load(std::memory_order_relaxed);
+	stats.timeouts = slot->timeouts.load(std::memory_order_relaxed);
+	stats.lastError = (ErrorCode)slot->lastError.load(std::memory_order_relaxed);
+	return true;
+}
+void DeviceStats::GetTimeoutStats(TimeoutStats & stats) const {
+	stats.nonBlocking = _nonBlocking.load(std::memory_order_relaxed);
+	stats.completed = _completed.load(std::memory_order_relaxed);
+	stats.timedOut = _timedOut.load(std::memory_order_relaxed);
+	stats.failed = _failed.load(std::memory_order_relaxed);
+}
+void DeviceStats::GetLatencyHistogram(CallType type, LatencyHistogram & histogram) const {
+	const Histogram & source = (type == Call_ConfigGet) ? _configGetLatency : _configSetLatency;
+	if (type == Call_General) {
+		memset(&histogram, 0, sizeof(histogram));
+		return;
+	}
+	for (int i = 0; i < kLatencyBuckets; ++i)
+		histogram.counts[i] = source.counts[i].load(std::memory_order_relaxed);
+	histogram.total = source.total.load(std::memory_order_relaxed);
+	histogram.sumUs = source.sumUs.load(std::memory_order_relaxed);
+	histogram.maxUs = source.maxUs.load(std::memory_order_relaxed);
+}
+int64_t DeviceStats::GetBucketUpperUs(int bucket) {
+	if (bucket < 0 || bucket >= kLatencyBuckets - 1)
+		return -1;
+	return kFirstBucketUs << bucket;
+}
+uint32_t DeviceStats::GetDroppedCount() const {
+	return _dropped.load(std::memory_order_relaxed);
+}
+void DeviceStats::Reset() {
+	_calls = 0;
+	_dropped = 0;
+	for (CodeSlot & slot : _codes)
+		slot.count = 0;
+	for (FunctionSlot & slot : _functions) {
+		slot.calls = 0;
+		slot.errors = 0;
+		slot.timeouts = 0;
+		slot.lastError = OK;
+	}
+	_nonBlocking = 0;
+	_completed = 0;
+	_timedOut = 0;
+	_failed = 0;
+	ResetHistogram(_configSetLatency);
+	ResetHistogram(_configGetLatency);
+}
+bool DeviceStats::IsTimeout(ErrorCode error) {
+	return error == RxTimeout || error == TxTimeout || error == SigNotUpdated;
+}
+DeviceStats::FunctionSlot * DeviceStats::FindFunction(const char * function, bool claim) {
+	uint32_t hash = HashName(function);
+	for (int i = 0; i < kMaxFunctions; ++i) {
+		int slotIdx = (int)((hash + i) % kMaxFunctions);
+		FunctionSlot & slot = _functions[slotIdx];
+		const char * existing = slot.function.load(std::memory_order_acquire);
+		if (existing == nullptr) {
+			if (!claim)
+				return nullptr;
+			if (slot.function.compare_exchange_strong(existing, function, std::memory_order_acq_rel)) {
+				_functionOrder[_functionCount.fetch_add(1, std::memory_order_acq_rel)].store(slotIdx,
+						std::memory_order_release);
+				return &slot;
+			}
+		}
+		/* overloads share a name but not a pointer */
+		if (existing == function || strcmp(existing, function) == 0)
+			return &slot;
+	}
+	return nullptr;
+}
+const DeviceStats::FunctionSlot * DeviceStats::FindFunction(const char * function) const {
+	return const_cast<DeviceStats *>(this)->FindFunction(function, false);
+}
+void DeviceStats::ResetHistogram(Histogram & histogram) {
+	for (std::atomic<uint32_t> & count : histogram.counts)
+		count = 0;
+	histogram.total = 0;
+	histogram.sumUs = 0;
+	histogram.maxUs = 0;
+}
+void DeviceStats::RecordLatency(Histogram & histogram, int64_t latencyUs) {
+	int bucket = 0;
+	while (bucket < kLatencyBuckets - 1 && latencyUs >= (kFirstBucketUs << bucket))
+		++bucket;
+	histogram.counts[bucket].fetch_add(1, std::memory_order_relaxed);
+	histogram.total.fetch_add(1, std::memory_order_relaxed);
+	histogram.sumUs.fetch_add(latencyUs, std::memory_order_relaxed);
+	int64_t maxUs = histogram.maxUs.load(std::memory_order_relaxed);
+	while (latencyUs > maxUs && !histogram.maxUs.compare_exchange_weak(maxUs, latencyUs, std::memory_order_relaxed)) {
+	}
+}
+
+} // namespace phoenix
+} // namespace ctre
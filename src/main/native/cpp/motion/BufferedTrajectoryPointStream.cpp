@@ -1,7 +1,49 @@
 #include "ctre/phoenix/motion/BufferedTrajectoryPointStream.h"
+#include <cmath>
 namespace ctre {
 	namespace phoenix {
 		namespace motion {
+			/* packed flag layout */
+			static const uint8_t kFlagIsLastPoint = 0x01;
+			static const uint8_t kFlagZeroPos = 0x02;
+			static const uint8_t kFlagUseAuxPID = 0x04;
+			static const int kSlot0Shift = 3;
+			static const int kSlot1Shift = 5;
+			/* feed-forwards are fractions of [-1,+1] */
+			static const double kFractionFullScale = 32767.0;
+
+			static bool PackCounts(double value, double resolution, int32_t & counts)
+			{
+				double scaled = std::round(value / resolution);
+				if (!(scaled >= INT32_MIN && scaled <= INT32_MAX))
+					return false;
+				counts = (int32_t)scaled;
+				return true;
+			}
+			static bool PackFraction(double value, int16_t & fraction)
+			{
+				if (!(value >= -1 && value <= 1))
+					return false;
+				fraction = (int16_t)std::round(value * kFractionFullScale);
+				return true;
+			}
+			static void GetArraysPoint(const TrajectoryPointArrays & trajPts, uint32_t i, TrajectoryPoint & pt)
+			{
+				pt.position = trajPts.position[i];
+				pt.velocity = trajPts.velocity ? trajPts.velocity[i] : 0;
+				pt.arbFeedFwd = trajPts.arbFeedFwd ? trajPts.arbFeedFwd[i] : 0;
+				pt.headingDeg = 0;
+				pt.auxiliaryPos = trajPts.auxiliaryPos ? trajPts.auxiliaryPos[i] : 0;
+				pt.auxiliaryVel = trajPts.auxiliaryVel ? trajPts.auxiliaryVel[i] : 0;
+				pt.auxiliaryArbFeedFwd = trajPts.auxiliaryArbFeedFwd ? trajPts.auxiliaryArbFeedFwd[i] : 0;
+				pt.profileSlotSelect0 = trajPts.profileSlotSelect0;
+				pt.profileSlotSelect1 = trajPts.profileSlotSelect1;
+				pt.isLastPoint = trajPts.isLastPoint && (i == trajPts.count - 1);
+				pt.zeroPos = trajPts.zeroPos && (i == 0);
+				pt.timeDur = trajPts.timeDurs ? trajPts.timeDurs[i] : trajPts.timeDur;
+				pt.useAuxPID = trajPts.useAuxPID;
+			}
+
 			BufferedTrajectoryPointStream::BufferedTrajectoryPointStream()
 			{
 				_handle = c_BuffTrajPointStream_Create1();
@@ -13,9 +55,17 @@ namespace ctre {
 			}
 			ctre::phoenix::ErrorCode BufferedTrajectoryPointStream::Clear()
 			{
+				ClearStaged();
 				return c_BuffTrajPointStream_Clear(_handle);
 			}
 			ctre::phoenix::ErrorCode BufferedTrajectoryPointStream::Write(const TrajectoryPoint & trajPt)
+			{
+				if (_staging) {
+					return Stage(trajPt);
+				}
+				return WriteToHandle(trajPt);
+			}
+			ctre::phoenix::ErrorCode BufferedTrajectoryPointStream::WriteToHandle(const TrajectoryPoint & trajPt)
 			{
 				return c_BuffTrajPointStream_Write(_handle,
 					trajPt.position,
@@ -44,6 +94,180 @@ namespace ctre {
 
 				return retval;
 			}
+			ctre::phoenix::ErrorCode BufferedTrajectoryPointStream::Write(const TrajectoryPointArrays & trajPts)
+			{
+				if (trajPts.count > 0 && trajPts.position == nullptr)
+					return InvalidParamValue;
+
+				TrajectoryPoint pt;
+				if (!_staging) {
+					ctre::phoenix::ErrorCode retval = OK;
+					for (uint32_t i = 0; i < trajPts.count; ++i) {
+						/* insert next pt */
+						GetArraysPoint(trajPts, i, pt);
+						ctre::phoenix::ErrorCode er = WriteToHandle(pt);
+						/* save first nonzero error code */
+						if (retval == OK) { retval = er; }
+					}
+					return retval;
+				}
+
+				size_t before = GetStagedSize();
+				Reserve(GetStagedCount() + trajPts.count);
+
+				for (uint32_t i = 0; i < trajPts.count; ++i) {
+					GetArraysPoint(trajPts, i, pt);
+					ctre::phoenix::ErrorCode er = Stage(pt);
+					if (er != OK) {
+						/* all or nothing */
+						if (_packedStorage) _packed.resize(before); else _staged.resize(before);
+						return er;
+					}
+				}
+				return OK;
+			}
+			ctre::phoenix::ErrorCode BufferedTrajectoryPointStream::SetStaging(bool enable)
+			{
+				if (GetStagedCount() > 0)
+					return InvalidParamValue;
+
+				ClearStaged();
+				if (!enable) {
+					/* release the staging storage */
+					std::vector<TrajectoryPoint>().swap(_staged);
+					std::vector<PackedTrajectoryPoint>().swap(_packed);
+					_packedStorage = false;
+				}
+				_staging = enable;
+				return OK;
+			}
+			void BufferedTrajectoryPointStream::Reserve(uint32_t trajPtCount)
+			{
+				if (!_staging)
+					return;
+				if (_packedStorage)
+					_packed.reserve(_stagedHead + trajPtCount);
+				else
+					_staged.reserve(_stagedHead + trajPtCount);
+			}
+			ctre::phoenix::ErrorCode BufferedTrajectoryPointStream::Flush()
+			{
+				return Flush(GetStagedCount());
+			}
+			ctre::phoenix::ErrorCode BufferedTrajectoryPointStream::Flush(uint32_t maxTrajPts)
+			{
+				ctre::phoenix::ErrorCode retval = OK;
+
+				size_t end = _stagedHead + maxTrajPts;
+				if (end > GetStagedSize())
+					end = GetStagedSize();
+
+				TrajectoryPoint pt;
+				for (; _stagedHead < end; ++_stagedHead) {
+					/* decode and insert next pt */
+					GetStaged(_stagedHead, pt);
+					ctre::phoenix::ErrorCode er = WriteToHandle(pt);
+					/* save first nonzero error code */
+					if (retval == OK) { retval = er; }
+				}
+				/* all handed over, keep the capacity for the next profile */
+				if (_stagedHead == GetStagedSize()) {
+					ClearStaged();
+				}
+				return retval;
+			}
+			uint32_t BufferedTrajectoryPointStream::GetStagedCount() const
+			{
+				return (uint32_t)(GetStagedSize() - _stagedHead);
+			}
+			ctre::phoenix::ErrorCode BufferedTrajectoryPointStream::GetStagedPoint(uint32_t index, TrajectoryPoint & trajPt) const
+			{
+				if (index >= GetStagedCount())
+					return InvalidParamValue;
+				GetStaged(_stagedHead + index, trajPt);
+				return OK;
+			}
+			ctre::phoenix::ErrorCode BufferedTrajectoryPointStream::SetPackedStorage(bool enable, const TrajectoryPointPacking & packing)
+			{
+				if (GetStagedCount() > 0)
+					return InvalidParamValue;
+				if (enable && (!(packing.positionResolution > 0) || !(packing.velocityResolution > 0)))
+					return InvalidParamValue;
+
+				ClearStaged();
+				/* release the storage of the mode no longer in use */
+				std::vector<TrajectoryPoint>().swap(_staged);
+				std::vector<PackedTrajectoryPoint>().swap(_packed);
+				_packedStorage = enable;
+				_packing = packing;
+				if (enable)
+					_staging = true;
+				return OK;
+			}
+			ctre::phoenix::ErrorCode BufferedTrajectoryPointStream::Stage(const TrajectoryPoint & trajPt)
+			{
+				if (!_packedStorage) {
+					_staged.push_back(trajPt);
+					return OK;
+				}
+
+				PackedTrajectoryPoint packed;
+				bool ok = true;
+				ok &= PackCounts(trajPt.position, _packing.positionResolution, packed.position);
+				ok &= PackCounts(trajPt.velocity, _packing.velocityResolution, packed.velocity);
+				ok &= PackCounts(trajPt.auxiliaryPos, _packing.positionResolution, packed.auxiliaryPos);
+				ok &= PackCounts(trajPt.auxiliaryVel, _packing.velocityResolution, packed.auxiliaryVel);
+				ok &= PackFraction(trajPt.arbFeedFwd, packed.arbFeedFwd);
+				ok &= PackFraction(trajPt.auxiliaryArbFeedFwd, packed.auxiliaryArbFeedFwd);
+				ok &= (trajPt.timeDur <= UINT16_MAX);
+				ok &= (trajPt.profileSlotSelect0 <= 3);
+				ok &= (trajPt.profileSlotSelect1 <= 3);
+				if (!ok)
+					return InvalidParamValue;
+
+				packed.timeDur = (uint16_t)trajPt.timeDur;
+				packed.flags = (uint8_t)(
+					(trajPt.isLastPoint ? kFlagIsLastPoint : 0) |
+					(trajPt.zeroPos ? kFlagZeroPos : 0) |
+					(trajPt.useAuxPID ? kFlagUseAuxPID : 0) |
+					(trajPt.profileSlotSelect0 << kSlot0Shift) |
+					(trajPt.profileSlotSelect1 << kSlot1Shift));
+
+				_packed.push_back(packed);
+				return OK;
+			}
+			void BufferedTrajectoryPointStream::GetStaged(size_t index, TrajectoryPoint & trajPt) const
+			{
+				if (!_packedStorage) {
+					trajPt = _staged[index];
+					return;
+				}
+
+				const PackedTrajectoryPoint & packed = _packed[index];
+				trajPt.position = packed.position * _packing.positionResolution;
+				trajPt.velocity = packed.velocity * _packing.velocityResolution;
+				trajPt.arbFeedFwd = (double)packed.arbFeedFwd / kFractionFullScale;
+				trajPt.headingDeg = 0;
+				trajPt.auxiliaryPos = packed.auxiliaryPos * _packing.positionResolution;
+				trajPt.auxiliaryVel = packed.auxiliaryVel * _packing.velocityResolution;
+				trajPt.auxiliaryArbFeedFwd = (double)packed.auxiliaryArbFeedFwd / kFractionFullScale;
+				trajPt.profileSlotSelect0 = (packed.flags >> kSlot0Shift) & 3;
+				trajPt.profileSlotSelect1 = (packed.flags >> kSlot1Shift) & 3;
+				trajPt.isLastPoint = (packed.flags & kFlagIsLastPoint) != 0;
+				trajPt.zeroPos = (packed.flags & kFlagZeroPos) != 0;
+				trajPt.timeDur = packed.timeDur;
+				trajPt.useAuxPID = (packed.flags & kFlagUseAuxPID) != 0;
+			}
+			size_t BufferedTrajectoryPointStream::GetStagedSize() const
+			{
+				return _packedStorage ? _packed.size() : _staged.size();
+			}
+			void BufferedTrajectoryPointStream::ClearStaged()
+			{
+				_staged.clear();
+				_packed.clear();
+				_stagedHead = 0;
+			}
 		} // namespace motion
 	} // namespace phoenix
 } // namespace ctre
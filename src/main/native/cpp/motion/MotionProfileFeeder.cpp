@@ -0,0 +1,224 @@
+#include "ctre/phoenix/motion/MotionProfileFeeder.h"
+#include "ctre/phoenix/motion/MotionProfileStatus.h"
+#include <chrono>
+#if defined(WIN32) || defined(_WIN32) || defined(_WIN64)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+using namespace ctre::phoenix::motorcontrol;
+
+namespace ctre {
+	namespace phoenix {
+		namespace motion {
+			MotionProfileFeeder::MotionProfileFeeder() :
+				_running(false)
+			{
+			}
+			MotionProfileFeeder::~MotionProfileFeeder()
+			{
+				Stop();
+			}
+			void MotionProfileFeeder::Add(IMotorController & motor)
+			{
+				AddEntry(motor, nullptr);
+			}
+			void MotionProfileFeeder::Add(IMotorController & motor, BufferedTrajectoryPointStream & stream)
+			{
+				AddEntry(motor, &stream);
+			}
+			void MotionProfileFeeder::AddEntry(IMotorController & motor, BufferedTrajectoryPointStream * stream)
+			{
+				std::lock_guard<std::mutex> serviceLock(_serviceLck);
+				std::lock_guard<std::mutex> lock(_lck);
+				for (Entry & entry : _entries) {
+					if (entry.motor == &motor) {
+						if (stream != nullptr) {
+							entry.stream = stream;
+							entry.nextIndex = 0;
+						}
+						return;
+					}
+				}
+				Entry entry;
+				entry.motor = &motor;
+				entry.stream = stream;
+				entry.nextIndex = 0;
+				entry.wasUnderrun = false;
+				_entries.push_back(entry);
+			}
+			void MotionProfileFeeder::Remove(IMotorController & motor)
+			{
+				/* waits for a tick in progress, so the controller can be destroyed on return */
+				std::lock_guard<std::mutex> serviceLock(_serviceLck);
+				std::lock_guard<std::mutex> lock(_lck);
+				for (auto it = _entries.begin(); it != _entries.end(); ++it) {
+					if (it->motor == &motor) {
+						_entries.erase(it);
+						return;
+					}
+				}
+			}
+			ctre::phoenix::ErrorCode MotionProfileFeeder::SetWatermarks(int lowWatermark, int highWatermark)
+			{
+				if (lowWatermark < 0 || highWatermark <= lowWatermark)
+					return InvalidParamValue;
+				std::lock_guard<std::mutex> lock(_lck);
+				_lowWatermark = lowWatermark;
+				_highWatermark = highWatermark;
+				return OK;
+			}
+			ctre::phoenix::ErrorCode MotionProfileFeeder::Start(int periodMs)
+			{
+				if (periodMs <= 0)
+					return InvalidParamValue;
+				bool wasRunning = false;
+				if (!_running.compare_exchange_strong(wasRunning, true))
+					return InvalidParamValue;
+				_thread = std::thread(&MotionProfileFeeder::Run, this, periodMs);
+				return OK;
+			}
+			void MotionProfileFeeder::Stop()
+			{
+				_running = false;
+				if (_thread.joinable())
+					_thread.join();
+			}
+			ctre::phoenix::ErrorCode MotionProfileFeeder::SetRealTimePriority(int priority)
+			{
+				if (!_thread.joinable())
+					return InvalidParamValue;
+#if defined(WIN32) || defined(_WIN32) || defined(_WIN64)
+				(void)priority;
+				if (!SetThreadPriority((HANDLE)_thread.native_handle(), THREAD_PRIORITY_TIME_CRITICAL))
+					return GeneralError;
+#else
+				sched_param param;
+				param.sched_priority = priority;
+				if (pthread_setschedparam(_thread.native_handle(), SCHED_FIFO, &param) != 0)
+					return GeneralError;
+#endif
+				return OK;
+			}
+			ctre::phoenix::ErrorCode MotionProfileFeeder::GetStats(IMotorController & motor, MotionProfileFeederStats & stats)
+			{
+				std::lock_guard<std::mutex> lock(_lck);
+				for (const Entry & entry : _entries) {
+					if (entry.motor == &motor) {
+						stats = entry.stats;
+						return OK;
+					}
+				}
+				return InvalidParamValue;
+			}
+			void MotionProfileFeeder::GetTiming(MotionProfileFeederTiming & timing)
+			{
+				std::lock_guard<std::mutex> lock(_lck);
+				timing = _timing;
+				timing.meanLatenessUs = _timing.ticks ? (uint32_t)(_latenessSumUs / _timing.ticks) : 0;
+			}
+			void MotionProfileFeeder::ClearStats()
+			{
+				std::lock_guard<std::mutex> lock(_lck);
+				for (Entry & entry : _entries)
+					entry.stats = MotionProfileFeederStats();
+				_timing = MotionProfileFeederTiming();
+				_latenessSumUs = 0;
+			}
+			void MotionProfileFeeder::Run(int periodMs)
+			{
+				typedef std::chrono::steady_clock Clock;
+				const Clock::duration period = std::chrono::milliseconds(periodMs);
+				Clock::time_point due = Clock::now();
+
+				while (_running) {
+					std::this_thread::sleep_until(due);
+					Clock::time_point start = Clock::now();
+					uint32_t latenessUs = (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(start - due).count();
+
+					{
+						/* CAN calls are made holding only _serviceLck, so stats
+						 * readers are never blocked behind the bus */
+						std::lock_guard<std::mutex> serviceLock(_serviceLck);
+						int lowWatermark, highWatermark;
+						{
+							std::lock_guard<std::mutex> lock(_lck);
+							lowWatermark = _lowWatermark;
+							highWatermark = _highWatermark;
+						}
+						for (Entry & entry : _entries)
+							Service(entry, lowWatermark, highWatermark);
+					}
+
+					uint32_t serviceUs = (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+					std::lock_guard<std::mutex> lock(_lck);
+					++_timing.ticks;
+					_latenessSumUs += latenessUs;
+					if (latenessUs > _timing.maxLatenessUs)
+						_timing.maxLatenessUs = latenessUs;
+					if (serviceUs > _timing.maxServiceUs)
+						_timing.maxServiceUs = serviceUs;
+
+					due += period;
+					/* fell a period or more behind, resync instead of bursting to catch up */
+					if (start - due >= Clock::duration::zero()) {
+						++_timing.missedDeadlines;
+						due = start + period;
+					}
+				}
+			}
+			void MotionProfileFeeder::Service(Entry & entry, int lowWatermark, int highWatermark)
+			{
+				ControlMode mode = entry.motor->GetControlMode();
+				if (mode != ControlMode::MotionProfile && mode != ControlMode::MotionProfileArc) {
+					entry.wasUnderrun = false;
+					return;
+				}
+
+				/* decode staged points only as the top buffer has room */
+				uint32_t pushedPts = 0;
+				if (entry.stream != nullptr) {
+					TrajectoryPoint trajPt;
+					while (entry.nextIndex < entry.stream->GetStagedCount() && !entry.motor->IsMotionProfileTopLevelBufferFull()) {
+						entry.stream->GetStagedPoint(entry.nextIndex, trajPt);
+						if (entry.motor->PushMotionProfileTrajectory(trajPt) != OK)
+							break;
+						++entry.nextIndex;
+						++pushedPts;
+					}
+				}
+
+				MotionProfileStatus status;
+				if (entry.motor->GetMotionProfileStatus(status) != OK) {
+					std::lock_guard<std::mutex> lock(_lck);
+					entry.stats.pushedPts += pushedPts;
+					return;
+				}
+
+				bool enteredUnderrun = status.isUnderrun && !entry.wasUnderrun;
+				entry.wasUnderrun = status.isUnderrun;
+				/* counted even with an empty top buffer, that is starvation, but not
+				 * once the last point is active and the buffer drains as expected */
+				bool belowLow = status.btmBufferCnt < lowWatermark && !status.isLast;
+				bool process = status.topBufferCnt > 0 && status.btmBufferCnt < highWatermark;
+
+				if (process)
+					entry.motor->ProcessMotionProfileBuffer();
+
+				std::lock_guard<std::mutex> lock(_lck);
+				entry.stats.lastBtmBufferCnt = status.btmBufferCnt;
+				if (enteredUnderrun)
+					++entry.stats.underrunEvents;
+				if (belowLow)
+					++entry.stats.lowWatermarkEvents;
+				if (process)
+					++entry.stats.processCalls;
+				entry.stats.pushedPts += pushedPts;
+			}
+		} // namespace motion
+	} // namespace phoenix
+} // namespace ctre
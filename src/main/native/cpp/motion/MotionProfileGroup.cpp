@@ -0,0 +1,186 @@
+#include "ctre/phoenix/motion/MotionProfileGroup.h"
+#include "ctre/phoenix/motion/MotionProfileStatus.h"
+#include "ctre/phoenix/motorcontrol/OutputTransaction.h"
+#include <chrono>
+#include <thread>
+
+using namespace ctre::phoenix::motorcontrol;
+
+namespace ctre {
+	namespace phoenix {
+		namespace motion {
+			typedef std::chrono::steady_clock Clock;
+
+			static uint32_t ElapsedUs(Clock::time_point from, Clock::time_point to)
+			{
+				return (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(to - from).count();
+			}
+
+			void MotionProfileGroup::Add(IMotorController & motor, BufferedTrajectoryPointStream & stream)
+			{
+				Axis axis;
+				axis.motor = &motor;
+				axis.stream = &stream;
+				axis.nextIndex = 0;
+				_axes.push_back(axis);
+			}
+			void MotionProfileGroup::Clear()
+			{
+				_axes.clear();
+				_results.clear();
+			}
+			ctre::phoenix::ErrorCode MotionProfileGroup::Start(uint32_t minBufferedPts, ControlMode motionProfControlMode, int timeoutMs)
+			{
+				Clock::time_point deadline = Clock::now() + std::chrono::milliseconds(timeoutMs);
+				_results.assign(_axes.size(), MotionProfileAxisStart());
+				ErrorCollection errorCollection;
+
+				/* an open transaction would defer both the hold and the release to its commit */
+				if (OutputTransaction::GetCurrent() != nullptr) {
+					for (MotionProfileAxisStart & result : _results)
+						result.error = InvalidParamValue;
+					return InvalidParamValue;
+				}
+
+				/* hold every axis disabled with empty buffers */
+				for (size_t i = 0; i < _axes.size(); ++i) {
+					Axis & axis = _axes[i];
+					ErrorCollection axisErrors;
+					if (!axis.stream->IsStaging() || axis.stream->GetStagedCount() == 0)
+						axisErrors.NewError(InvalidParamValue);
+					axis.motor->Set(motionProfControlMode, SetValueMotionProfile::Disable);
+					axisErrors.NewError(axis.motor->GetLastError());
+					axisErrors.NewError(axis.motor->ClearMotionProfileTrajectories());
+					axisErrors.NewError(axis.motor->ClearMotionProfileHasUnderrun(0));
+					axis.nextIndex = 0;
+					_results[i].error = axisErrors._worstError;
+					errorCollection.NewError(axisErrors._worstError);
+				}
+				if (errorCollection._worstError != OK)
+					return errorCollection._worstError;
+
+				/* fill every firmware buffer */
+				for (;;) {
+					bool ready = true;
+					for (size_t i = 0; i < _axes.size(); ++i) {
+						Axis & axis = _axes[i];
+						ErrorCode er = Feed(axis);
+						if (_results[i].error == OK) { _results[i].error = er; }
+
+						/* a profile shorter than minBufferedPts is ready once it is all buffered */
+						uint32_t target = axis.stream->GetStagedCount();
+						if (target > minBufferedPts)
+							target = minBufferedPts;
+
+						MotionProfileStatus status;
+						er = axis.motor->GetMotionProfileStatus(status);
+						if (_results[i].error == OK) { _results[i].error = er; }
+						/* release only once the hold is confirmed by the controller */
+						if (er != OK || status.btmBufferCnt < (int)target ||
+								status.outputEnable != SetValueMotionProfile::Disable)
+							ready = false;
+					}
+					if (ready)
+						break;
+					if (Clock::now() >= deadline) {
+						for (MotionProfileAxisStart & result : _results) {
+							if (result.error == OK) { result.error = RxTimeout; }
+						}
+						return RxTimeout;
+					}
+					std::this_thread::sleep_for(std::chrono::milliseconds(1));
+				}
+
+				/* release back to back */
+				Clock::time_point releaseStart = Clock::now();
+				for (size_t i = 0; i < _axes.size(); ++i) {
+					_axes[i].motor->Set(motionProfControlMode, SetValueMotionProfile::Enable);
+					_results[i].releaseOffsetUs = ElapsedUs(releaseStart, Clock::now());
+				}
+
+				/* observe each axis start, keep streaming meanwhile */
+				std::vector<bool> started(_axes.size(), false);
+				std::vector<Clock::time_point> startTimes(_axes.size());
+				size_t startedCount = 0;
+				while (startedCount < _axes.size() && Clock::now() < deadline) {
+					for (size_t i = 0; i < _axes.size(); ++i) {
+						if (started[i])
+							continue;
+						Feed(_axes[i]);
+						MotionProfileStatus status;
+						if (_axes[i].motor->GetMotionProfileStatus(status) != OK)
+							continue;
+						if (status.activePointValid && status.outputEnable == SetValueMotionProfile::Enable) {
+							started[i] = true;
+							startTimes[i] = Clock::now();
+							++startedCount;
+						}
+					}
+					if (startedCount < _axes.size())
+						std::this_thread::sleep_for(std::chrono::milliseconds(1));
+				}
+				if (startedCount > 0) {
+					Clock::time_point firstStart = Clock::time_point::max();
+					for (size_t i = 0; i < _axes.size(); ++i) {
+						if (started[i] && startTimes[i] < firstStart)
+							firstStart = startTimes[i];
+					}
+					for (size_t i = 0; i < _axes.size(); ++i) {
+						if (started[i])
+							_results[i].startSkewUs = (int32_t)ElapsedUs(firstStart, startTimes[i]);
+					}
+				}
+
+				for (const MotionProfileAxisStart & result : _results)
+					errorCollection.NewError(result.error);
+				return errorCollection._worstError;
+			}
+			ctre::phoenix::ErrorCode MotionProfileGroup::Process()
+			{
+				ErrorCollection errorCollection;
+				for (Axis & axis : _axes)
+					errorCollection.NewError(Feed(axis));
+				return errorCollection._worstError;
+			}
+			bool MotionProfileGroup::IsFinished()
+			{
+				for (Axis & axis : _axes) {
+					if (axis.nextIndex < axis.stream->GetStagedCount())
+						return false;
+					MotionProfileStatus status;
+					if (axis.motor->GetMotionProfileStatus(status) != OK)
+						return false;
+					if (status.topBufferCnt > 0 || status.btmBufferCnt > 0 || !status.isLast)
+						return false;
+				}
+				return true;
+			}
+			int32_t MotionProfileGroup::GetMaxStartSkewUs() const
+			{
+				int32_t maxSkew = 0;
+				for (const MotionProfileAxisStart & result : _results) {
+					if (result.startSkewUs < 0)
+						return -1;
+					if (result.startSkewUs > maxSkew)
+						maxSkew = result.startSkewUs;
+				}
+				return maxSkew;
+			}
+			ctre::phoenix::ErrorCode MotionProfileGroup::Feed(Axis & axis)
+			{
+				ctre::phoenix::ErrorCode retval = OK;
+				TrajectoryPoint trajPt;
+				/* top up the API (top) buffer, then funnel into the firmware (bottom) buffer */
+				while (axis.nextIndex < axis.stream->GetStagedCount() && !axis.motor->IsMotionProfileTopLevelBufferFull()) {
+					axis.stream->GetStagedPoint(axis.nextIndex, trajPt);
+					retval = axis.motor->PushMotionProfileTrajectory(trajPt);
+					if (retval != OK)
+						break;
+					++axis.nextIndex;
+				}
+				axis.motor->ProcessMotionProfileBuffer();
+				return retval;
+			}
+		} // namespace motion
+	} // namespace phoenix
+} // namespace ctre
@@ -0,0 +1,290 @@
+#include "ctre/phoenix/motion/TrajectoryFile.h"
+#include "ctre/phoenix/motorcontrol/can/BaseMotorController.h"
+#include <cstdio>
+#include <cstring>
+#if defined(WIN32) || defined(_WIN32) || defined(_WIN64)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+namespace ctre {
+	namespace phoenix {
+		namespace motion {
+			static const char kMagic[8] = { 'C', 'T', 'R', 'E', 'T', 'R', 'A', 'J' };
+			static const uint16_t kHeaderSize = 32;
+			static const uint32_t kRecordSize = 72;
+			/* header bytes covered by the header checksum */
+			static const size_t kHeaderCrcOffset = 28;
+
+			static const uint8_t kFlagIsLastPoint = 0x01;
+			static const uint8_t kFlagZeroPos = 0x02;
+			static const uint8_t kFlagUseAuxPID = 0x04;
+
+			/* advance a running CRC-32 register, start at 0xFFFFFFFF */
+			static uint32_t Crc32Update(uint32_t crc, const uint8_t * data, size_t len)
+			{
+				/* reflected 0xEDB88320 table, built on first use */
+				static const struct Table {
+					uint32_t entries[256];
+					Table() {
+						for (uint32_t i = 0; i < 256; ++i) {
+							uint32_t c = i;
+							for (int k = 0; k < 8; ++k)
+								c = (c & 1) ? (0xEDB88320u ^ (c >> 1)) : (c >> 1);
+							entries[i] = c;
+						}
+					}
+				} table;
+
+				for (size_t i = 0; i < len; ++i)
+					crc = table.entries[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+				return crc;
+			}
+			static uint32_t Crc32(const uint8_t * data, size_t len)
+			{
+				return Crc32Update(0xFFFFFFFFu, data, len) ^ 0xFFFFFFFFu;
+			}
+			template <typename T>
+			static void Put(uint8_t * dest, size_t & offset, T value)
+			{
+				std::memcpy(dest + offset, &value, sizeof(T));
+				offset += sizeof(T);
+			}
+			template <typename T>
+			static T Take(const uint8_t * src, size_t & offset)
+			{
+				T value;
+				std::memcpy(&value, src + offset, sizeof(T));
+				offset += sizeof(T);
+				return value;
+			}
+			static void Encode(const TrajectoryPoint & trajPt, uint8_t * record)
+			{
+				size_t offset = 0;
+				Put<double>(record, offset, trajPt.position);
+				Put<double>(record, offset, trajPt.velocity);
+				Put<double>(record, offset, trajPt.arbFeedFwd);
+				Put<double>(record, offset, trajPt.headingDeg);
+				Put<double>(record, offset, trajPt.auxiliaryPos);
+				Put<double>(record, offset, trajPt.auxiliaryVel);
+				Put<double>(record, offset, trajPt.auxiliaryArbFeedFwd);
+				Put<uint32_t>(record, offset, trajPt.profileSlotSelect0);
+				Put<uint32_t>(record, offset, trajPt.profileSlotSelect1);
+				Put<uint32_t>(record, offset, trajPt.timeDur);
+				uint8_t flags = (uint8_t)(
+					(trajPt.isLastPoint ? kFlagIsLastPoint : 0) |
+					(trajPt.zeroPos ? kFlagZeroPos : 0) |
+					(trajPt.useAuxPID ? kFlagUseAuxPID : 0));
+				Put<uint8_t>(record, offset, flags);
+				std::memset(record + offset, 0, kRecordSize - offset);
+			}
+			static void Decode(const uint8_t * record, TrajectoryPoint & trajPt)
+			{
+				size_t offset = 0;
+				trajPt.position = Take<double>(record, offset);
+				trajPt.velocity = Take<double>(record, offset);
+				trajPt.arbFeedFwd = Take<double>(record, offset);
+				trajPt.headingDeg = Take<double>(record, offset);
+				trajPt.auxiliaryPos = Take<double>(record, offset);
+				trajPt.auxiliaryVel = Take<double>(record, offset);
+				trajPt.auxiliaryArbFeedFwd = Take<double>(record, offset);
+				trajPt.profileSlotSelect0 = Take<uint32_t>(record, offset);
+				trajPt.profileSlotSelect1 = Take<uint32_t>(record, offset);
+				trajPt.timeDur = Take<uint32_t>(record, offset);
+				uint8_t flags = Take<uint8_t>(record, offset);
+				trajPt.isLastPoint = (flags & kFlagIsLastPoint) != 0;
+				trajPt.zeroPos = (flags & kFlagZeroPos) != 0;
+				trajPt.useAuxPID = (flags & kFlagUseAuxPID) != 0;
+			}
+			static void Unmap(const uint8_t * data, size_t size)
+			{
+#if defined(WIN32) || defined(_WIN32) || defined(_WIN64)
+				(void)size;
+				UnmapViewOfFile(data);
+#else
+				munmap((void *)data, size);
+#endif
+			}
+			static const uint8_t * Map(const char * path, size_t & size)
+			{
+#if defined(WIN32) || defined(_WIN32) || defined(_WIN64)
+				HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+				if (file == INVALID_HANDLE_VALUE)
+					return nullptr;
+				LARGE_INTEGER fileSize;
+				if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+					CloseHandle(file);
+					return nullptr;
+				}
+				HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+				/* the view keeps the mapping alive once the handles are closed */
+				CloseHandle(file);
+				if (mapping == NULL)
+					return nullptr;
+				void * view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+				CloseHandle(mapping);
+				if (view == NULL)
+					return nullptr;
+				size = (size_t)fileSize.QuadPart;
+				return (const uint8_t *)view;
+#else
+				int fd = open(path, O_RDONLY);
+				if (fd < 0)
+					return nullptr;
+				struct stat st;
+				if (fstat(fd, &st) != 0 || st.st_size == 0) {
+					close(fd);
+					return nullptr;
+				}
+				void * view = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+				/* the mapping stays valid once the descriptor is closed */
+				close(fd);
+				if (view == MAP_FAILED)
+					return nullptr;
+				size = (size_t)st.st_size;
+				return (const uint8_t *)view;
+#endif
+			}
+
+			TrajectoryFile::TrajectoryFile() :
+				_data(nullptr), _size(0), _count(0)
+			{
+			}
+			TrajectoryFile::~TrajectoryFile()
+			{
+				Close();
+			}
+			ctre::phoenix::ErrorCode TrajectoryFile::Save(const char * path, const TrajectoryPoint * trajPts, uint32_t trajPtCount)
+			{
+				if (path == nullptr || (trajPts == nullptr && trajPtCount > 0))
+					return InvalidParamValue;
+
+				uint8_t record[kRecordSize];
+				/* checksum first so the header can be written ahead of the records */
+				uint32_t crc = 0xFFFFFFFFu;
+				for (uint32_t i = 0; i < trajPtCount; ++i) {
+					Encode(trajPts[i], record);
+					crc = Crc32Update(crc, record, kRecordSize);
+				}
+				uint32_t payloadCrc = crc ^ 0xFFFFFFFFu;
+
+				uint8_t header[kHeaderSize];
+				size_t offset = 0;
+				std::memcpy(header, kMagic, sizeof(kMagic));
+				offset += sizeof(kMagic);
+				Put<uint16_t>(header, offset, kVersion);
+				Put<uint16_t>(header, offset, kHeaderSize);
+				Put<uint32_t>(header, offset, trajPtCount);
+				Put<uint32_t>(header, offset, kRecordSize);
+				Put<uint32_t>(header, offset, 0);
+				Put<uint32_t>(header, offset, payloadCrc);
+				Put<uint32_t>(header, offset, Crc32(header, kHeaderCrcOffset));
+
+				FILE * file = std::fopen(path, "wb");
+				if (file == nullptr)
+					return GeneralError;
+
+				bool ok = std::fwrite(header, kHeaderSize, 1, file) == 1;
+				for (uint32_t i = 0; ok && i < trajPtCount; ++i) {
+					Encode(trajPts[i], record);
+					ok = std::fwrite(record, kRecordSize, 1, file) == 1;
+				}
+				ok = (std::fclose(file) == 0) && ok;
+				return ok ? OK : GeneralError;
+			}
+			ctre::phoenix::ErrorCode TrajectoryFile::Open(const char * path)
+			{
+				Close();
+				if (path == nullptr)
+					return InvalidParamValue;
+
+				size_t size = 0;
+				const uint8_t * data = Map(path, size);
+				if (data == nullptr)
+					return GeneralError;
+
+				bool ok = size >= kHeaderSize && std::memcmp(data, kMagic, sizeof(kMagic)) == 0;
+				uint32_t count = 0;
+				if (ok) {
+					size_t offset = sizeof(kMagic);
+					uint16_t version = Take<uint16_t>(data, offset);
+					uint16_t headerSize = Take<uint16_t>(data, offset);
+					count = Take<uint32_t>(data, offset);
+					uint32_t recordSize = Take<uint32_t>(data, offset);
+					Take<uint32_t>(data, offset);
+					uint32_t payloadCrc = Take<uint32_t>(data, offset);
+					uint32_t headerCrc = Take<uint32_t>(data, offset);
+
+					ok = (headerCrc == Crc32(data, kHeaderCrcOffset)) &&
+						(version == kVersion) &&
+						(headerSize == kHeaderSize) &&
+						(recordSize == kRecordSize) &&
+						/* bound count before multiplying, size_t is 32 bits on the roboRIO */
+						(count <= (size - kHeaderSize) / kRecordSize) &&
+						(size == kHeaderSize + (size_t)count * kRecordSize) &&
+						(payloadCrc == Crc32(data + kHeaderSize, (size_t)count * kRecordSize));
+				}
+				if (!ok) {
+					Unmap(data, size);
+					return InvalidParamValue;
+				}
+
+				_data = data;
+				_size = size;
+				_count = count;
+				return OK;
+			}
+			void TrajectoryFile::Close()
+			{
+				if (_data != nullptr)
+					Unmap(_data, _size);
+				_data = nullptr;
+				_size = 0;
+				_count = 0;
+			}
+			ctre::phoenix::ErrorCode TrajectoryFile::GetPoint(uint32_t index, TrajectoryPoint & trajPt) const
+			{
+				if (index >= _count)
+					return InvalidParamValue;
+				Decode(_data + kHeaderSize + (size_t)index * kRecordSize, trajPt);
+				return OK;
+			}
+			ctre::phoenix::ErrorCode TrajectoryFile::WriteTo(BufferedTrajectoryPointStream & stream, uint32_t first, uint32_t maxTrajPts) const
+			{
+				if (first > _count)
+					return InvalidParamValue;
+				uint32_t end = (maxTrajPts < _count - first) ? first + maxTrajPts : _count;
+
+				ctre::phoenix::ErrorCode retval = OK;
+				TrajectoryPoint trajPt;
+				for (uint32_t i = first; i < end; ++i) {
+					GetPoint(i, trajPt);
+					ctre::phoenix::ErrorCode er = stream.Write(trajPt);
+					/* save first nonzero error code */
+					if (retval == OK) { retval = er; }
+				}
+				return retval;
+			}
+			ctre::phoenix::ErrorCode TrajectoryFile::PushTo(ctre::phoenix::motorcontrol::can::BaseMotorController & motor, uint32_t & nextIndex, uint32_t maxTrajPts) const
+			{
+				if (nextIndex > _count)
+					return InvalidParamValue;
+				uint32_t end = (maxTrajPts < _count - nextIndex) ? nextIndex + maxTrajPts : _count;
+
+				TrajectoryPoint trajPt;
+				for (; nextIndex < end; ++nextIndex) {
+					GetPoint(nextIndex, trajPt);
+					ctre::phoenix::ErrorCode er = motor.PushMotionProfileTrajectory(trajPt);
+					if (er != OK)
+						return er;
+				}
+				return OK;
+			}
+		} // namespace motion
+	} // namespace phoenix
+} // namespace ctre
@@ -0,0 +1,136 @@
+#include "ctre/phoenix/motion/TrajectoryGenerator.h"
+#include "ctre/phoenix/motorcontrol/IMotorController.h"
+#include <cmath>
+
+using namespace ctre::phoenix::motorcontrol;
+
+namespace ctre {
+	namespace phoenix {
+		namespace motion {
+			void TrajectoryGenerator::Filter::Reset(size_t length)
+			{
+				window.assign(length, 0);
+				next = 0;
+				sum = 0;
+			}
+			double TrajectoryGenerator::Filter::Step(double input)
+			{
+				sum += input - window[next];
+				window[next] = input;
+				if (++next == window.size())
+					next = 0;
+				return sum / window.size();
+			}
+
+			TrajectoryGenerator::TrajectoryGenerator()
+			{
+				_filter1.Reset(1);
+				_filter2.Reset(1);
+			}
+			ctre::phoenix::ErrorCode TrajectoryGenerator::Configure(double startPos, double endPos, double cruiseVelocity, double acceleration,
+				int sCurveStrength, uint32_t timeDurMs, uint32_t profileSlotSelect0)
+			{
+				if (!(cruiseVelocity > 0) || !(acceleration > 0) || timeDurMs == 0)
+					return InvalidParamValue;
+				if (sCurveStrength < 0 || sCurveStrength > 8)
+					return InvalidParamValue;
+
+				double distance = endPos - startPos;
+				/* velocity is per 100ms, so a point covers timeDurMs/100 of it */
+				double pointsAtCruise = std::ceil(std::fabs(distance) / (cruiseVelocity * timeDurMs / 100.0));
+				double accelPoints = std::ceil(cruiseVelocity / acceleration * 1000.0 / timeDurMs);
+				/* the filter windows are allocated, so a tiny acceleration must not size them */
+				if (!(accelPoints <= kMaxAccelPoints))
+					return InvalidParamValue;
+				if (!(pointsAtCruise + 2 * accelPoints < (double)UINT32_MAX))
+					return InvalidParamValue;
+
+				uint32_t length1 = (accelPoints > 1) ? (uint32_t)accelPoints : 1;
+				uint32_t length2 = (uint32_t)std::lround(length1 * sCurveStrength / 8.0);
+				if (length2 < 1)
+					length2 = 1;
+
+				_startPos = startPos;
+				_endPos = endPos;
+				_inputCount = (uint32_t)pointsAtCruise;
+				/* trim the cruise velocity so the input area is exactly the distance */
+				_inputVelocity = (_inputCount > 0) ? distance / (_inputCount * timeDurMs / 100.0) : 0;
+				_timeDurMs = timeDurMs;
+				_profileSlotSelect0 = profileSlotSelect0;
+				/* length of the input step convolved with both filters, plus the final rest point */
+				_totalCount = _inputCount + length1 + length2 - 1;
+
+				_filter1.Reset(length1);
+				_filter2.Reset(length2);
+				_index = 0;
+				_position = startPos;
+				_velocity = 0;
+				_pending = false;
+				return OK;
+			}
+			bool TrajectoryGenerator::Next(TrajectoryPoint & trajPt)
+			{
+				if (_pending) {
+					trajPt = _pendingPt;
+					_pending = false;
+					return true;
+				}
+				if (IsDone())
+					return false;
+
+				double input = (_index < _inputCount) ? _inputVelocity : 0;
+				double velocity = _filter2.Step(_filter1.Step(input));
+				_position += (_velocity + velocity) / 2 * _timeDurMs / 100.0;
+				_velocity = velocity;
+				++_index;
+
+				trajPt.position = _position;
+				trajPt.velocity = velocity;
+				trajPt.arbFeedFwd = 0;
+				trajPt.headingDeg = 0;
+				trajPt.auxiliaryPos = 0;
+				trajPt.auxiliaryVel = 0;
+				trajPt.auxiliaryArbFeedFwd = 0;
+				trajPt.profileSlotSelect0 = _profileSlotSelect0;
+				trajPt.profileSlotSelect1 = 0;
+				trajPt.isLastPoint = IsDone();
+				trajPt.zeroPos = false;
+				trajPt.timeDur = _timeDurMs;
+				trajPt.useAuxPID = false;
+				if (trajPt.isLastPoint) {
+					/* remove accumulated rounding */
+					trajPt.position = _endPos;
+					trajPt.velocity = 0;
+				}
+				return true;
+			}
+			ctre::phoenix::ErrorCode TrajectoryGenerator::WriteTo(BufferedTrajectoryPointStream & stream, uint32_t maxTrajPts)
+			{
+				ctre::phoenix::ErrorCode retval = OK;
+				TrajectoryPoint trajPt;
+				for (uint32_t i = 0; i < maxTrajPts && Next(trajPt); ++i) {
+					ctre::phoenix::ErrorCode er = stream.Write(trajPt);
+					/* save first nonzero error code */
+					if (retval == OK) { retval = er; }
+				}
+				return retval;
+			}
+			ctre::phoenix::ErrorCode TrajectoryGenerator::PushTo(IMotorController & motor, uint32_t maxTrajPts)
+			{
+				TrajectoryPoint trajPt;
+				for (uint32_t i = 0; i < maxTrajPts && !motor.IsMotionProfileTopLevelBufferFull(); ++i) {
+					if (!Next(trajPt))
+						break;
+					ctre::phoenix::ErrorCode er = motor.PushMotionProfileTrajectory(trajPt);
+					if (er != OK) {
+						/* keep the point for the next call */
+						_pendingPt = trajPt;
+						_pending = true;
+						return er;
+					}
+				}
+				return OK;
+			}
+		} // namespace motion
+	} // namespace phoenix
+} // namespace ctre
@@ -0,0 +1,88 @@
+#include "ctre/phoenix/motorcontrol/MotorGroup.h"
+#include "ctre/phoenix/motorcontrol/OutputTransaction.h"
+#include "ctre/phoenix/motorcontrol/can/BaseMotorController.h"
+
+using namespace ctre::phoenix;
+using namespace ctre::phoenix::motorcontrol::can;
+
+namespace ctre {
+namespace phoenix {
+namespace motorcontrol {
+
+namespace {
+/* sends everything staged in its scope together, unless the caller already has a transaction open */
+class GroupScope {
+public:
+	GroupScope() {
+		if (OutputTransaction::GetCurrent() == nullptr)
+			_txn.Begin();
+	}
+private:
+	OutputTransaction _txn;
+};
+}
+
+MotorGroup::MotorGroup(BaseMotorController & master) {
+	Member member;
+	member.motor = &master;
+	member.invertType = InvertType::None;
+	member.followerType = FollowerType_PercentOutput;
+	_members.push_back(member);
+}
+void MotorGroup::AddFollower(BaseMotorController & follower, InvertType invertType, FollowerType followerType) {
+	Member member;
+	member.motor = &follower;
+	member.invertType = invertType;
+	member.followerType = followerType;
+	_members.push_back(member);
+	follower.SetInverted(invertType);
+	/* engage the new follower on the next Set() */
+	_followersEngaged = false;
+}
+void MotorGroup::Set(ControlMode mode, double demand0, DemandType demand1Type, double demand1) {
+	GroupScope scope;
+	GetMaster().Set(mode, demand0, demand1Type, demand1);
+	if (!_followersEngaged)
+		EngageFollowers();
+}
+void MotorGroup::NeutralOutput() {
+	GroupScope scope;
+	for (Member & member : _members)
+		member.motor->NeutralOutput();
+	_followersEngaged = false;
+}
+void MotorGroup::RefreshFollowers() {
+	GroupScope scope;
+	EngageFollowers();
+}
+void MotorGroup::SetNeutralMode(NeutralMode neutralMode) {
+	for (Member & member : _members)
+		member.motor->SetNeutralMode(neutralMode);
+}
+void MotorGroup::SetInverted(bool invert) {
+	GetMaster().SetInverted(invert);
+	for (size_t i = 1; i < _members.size(); ++i)
+		_members[i].motor->SetInverted(_members[i].invertType);
+}
+ErrorCode MotorGroup::ConfigOpenloopRamp(double secondsFromNeutralToFull, int timeoutMs) {
+	ErrorCollection errorCollection;
+	for (Member & member : _members)
+		errorCollection.NewError(member.motor->ConfigOpenloopRamp(secondsFromNeutralToFull, timeoutMs));
+	return errorCollection._worstError;
+}
+ErrorCode MotorGroup::ConfigClosedloopRamp(double secondsFromNeutralToFull, int timeoutMs) {
+	ErrorCollection errorCollection;
+	for (Member & member : _members)
+		errorCollection.NewError(member.motor->ConfigClosedloopRamp(secondsFromNeutralToFull, timeoutMs));
+	return errorCollection._worstError;
+}
+void MotorGroup::EngageFollowers() {
+	BaseMotorController & master = GetMaster();
+	for (size_t i = 1; i < _members.size(); ++i)
+		_members[i].motor->Follow(master, _members[i].followerType);
+	_followersEngaged = true;
+}
+
+} // namespace motorcontrol
+} // namespace phoenix
+} // namespace ctre
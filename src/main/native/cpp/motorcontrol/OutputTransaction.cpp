@@ -0,0 +1,65 @@
+#include "ctre/phoenix/motorcontrol/OutputTransaction.h"
+#include "ctre/phoenix/motorcontrol/can/BaseMotorController.h"
+#include <algorithm>
+
+using namespace ctre::phoenix;
+
+namespace ctre {
+namespace phoenix {
+namespace motorcontrol {
+
+static thread_local OutputTransaction * _current = nullptr;
+
+OutputTransaction::OutputTransaction() {
+}
+OutputTransaction::~OutputTransaction() {
+	if (_open)
+		Commit();
+}
+ErrorCode OutputTransaction::Begin() {
+	if (_current != nullptr || _open)
+		return InvalidParamValue;
+	_open = true;
+	_current = this;
+	return OK;
+}
+void OutputTransaction::Commit() {
+	/* close first so the sends below are not staged again */
+	Close();
+	for (can::BaseMotorController * motor : _motors) {
+		motor->_transaction = nullptr;
+		motor->SendStagedDemand();
+	}
+	/* keep the capacity, a transaction is typically reused every loop */
+	_motors.clear();
+}
+void OutputTransaction::Abort() {
+	Close();
+	for (can::BaseMotorController * motor : _motors)
+		motor->_transaction = nullptr;
+	_motors.clear();
+}
+bool OutputTransaction::IsOpen() const {
+	return _open;
+}
+size_t OutputTransaction::GetStagedCount() const {
+	return _motors.size();
+}
+OutputTransaction * OutputTransaction::GetCurrent() {
+	return _current;
+}
+void OutputTransaction::Add(can::BaseMotorController * motor) {
+	_motors.push_back(motor);
+}
+void OutputTransaction::Remove(can::BaseMotorController * motor) {
+	_motors.erase(std::remove(_motors.begin(), _motors.end(), motor), _motors.end());
+}
+void OutputTransaction::Close() {
+	if (_current == this)
+		_current = nullptr;
+	_open = false;
+}
+
+} // namespace motorcontrol
+} // namespace phoenix
+} // namespace ctre
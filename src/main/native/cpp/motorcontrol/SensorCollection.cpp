@@ -4,8 +4,9 @@
 using namespace ctre::phoenix;
 using namespace ctre::phoenix::motorcontrol;
 
-SensorCollection::SensorCollection(void * handle) {
+SensorCollection::SensorCollection(void * handle, StatusFrameDemand * demand) {
 	_handle = handle;
+	_demand = demand;
 }
 
 /**
@@ -18,11 +19,26 @@ SensorCollection::SensorCollection(void * handle) {
  */
 
 int SensorCollection::GetAnalogIn() {
+	NoteDemand(StatusFrameEnhanced::Status_4_AinTempVbat);
 	int retval = 0;
 	c_MotController_GetAnalogIn(_handle, &retval);
 	return retval;
 }
 
+/**
+ * Gets the analog in position (24bit) with the time of the read, see Timestamped.
+ *
+ * @param value Caller's value to update.
+ * @return Error Code of the read. 0 indicates the value is fresh.
+ */
+ErrorCode SensorCollection::GetAnalogIn(Timestamped<int> & value) {
+	NoteDemand(StatusFrameEnhanced::Status_4_AinTempVbat);
+	int param = 0;
+	ErrorCode retval = (ErrorCode)c_MotController_GetAnalogIn(_handle, &param);
+	value.Update(param, retval, GetMonotonicUs());
+	return retval;
+}
+
 /**
  * Sets analog position.
  *
@@ -47,6 +63,7 @@ ErrorCode SensorCollection::SetAnalogPosition(int newPosition, int timeoutMs) {
  */
 
 int SensorCollection::GetAnalogInRaw() {
+	NoteDemand(StatusFrameEnhanced::Status_4_AinTempVbat);
 	int retval = 0;
 	c_MotController_GetAnalogInRaw(_handle, &retval);
 	return retval;
@@ -60,11 +77,26 @@ int SensorCollection::GetAnalogInRaw() {
  */
 
 int SensorCollection::GetAnalogInVel() {
+	NoteDemand(StatusFrameEnhanced::Status_4_AinTempVbat);
 	int retval = 0;
 	c_MotController_GetAnalogInVel(_handle, &retval);
 	return retval;
 }
 
+/**
+ * Gets the analog in velocity (in units per 100ms) with the time of the read, see Timestamped.
+ *
+ * @param value Caller's value to update.
+ * @return Error Code of the read. 0 indicates the value is fresh.
+ */
+ErrorCode SensorCollection::GetAnalogInVel(Timestamped<int> & value) {
+	NoteDemand(StatusFrameEnhanced::Status_4_AinTempVbat);
+	int param = 0;
+	ErrorCode retval = (ErrorCode)c_MotController_GetAnalogInVel(_handle, &param);
+	value.Update(param, retval, GetMonotonicUs());
+	return retval;
+}
+
 /**
  * Get the quadrature position of the Talon, regardless of whether
  *   it is actually being used for feedback.
@@ -73,11 +105,26 @@ int SensorCollection::GetAnalogInVel() {
  */
 
 int SensorCollection::GetQuadraturePosition() {
+	NoteDemand(StatusFrameEnhanced::Status_3_Quadrature);
 	int retval = 0;
 	c_MotController_GetQuadraturePosition(_handle, &retval);
 	return retval;
 }
 
+/**
+ * Gets the quadrature position with the time of the read, see Timestamped.
+ *
+ * @param value Caller's value to update.
+ * @return Error Code of the read. 0 indicates the value is fresh.
+ */
+ErrorCode SensorCollection::GetQuadraturePosition(Timestamped<int> & value) {
+	NoteDemand(StatusFrameEnhanced::Status_3_Quadrature);
+	int param = 0;
+	ErrorCode retval = (ErrorCode)c_MotController_GetQuadraturePosition(_handle, &param);
+	value.Update(param, retval, GetMonotonicUs());
+	return retval;
+}
+
 /**
  * Change the quadrature reported position.  Typically this is used to "zero" the
  *   sensor. This only works with Quadrature sensor.  To set the selected sensor position
@@ -232,11 +279,26 @@ ErrorCode SensorCollection::SyncQuadratureWithPulseWidth(int bookend0, int booke
  */
 
 int SensorCollection::GetQuadratureVelocity() {
+	NoteDemand(StatusFrameEnhanced::Status_3_Quadrature);
 	int retval = 0;
 	c_MotController_GetQuadratureVelocity(_handle, &retval);
 	return retval;
 }
 
+/**
+ * Gets the quadrature velocity (in units per 100ms) with the time of the read, see Timestamped.
+ *
+ * @param value Caller's value to update.
+ * @return Error Code of the read. 0 indicates the value is fresh.
+ */
+ErrorCode SensorCollection::GetQuadratureVelocity(Timestamped<int> & value) {
+	NoteDemand(StatusFrameEnhanced::Status_3_Quadrature);
+	int param = 0;
+	ErrorCode retval = (ErrorCode)c_MotController_GetQuadratureVelocity(_handle, &param);
+	value.Update(param, retval, GetMonotonicUs());
+	return retval;
+}
+
 /**
  * Gets pulse width position, regardless of whether
  *   it is actually being used for feedback.
@@ -245,11 +307,26 @@ int SensorCollection::GetQuadratureVelocity() {
  */
 
 int SensorCollection::GetPulseWidthPosition() {
+	NoteDemand(StatusFrameEnhanced::Status_8_PulseWidth);
 	int retval = 0;
 	c_MotController_GetPulseWidthPosition(_handle, &retval);
 	return retval;
 }
 
+/**
+ * Gets the pulse width position with the time of the read, see Timestamped.
+ *
+ * @param value Caller's value to update.
+ * @return Error Code of the read. 0 indicates the value is fresh.
+ */
+ErrorCode SensorCollection::GetPulseWidthPosition(Timestamped<int> & value) {
+	NoteDemand(StatusFrameEnhanced::Status_8_PulseWidth);
+	int param = 0;
+	ErrorCode retval = (ErrorCode)c_MotController_GetPulseWidthPosition(_handle, &param);
+	value.Update(param, retval, GetMonotonicUs());
+	return retval;
+}
+
 /**
  * Sets pulse width position.
  *
@@ -275,11 +352,26 @@ ErrorCode SensorCollection::SetPulseWidthPosition(int newPosition,
  */
 
 int SensorCollection::GetPulseWidthVelocity() {
+	NoteDemand(StatusFrameEnhanced::Status_8_PulseWidth);
 	int retval = 0;
 	c_MotController_GetPulseWidthVelocity(_handle, &retval);
 	return retval;
 }
 
+/**
+ * Gets the pulse width velocity (in units per 100ms) with the time of the read, see Timestamped.
+ *
+ * @param value Caller's value to update.
+ * @return Error Code of the read. 0 indicates the value is fresh.
+ */
+ErrorCode SensorCollection::GetPulseWidthVelocity(Timestamped<int> & value) {
+	NoteDemand(StatusFrameEnhanced::Status_8_PulseWidth);
+	int param = 0;
+	ErrorCode retval = (ErrorCode)c_MotController_GetPulseWidthVelocity(_handle, &param);
+	value.Update(param, retval, GetMonotonicUs());
+	return retval;
+}
+
 /**
  * Gets pulse width rise to fall time.
  *
@@ -287,6 +379,7 @@ int SensorCollection::GetPulseWidthVelocity() {
  */
 
 int SensorCollection::GetPulseWidthRiseToFallUs() {
+	NoteDemand(StatusFrameEnhanced::Status_8_PulseWidth);
 	int retval = 0;
 	c_MotController_GetPulseWidthRiseToFallUs(_handle, &retval);
 	return retval;
@@ -299,6 +392,7 @@ int SensorCollection::GetPulseWidthRiseToFallUs() {
  */
 
 int SensorCollection::GetPulseWidthRiseToRiseUs() {
+	NoteDemand(StatusFrameEnhanced::Status_8_PulseWidth);
 	int retval = 0;
 	c_MotController_GetPulseWidthRiseToRiseUs(_handle, &retval);
 	return retval;
@@ -311,6 +405,7 @@ int SensorCollection::GetPulseWidthRiseToRiseUs() {
  */
 
 int SensorCollection::GetPinStateQuadA() {
+	NoteDemand(StatusFrameEnhanced::Status_3_Quadrature);
 	int retval = 0;
 	c_MotController_GetPinStateQuadA(_handle, &retval);
 	return retval;
@@ -323,6 +418,7 @@ int SensorCollection::GetPinStateQuadA() {
  */
 
 int SensorCollection::GetPinStateQuadB() {
+	NoteDemand(StatusFrameEnhanced::Status_3_Quadrature);
 	int retval = 0;
 	c_MotController_GetPinStateQuadB(_handle, &retval);
 	return retval;
@@ -335,6 +431,7 @@ int SensorCollection::GetPinStateQuadB() {
  */
 
 int SensorCollection::GetPinStateQuadIdx() {
+	NoteDemand(StatusFrameEnhanced::Status_3_Quadrature);
 	int retval = 0;
 	c_MotController_GetPinStateQuadIdx(_handle, &retval);
 	return retval;
@@ -348,6 +445,7 @@ int SensorCollection::GetPinStateQuadIdx() {
  */
 
 int SensorCollection::IsFwdLimitSwitchClosed() {
+	NoteDemand(StatusFrameEnhanced::Status_1_General);
 	int retval = 0;
 	c_MotController_IsFwdLimitSwitchClosed(_handle, &retval);
 	return retval;
@@ -361,6 +459,7 @@ int SensorCollection::IsFwdLimitSwitchClosed() {
  */
 
 int SensorCollection::IsRevLimitSwitchClosed() {
+	NoteDemand(StatusFrameEnhanced::Status_1_General);
 	int retval = 0;
 	c_MotController_IsRevLimitSwitchClosed(_handle, &retval);
 	return retval;
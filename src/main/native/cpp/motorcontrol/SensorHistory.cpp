@@ -0,0 +1,141 @@
+#include "ctre/phoenix/motorcontrol/SensorHistory.h"
+#include "ctre/phoenix/motorcontrol/SensorCollection.h"
+#include <chrono>
+#include <cstring>
+
+using namespace ctre::phoenix;
+
+namespace ctre {
+namespace phoenix {
+namespace motorcontrol {
+
+SensorHistory::SensorHistory(SensorCollection & sensors, size_t capacity, int signals) :
+		_sensors(sensors), _signals(signals), _slots(capacity > 0 ? capacity : 1), _written(0), _lastCaptureUs(0), _running(false) {
+	for (Slot & slot : _slots)
+		slot.seq.store(0, std::memory_order_relaxed);
+}
+SensorHistory::~SensorHistory() {
+	Stop();
+}
+ErrorCode SensorHistory::Start(int periodMs, int framePeriodMs) {
+	if (periodMs <= 0 || framePeriodMs < 0 || _running)
+		return InvalidParamValue;
+	_running = true;
+	_thread = std::thread(&SensorHistory::Run, this, periodMs, framePeriodMs);
+	return OK;
+}
+void SensorHistory::Stop() {
+	_running = false;
+	if (_thread.joinable())
+		_thread.join();
+}
+size_t SensorHistory::ReadSince(uint64_t & cursor, SensorSample * samples, size_t maxSamples, uint64_t * skipped) const {
+	uint64_t end = _written.load(std::memory_order_acquire);
+	uint64_t oldest = (end > _slots.size()) ? end - _slots.size() : 0;
+	uint64_t lost = 0;
+
+	if (cursor > end)
+		cursor = end;
+	if (cursor < oldest) {
+		lost += oldest - cursor;
+		cursor = oldest;
+	}
+
+	size_t count = 0;
+	for (; cursor < end && count < maxSamples; ++cursor) {
+		const Slot & slot = _slots[cursor % _slots.size()];
+		uint64_t committed = 2 * (cursor + 1);
+		/* no retries: a slot overwritten while copying is counted as lost */
+		if (slot.seq.load(std::memory_order_acquire) != committed) {
+			++lost;
+			continue;
+		}
+		std::memcpy(&samples[count], &slot.sample, sizeof(SensorSample));
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (slot.seq.load(std::memory_order_relaxed) != committed) {
+			++lost;
+			continue;
+		}
+		++count;
+	}
+	if (skipped)
+		*skipped = lost;
+	return count;
+}
+void SensorHistory::Run(int periodMs, int framePeriodMs) {
+	typedef std::chrono::steady_clock Clock;
+	const Clock::duration period = std::chrono::milliseconds(periodMs);
+	Clock::time_point due = Clock::now();
+
+	while (_running) {
+		std::this_thread::sleep_until(due);
+
+		SensorSample sample;
+		if (Capture(sample)) {
+			_lastCaptureUs.store(sample.timestampUs, std::memory_order_relaxed);
+			if (!IsRepeat(sample, framePeriodMs)) {
+				Append(sample);
+				_last = sample;
+				_haveLast = true;
+			}
+		}
+
+		due += period;
+		/* fell a period or more behind, resync instead of bursting to catch up */
+		if (Clock::now() - due >= Clock::duration::zero())
+			due = Clock::now() + period;
+	}
+}
+bool SensorHistory::Capture(SensorSample & sample) {
+	Timestamped<int> position;
+	Timestamped<int> velocity;
+	sample.timestampUs = GetMonotonicUs();
+
+	if (_signals & kQuadrature) {
+		if (_sensors.GetQuadraturePosition(position) != OK || _sensors.GetQuadratureVelocity(velocity) != OK)
+			return false;
+		sample.quadraturePosition = position.value;
+		sample.quadratureVelocity = velocity.value;
+	}
+	if (_signals & kPulseWidth) {
+		if (_sensors.GetPulseWidthPosition(position) != OK || _sensors.GetPulseWidthVelocity(velocity) != OK)
+			return false;
+		sample.pulseWidthPosition = position.value;
+		sample.pulseWidthVelocity = velocity.value;
+	}
+	if (_signals & kAnalog) {
+		if (_sensors.GetAnalogIn(position) != OK || _sensors.GetAnalogInVel(velocity) != OK)
+			return false;
+		sample.analogIn = position.value;
+		sample.analogInVel = velocity.value;
+	}
+	return true;
+}
+bool SensorHistory::IsRepeat(const SensorSample & sample, int framePeriodMs) const {
+	/* a frame period after the last sample, an unchanged capture is a new frame of a stationary sensor */
+	if (framePeriodMs > 0 && sample.timestampUs - _last.timestampUs >= (int64_t)framePeriodMs * 1000)
+		return false;
+	/* polled faster than the status frame, the same frame reads back unchanged */
+	return _haveLast &&
+			sample.quadraturePosition == _last.quadraturePosition &&
+			sample.quadratureVelocity == _last.quadratureVelocity &&
+			sample.pulseWidthPosition == _last.pulseWidthPosition &&
+			sample.pulseWidthVelocity == _last.pulseWidthVelocity &&
+			sample.analogIn == _last.analogIn &&
+			sample.analogInVel == _last.analogInVel;
+}
+void SensorHistory::Append(const SensorSample & sample) {
+	/* single writer, so the index is only read here */
+	uint64_t index = _written.load(std::memory_order_relaxed);
+	Slot & slot = _slots[index % _slots.size()];
+
+	slot.seq.store(2 * index + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	std::memcpy(&slot.sample, &sample, sizeof(SensorSample));
+	slot.seq.store(2 * (index + 1), std::memory_order_release);
+	_written.store(index + 1, std::memory_order_release);
+}
+
+} // namespace motorcontrol
+} // namespace phoenix
+} // namespace ctre
@@ -0,0 +1,134 @@
+#include "ctre/phoenix/motorcontrol/StatusFramePeriodManager.h"
+#include "ctre/phoenix/motorcontrol/can/BaseMotorController.h"
+
+using namespace ctre::phoenix;
+using namespace ctre::phoenix::motorcontrol::can;
+
+namespace ctre {
+namespace phoenix {
+namespace motorcontrol {
+
+StatusFramePeriodManager::StatusFramePeriodManager() :
+		_evaluationPeriod(std::chrono::milliseconds(1000)) {
+	for (int i = 0; i < StatusFrameDemand::kFrameCount; ++i) {
+		_defaults[i].minPeriodMs = 5;
+		_defaults[i].maxPeriodMs = kMaxPeriodMs;
+	}
+	/* followers track their master's output from this frame */
+	_defaults[StatusFrameDemand::IndexOf(StatusFrameEnhanced::Status_1_General)].maxPeriodMs = 20;
+}
+void StatusFramePeriodManager::Add(BaseMotorController & motor) {
+	for (const Entry & entry : _entries) {
+		if (entry.motor == &motor)
+			return;
+	}
+	Entry entry;
+	entry.motor = &motor;
+	for (int i = 0; i < StatusFrameDemand::kFrameCount; ++i) {
+		entry.bounds[i] = _defaults[i];
+		entry.periodMs[i] = 0;
+		/* discard reads counted before the controller was managed */
+		motor.GetStatusFrameDemand().Take(i);
+	}
+	entry.resetCount = motor.GetResetCount();
+	entry.windowStart = Clock::now();
+	_entries.push_back(entry);
+}
+void StatusFramePeriodManager::Remove(BaseMotorController & motor) {
+	for (auto it = _entries.begin(); it != _entries.end(); ++it) {
+		if (it->motor == &motor) {
+			_entries.erase(it);
+			return;
+		}
+	}
+}
+ErrorCode StatusFramePeriodManager::SetBounds(StatusFrameEnhanced frame, int minPeriodMs, int maxPeriodMs) {
+	int index = StatusFrameDemand::IndexOf(frame);
+	if (index < 0 || !IsValid(minPeriodMs, maxPeriodMs))
+		return InvalidParamValue;
+	_defaults[index].minPeriodMs = minPeriodMs;
+	_defaults[index].maxPeriodMs = maxPeriodMs;
+	for (Entry & entry : _entries)
+		entry.bounds[index] = _defaults[index];
+	return OK;
+}
+ErrorCode StatusFramePeriodManager::SetBounds(BaseMotorController & motor, StatusFrameEnhanced frame, int minPeriodMs, int maxPeriodMs) {
+	int index = StatusFrameDemand::IndexOf(frame);
+	if (index < 0 || !IsValid(minPeriodMs, maxPeriodMs))
+		return InvalidParamValue;
+	for (Entry & entry : _entries) {
+		if (entry.motor == &motor) {
+			entry.bounds[index].minPeriodMs = minPeriodMs;
+			entry.bounds[index].maxPeriodMs = maxPeriodMs;
+			return OK;
+		}
+	}
+	return InvalidParamValue;
+}
+ErrorCode StatusFramePeriodManager::SetEvaluationPeriod(int periodMs) {
+	if (periodMs <= 0)
+		return InvalidParamValue;
+	_evaluationPeriod = std::chrono::milliseconds(periodMs);
+	return OK;
+}
+int StatusFramePeriodManager::GetPeriod(BaseMotorController & motor, StatusFrameEnhanced frame) const {
+	int index = StatusFrameDemand::IndexOf(frame);
+	if (index < 0)
+		return 0;
+	for (const Entry & entry : _entries) {
+		if (entry.motor == &motor)
+			return entry.periodMs[index];
+	}
+	return 0;
+}
+void StatusFramePeriodManager::Process() {
+	Clock::time_point now = Clock::now();
+	for (Entry & entry : _entries) {
+		Clock::duration elapsed = now - entry.windowStart;
+		if (elapsed < _evaluationPeriod)
+			continue;
+		entry.windowStart = now;
+		Evaluate(entry, std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count());
+	}
+}
+bool StatusFramePeriodManager::IsValid(int minPeriodMs, int maxPeriodMs) {
+	return minPeriodMs >= kMinPeriodMs && maxPeriodMs <= kMaxPeriodMs && minPeriodMs <= maxPeriodMs;
+}
+void StatusFramePeriodManager::Evaluate(Entry & entry, int64_t windowMs) {
+	/* a reset restores the default periods, so resend everything */
+	uint32_t resetCount = entry.motor->GetResetCount();
+	if (resetCount != entry.resetCount) {
+		entry.resetCount = resetCount;
+		for (int i = 0; i < StatusFrameDemand::kFrameCount; ++i)
+			entry.periodMs[i] = 0;
+	}
+
+	for (int i = 0; i < StatusFrameDemand::kFrameCount; ++i) {
+		uint32_t reads = entry.motor->GetStatusFrameDemand().Take(i);
+		const Bounds & bounds = entry.bounds[i];
+
+		/* half the interval between reads, so each read sees a fresh frame */
+		int64_t desired = (reads == 0) ? bounds.maxPeriodMs : windowMs / (2 * (int64_t)reads);
+		if (desired < bounds.minPeriodMs)
+			desired = bounds.minPeriodMs;
+		if (desired > bounds.maxPeriodMs)
+			desired = bounds.maxPeriodMs;
+
+		int current = entry.periodMs[i];
+		if (current != 0) {
+			/* hysteresis, except to settle on a bound */
+			bool atBound = (desired == bounds.minPeriodMs || desired == bounds.maxPeriodMs);
+			if (desired == current)
+				continue;
+			if (!atBound && desired * 4 > current * 3 && desired * 4 < current * 5)
+				continue;
+		}
+		ErrorCode er = entry.motor->SetStatusFramePeriod(StatusFrameDemand::FrameAt(i), (uint8_t)desired, 0);
+		if (er == OK)
+			entry.periodMs[i] = (int)desired;
+	}
+}
+
+} // namespace motorcontrol
+} // namespace phoenix
+} // namespace ctre
@@ -0,0 +1,205 @@
+#include "ctre/phoenix/motorcontrol/StatusFrameSubscriber.h"
+#include "ctre/phoenix/motorcontrol/can/BaseMotorController.h"
+
+using namespace ctre::phoenix;
+using namespace ctre::phoenix::motorcontrol::can;
+
+namespace ctre {
+namespace phoenix {
+namespace motorcontrol {
+
+/* true if every signal of the frame matches, the read time is not compared */
+static bool SameSignals(const StatusFrameSample & a, const StatusFrameSample & b) {
+	return a.motorOutputPercent == b.motorOutputPercent &&
+			a.faults == b.faults &&
+			a.outputCurrent == b.outputCurrent &&
+			a.stickyFaults == b.stickyFaults &&
+			a.selectedSensorPosition == b.selectedSensorPosition &&
+			a.selectedSensorVelocity == b.selectedSensorVelocity &&
+			a.quadraturePosition == b.quadraturePosition &&
+			a.quadratureVelocity == b.quadratureVelocity &&
+			a.analogIn == b.analogIn &&
+			a.temperature == b.temperature &&
+			a.busVoltage == b.busVoltage &&
+			a.pulseWidthPosition == b.pulseWidthPosition &&
+			a.pulseWidthVelocity == b.pulseWidthVelocity &&
+			a.activeTrajectoryPosition == b.activeTrajectoryPosition &&
+			a.activeTrajectoryVelocity == b.activeTrajectoryVelocity &&
+			a.closedLoopError == b.closedLoopError &&
+			a.integralAccumulator == b.integralAccumulator &&
+			a.errorDerivative == b.errorDerivative;
+}
+
+StatusFrameSubscriber::StatusFrameSubscriber() :
+		_dropped(0), _running(false) {
+}
+StatusFrameSubscriber::~StatusFrameSubscriber() {
+	Stop();
+}
+ErrorCode StatusFrameSubscriber::Subscribe(BaseMotorController & motor,
+		StatusFrameEnhanced frame, Callback callback, int periodMs) {
+	if (!callback)
+		return InvalidParamValue;
+	return Add(motor, frame, callback, nullptr, periodMs);
+}
+ErrorCode StatusFrameSubscriber::Subscribe(BaseMotorController & motor,
+		StatusFrameEnhanced frame, Queue & queue, int periodMs) {
+	return Add(motor, frame, Callback(), &queue, periodMs);
+}
+ErrorCode StatusFrameSubscriber::Subscribe(BaseMotorController & motor,
+		StatusFrame frame, Callback callback, int periodMs) {
+	return Subscribe(motor, StatusFrameRoutines::Promote(frame), callback, periodMs);
+}
+ErrorCode StatusFrameSubscriber::Subscribe(BaseMotorController & motor,
+		StatusFrame frame, Queue & queue, int periodMs) {
+	return Subscribe(motor, StatusFrameRoutines::Promote(frame), queue, periodMs);
+}
+void StatusFrameSubscriber::Unsubscribe(BaseMotorController & motor,
+		StatusFrameEnhanced frame) {
+	std::unique_lock<std::mutex> lock(_lck);
+	for (auto it = _subscriptions.begin(); it != _subscriptions.end(); ++it) {
+		if ((*it)->motor == &motor && (*it)->frame == frame) {
+			SubscriptionPtr removed = *it;
+			_subscriptions.erase(it);
+			WaitForSample(lock, removed.get());
+			return;
+		}
+	}
+}
+void StatusFrameSubscriber::Unsubscribe(BaseMotorController & motor) {
+	std::unique_lock<std::mutex> lock(_lck);
+	std::vector<SubscriptionPtr> removed;
+	for (auto it = _subscriptions.begin(); it != _subscriptions.end();) {
+		if ((*it)->motor == &motor) {
+			removed.push_back(*it);
+			it = _subscriptions.erase(it);
+		} else {
+			++it;
+		}
+	}
+	for (const SubscriptionPtr & subscription : removed)
+		WaitForSample(lock, subscription.get());
+}
+ErrorCode StatusFrameSubscriber::Start() {
+	if (_running)
+		return InvalidParamValue;
+	_running = true;
+	_thread = std::thread(&StatusFrameSubscriber::Run, this);
+	return OK;
+}
+void StatusFrameSubscriber::Stop() {
+	{
+		std::lock_guard<std::mutex> lock(_lck);
+		_running = false;
+	}
+	_changed.notify_all();
+	if (_thread.joinable())
+		_thread.join();
+}
+ErrorCode StatusFrameSubscriber::Add(BaseMotorController & motor,
+		StatusFrameEnhanced frame, Callback callback, Queue * queue, int periodMs) {
+	if (periodMs < 0)
+		return InvalidParamValue;
+	if (periodMs == 0) {
+		/* blocking config read, done before taking the lock */
+		periodMs = motor.GetStatusFramePeriod(frame, kPeriodTimeoutMs);
+		if (periodMs <= 0)
+			return RxTimeout;
+	}
+
+	SubscriptionPtr subscription = std::make_shared<Subscription>();
+	subscription->motor = &motor;
+	subscription->frame = frame;
+	subscription->period = std::chrono::milliseconds(periodMs);
+	subscription->callback = callback;
+	subscription->queue = queue;
+	subscription->due = Clock::now() + subscription->period;
+	subscription->haveLast = false;
+	{
+		std::unique_lock<std::mutex> lock(_lck);
+		SubscriptionPtr replaced;
+		for (SubscriptionPtr & existing : _subscriptions) {
+			if (existing->motor == &motor && existing->frame == frame) {
+				replaced = existing;
+				existing = subscription;
+				break;
+			}
+		}
+		if (!replaced)
+			_subscriptions.push_back(subscription);
+		else
+			WaitForSample(lock, replaced.get());
+	}
+	_changed.notify_all();
+	return OK;
+}
+void StatusFrameSubscriber::WaitForSample(std::unique_lock<std::mutex> & lock, const Subscription * subscription) {
+	/* the caller may destroy the controller or queue once this returns */
+	_sampled.wait(lock, [this, subscription] {
+		for (const Subscription * sampling : _sampling) {
+			if (sampling == subscription)
+				return false;
+		}
+		return true;
+	});
+}
+void StatusFrameSubscriber::Sample(Subscription & subscription, Clock::time_point now) {
+	StatusFrameSample sample;
+	if (subscription.motor->GetStatusFrameSample(subscription.frame, sample) != OK)
+		return;
+	/* the same frame read again, unless it repeats long enough to be a new one */
+	if (subscription.haveLast && SameSignals(sample, subscription.last) &&
+			now - subscription.lastDelivered < 2 * subscription.period)
+		return;
+	subscription.last = sample;
+	subscription.haveLast = true;
+	subscription.lastDelivered = now;
+
+	if (subscription.queue) {
+		if (!subscription.queue->TryPush(sample))
+			++_dropped;
+	} else {
+		subscription.callback(sample);
+	}
+}
+void StatusFrameSubscriber::Run() {
+	std::vector<SubscriptionPtr> due;
+	std::unique_lock<std::mutex> lock(_lck);
+	while (_running) {
+		Clock::time_point now = Clock::now();
+
+		due.clear();
+		for (const SubscriptionPtr & subscription : _subscriptions) {
+			if (subscription->due <= now) {
+				due.push_back(subscription);
+				_sampling.push_back(subscription.get());
+			}
+		}
+		if (!due.empty()) {
+			/* read and deliver without the lock, the pointers keep the subscriptions alive */
+			lock.unlock();
+			for (const SubscriptionPtr & subscription : due) {
+				Sample(*subscription, now);
+				subscription->due += subscription->period;
+				/* fell a period or more behind, resync instead of bursting to catch up */
+				if (subscription->due <= now)
+					subscription->due = now + subscription->period;
+			}
+			lock.lock();
+			due.clear();
+			_sampling.clear();
+			_sampled.notify_all();
+		}
+
+		Clock::time_point next = now + std::chrono::milliseconds(100);
+		for (const SubscriptionPtr & subscription : _subscriptions) {
+			if (subscription->due < next)
+				next = subscription->due;
+		}
+		_changed.wait_until(lock, next);
+	}
+}
+
+} // namespace motorcontrol
+} // namespace phoenix
+} // namespace ctre
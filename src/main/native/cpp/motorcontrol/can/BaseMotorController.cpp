@@ -12,6 +12,18 @@ SlotConfiguration SlotConfigUtil::_default;
 CustomParamConfiguration CustomParamConfigUtil::_default;
 FilterConfiguration FilterConfigUtil::_default;
 
+/**
+ * Single parameter getter used by batched config readbacks.
+ */
+static ErrorCode GetParamForReadback(void * handle, ParamEnum param, int ordinal, double & value, int timeoutMs) {
+	return c_MotController_ConfigGetParameter(handle, param, &value, ordinal, timeoutMs);
+}
+static bool PollResetForShadow(void * handle) {
+	bool hasReset = false;
+	c_MotController_HasResetOccurred(handle, &hasReset);
+	return hasReset;
+}
+
 //--------------------- Constructors -----------------------------//
 /**
  *
@@ -31,6 +43,8 @@ void* BaseMotorController::GetHandle() {
 }
 
 BaseMotorController::~BaseMotorController() {
+	if (_transaction != nullptr)
+		_transaction->Remove(this);
     c_MotController_Destroy(m_handle);
 }
 
@@ -130,12 +144,57 @@ void BaseMotorController::Set(ControlMode mode, double demand0, double demand1)
  *		_talonRght.set(ControlMode::MotionMagic, targetDistance, DemandType_AuxPID, desiredRobotHeading);
  */
 void BaseMotorController::Set(ControlMode mode, double demand0, DemandType demand1Type, double demand1) {
-	m_controlMode = mode;
+	OutputTransaction * transaction = OutputTransaction::GetCurrent();
+	if (transaction != nullptr) {
+		/* stage it, the last demand before the commit wins */
+		_stagedMode = mode;
+		_stagedDemand0 = demand0;
+		_stagedDemand1Type = demand1Type;
+		_stagedDemand1 = demand1;
+		if (_transaction != transaction) {
+			if (_transaction != nullptr)
+				_transaction->Remove(this);
+			transaction->Add(this);
+			_transaction = transaction;
+		}
+		return;
+	}
+	SendDemand(mode, demand0, demand1Type, demand1);
+}
+/**
+ * Send the demand of a staged Set() when its OutputTransaction commits.
+ */
+void BaseMotorController::SendStagedDemand() {
+	SendDemand(_stagedMode, _stagedDemand0, _stagedDemand1Type, _stagedDemand1);
+}
+void BaseMotorController::SendDemand(ControlMode mode, double demand0, DemandType demand1Type, double demand1) {
+	if (_suppressSets) {
+		/* the clock is only read while suppressing, a stale send time just forwards the next repeat */
+		std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+		if (_lastSentValid &&
+				mode == _lastSentMode &&
+				demand0 == _lastSentDemand0 &&
+				demand1Type == _lastSentDemand1Type &&
+				demand1 == _lastSentDemand1 &&
+				now - _lastSentTime < std::chrono::milliseconds(_setKeepaliveMs)) {
+			++_setsSuppressed;
+			return;
+		}
+		_lastSentTime = now;
+	}
+	++_setsForwarded;
+	_lastSentValid = true;
+	_lastSentMode = mode;
+	_lastSentDemand0 = demand0;
+	_lastSentDemand1Type = demand1Type;
+	_lastSentDemand1 = demand1;
+
+	m_controlMode.store(mode, std::memory_order_relaxed);
 	m_sendMode = mode;
 	m_setPoint = demand0;
 
 	uint32_t work;
-	switch (m_controlMode) {
+	switch (mode) {
 	case ControlMode::PercentOutput:
 		//case ControlMode::TimedPercentOutput:
 		c_MotController_Set_4(m_handle, (int) m_sendMode, demand0, demand1, demand1Type);
@@ -180,6 +239,41 @@ void BaseMotorController::NeutralOutput() {
 	/* call the lowest level set, do not go through the vtable */
 	BaseMotorController::Set(ControlMode::Disabled, 0, DemandType::DemandType_Neutral, 0);
 }
+/**
+ * Skips Set() calls that repeat the last demand sent, avoiding the
+ * lower-level encode and dispatch.  The demand is still forwarded at
+ * least every keepaliveMs, and after anything that changes the control
+ * mode behind Set(), such as StartMotionProfile().
+ *
+ * @param enable
+ *            true to skip unchanged demands. Disabled by default.
+ * @param keepaliveMs
+ *            Longest time an unchanged demand is skipped for.
+ */
+void BaseMotorController::EnableSetSuppression(bool enable, int keepaliveMs) {
+	_suppressSets = enable;
+	_setKeepaliveMs = (keepaliveMs > 0) ? keepaliveMs : 0;
+	_lastSentValid = false;
+}
+/**
+ * @return Number of Set() calls forwarded to the lower level.
+ */
+uint32_t BaseMotorController::GetSetsForwarded() const {
+	return _setsForwarded;
+}
+/**
+ * @return Number of Set() calls skipped as unchanged.
+ */
+uint32_t BaseMotorController::GetSetsSuppressed() const {
+	return _setsSuppressed;
+}
+/**
+ * Zeroes the forwarded and suppressed Set() counters.
+ */
+void BaseMotorController::ClearSetCounters() {
+	_setsForwarded = 0;
+	_setsSuppressed = 0;
+}
 /**
  * Sets the mode of operation during neutral throttle output.
  *
@@ -288,7 +382,9 @@ bool BaseMotorController::GetInverted() const {
  * @return Error Code generated by function. 0 indicates no error.
  */
 ErrorCode BaseMotorController::ConfigFactoryDefault(int timeoutMs){
-	return c_MotController_ConfigFactoryDefault(m_handle, timeoutMs);
+	_configShadow.Invalidate();
+	DeviceStats::Call call(_stats, __func__, DeviceStats::Call_ConfigSet, timeoutMs);
+	return call.Done(c_MotController_ConfigFactoryDefault(m_handle, timeoutMs));
 }
 
 //----- general output shaping ------------------//
@@ -306,8 +402,11 @@ ErrorCode BaseMotorController::ConfigFactoryDefault(int timeoutMs){
  */
 ErrorCode BaseMotorController::ConfigOpenloopRamp(
 		double secondsFromNeutralToFull, int timeoutMs) {
-	return c_MotController_ConfigOpenLoopRamp(m_handle,
-			secondsFromNeutralToFull, timeoutMs);
+	if (Shadow().IsCurrent(eOpenloopRamp, 0, secondsFromNeutralToFull))
+		return OK;
+	DeviceStats::Call call(_stats, __func__, DeviceStats::Call_ConfigSet, timeoutMs);
+	return _configShadow.RecordWrite(call.Done(c_MotController_ConfigOpenLoopRamp(m_handle, secondsFromNeutralToFull, timeoutMs)),
+			eOpenloopRamp, 0, secondsFromNeutralToFull, timeoutMs);
 }
 
 /**
@@ -324,8 +423,11 @@ ErrorCode BaseMotorController::ConfigOpenloopRamp(
  */
 ErrorCode BaseMotorController::ConfigClosedloopRamp(
 		double secondsFromNeutralToFull, int timeoutMs) {
-	return c_MotController_ConfigClosedLoopRamp(m_handle,
-			secondsFromNeutralToFull, timeoutMs);
+	if (Shadow().IsCurrent(eClosedloopRamp, 0, secondsFromNeutralToFull))
+		return OK;
+	DeviceStats::Call call(_stats, __func__, DeviceStats::Call_ConfigSet, timeoutMs);
+	return _configShadow.RecordWrite(call.Done(c_MotController_ConfigClosedLoopRamp(m_handle, secondsFromNeutralToFull, timeoutMs)),
+			eClosedloopRamp, 0, secondsFromNeutralToFull, timeoutMs);
 }
 
 /**
@@ -341,8 +443,11 @@ ErrorCode BaseMotorController::ConfigClosedloopRamp(
  */
 ErrorCode BaseMotorController::ConfigPeakOutputForward(double percentOut,
 		int timeoutMs) {
-	return c_MotController_ConfigPeakOutputForward(m_handle, percentOut,
-			timeoutMs);
+	if (Shadow().IsCurrent(ePeakPosOutput, 0, percentOut))
+		return OK;
+	DeviceStats::Call call(_stats, __func__, DeviceStats::Call_ConfigSet, timeoutMs);
+	return _configShadow.RecordWrite(call.Done(c_MotController_ConfigPeakOutputForward(m_handle, percentOut, timeoutMs)),
+			ePeakPosOutput, 0, percentOut, timeoutMs);
 }
 
 /**
@@ -358,8 +463,11 @@ ErrorCode BaseMotorController::ConfigPeakOutputForward(double percentOut,
  */
 ErrorCode BaseMotorController::ConfigPeakOutputReverse(double percentOut,
 		int timeoutMs) {
-	return c_MotController_ConfigPeakOutputReverse(m_handle, percentOut,
-			timeoutMs);
+	if (Shadow().IsCurrent(ePeakNegOutput, 0, percentOut))
+		return OK;
+	DeviceStats::Call call(_stats, __func__, DeviceStats::Call_ConfigSet, timeoutMs);
+	return _configShadow.RecordWrite(call.Done(c_MotController_ConfigPeakOutputReverse(m_handle, percentOut, timeoutMs)),
+			ePeakNegOutput, 0, percentOut, timeoutMs);
 }
 /**
  * Configures the forward nominal output percentage.
@@ -374,8 +482,11 @@ ErrorCode BaseMotorController::ConfigPeakOutputReverse(double percentOut,
  */
 ErrorCode BaseMotorController::ConfigNominalOutputForward(double percentOut,
 		int timeoutMs) {
-	return c_MotController_ConfigNominalOutputForward(m_handle, percentOut,
-			timeoutMs);
+	if (Shadow().IsCurrent(eNominalPosOutput, 0, percentOut))
+		return OK;
+	DeviceStats::Call call(_stats, __func__, DeviceStats::Call_ConfigSet, timeoutMs);
+	return _configShadow.RecordWrite(call.Done(c_MotController_ConfigNominalOutputForward(m_handle, percentOut, timeoutMs)),
+			eNominalPosOutput, 0, percentOut, timeoutMs);
 }
 /**
  * Configures the reverse nominal output percentage.
@@ -390,8 +501,11 @@ ErrorCode BaseMotorController::ConfigNominalOutputForward(double percentOut,
  */
 ErrorCode BaseMotorController::ConfigNominalOutputReverse(double percentOut,
 		int timeoutMs) {
-	return c_MotController_ConfigNominalOutputReverse(m_handle, percentOut,
-			timeoutMs);
+	if (Shadow().IsCurrent(eNominalNegOutput, 0, percentOut))
+		return OK;
+	DeviceStats::Call call(_stats, __func__, DeviceStats::Call_ConfigSet, timeoutMs);
+	return _configShadow.RecordWrite(call.Done(c_MotController_ConfigNominalOutputReverse(m_handle, percentOut, timeoutMs)),
+			eNominalNegOutput, 0, percentOut, timeoutMs);
 }
 /**
  * Configures the output deadband percentage.
@@ -407,8 +521,11 @@ ErrorCode BaseMotorController::ConfigNominalOutputReverse(double percentOut,
  */
 ErrorCode BaseMotorController::ConfigNeutralDeadband(double percentDeadband,
 		int timeoutMs) {
-	return c_MotController_ConfigNeutralDeadband(m_handle, percentDeadband,
-			timeoutMs);
+	if (Shadow().IsCurrent(eNeutralDeadband, 0, percentDeadband))
+		return OK;
+	DeviceStats::Call call(_stats, __func__, DeviceStats::Call_ConfigSet, timeoutMs);
+	return _configShadow.RecordWrite(call.Done(c_MotController_ConfigNeutralDeadband(m_handle, percentDeadband, timeoutMs)),
+			eNeutralDeadband, 0, percentDeadband, timeoutMs);
 }
 
 //------ Voltage Compensation ----------//
@@ -428,8 +545,11 @@ ErrorCode BaseMotorController::ConfigNeutralDeadband(double percentDeadband,
  */
 ErrorCode BaseMotorController::ConfigVoltageCompSaturation(double voltage,
 		int timeoutMs) {
-	return c_MotController_ConfigVoltageCompSaturation(m_handle, voltage,
-			timeoutMs);
+	if (Shadow().IsCurrent(eNominalBatteryVoltage, 0, voltage))
+		return OK;
+	DeviceStats::Call call(_stats, __func__, DeviceStats::Call_ConfigSet, timeoutMs);
+	return _configShadow.RecordWrite(call.Done(c_MotController_ConfigVoltageCompSaturation(m_handle, voltage, timeoutMs)),
+			eNominalBatteryVoltage, 0, voltage, timeoutMs);
 }
 
 /**
@@ -446,8 +566,11 @@ ErrorCode BaseMotorController::ConfigVoltageCompSaturation(double voltage,
  */
 ErrorCode BaseMotorController::ConfigVoltageMeasurementFilter(
 		int filterWindowSamples, int timeoutMs) {
-	return c_MotController_ConfigVoltageMeasurementFilter(m_handle,
-			filterWindowSamples, timeoutMs);
+	if (Shadow().IsCurrent(eBatteryVoltageFilterSize, 0, filterWindowSamples))
+		return OK;
+	DeviceStats::Call call(_stats, __func__, DeviceStats::Call_ConfigSet, timeoutMs);
+	return _configShadow.RecordWrite(call.Done(c_MotController_ConfigVoltageMeasurementFilter(m_handle, filterWindowSamples, timeoutMs)),
+			eBatteryVoltageFilterSize, 0, filterWindowSamples, timeoutMs);
 }
 
 /**
@@ -470,10 +593,24 @@ void BaseMotorController::EnableVoltageCompensation(bool enable) {
  * @return The bus voltage value (in volts).
  */
 double BaseMotorController::GetBusVoltage() {
+	_frameDemand.Note(StatusFrameEnhanced::Status_4_AinTempVbat);
 	double param = 0;
 	c_MotController_GetBusVoltage(m_handle, &param);
 	return param;
 }
+/**
+ * Gets the bus voltage (in volts) with the time of the read, see Timestamped.
+ *
+ * @param busVoltage Caller's value to update.
+ * @return Error Code of the read. 0 indicates the value is fresh.
+ */
+ErrorCode BaseMotorController::GetBusVoltage(Timestamped<double> & busVoltage) {
+	_frameDemand.Note(StatusFrameEnhanced::Status_4_AinTempVbat);
+	double param = 0;
+	ErrorCode retval = (ErrorCode)c_MotController_GetBusVoltage(m_handle, &param);
+	busVoltage.Update(param, retval, GetMonotonicUs());
+	return retval;
+}
 
 /**
  * Gets the output percentage of the motor controller.
@@ -481,10 +618,24 @@ double BaseMotorController::GetBusVoltage() {
  * @return Output of the motor controller (in percent).  [-1,+1]
  */
 double BaseMotorController::GetMotorOutputPercent() {
+	_frameDemand.Note(StatusFrameEnhanced::Status_1_General);
 	double param = 0;
 	c_MotController_GetMotorOutputPercent(m_handle, &param);
 	return param;
 }
+/**
+ * Gets the motor output [-1,+1] with the time of the read, see Timestamped.
+ *
+ * @param motorOutputPercent Caller's value to update.
+ * @return Error Code of the read. 0 indicates the value is fresh.
+ */
+ErrorCode BaseMotorController::GetMotorOutputPercent(Timestamped<double> & motorOutputPercent) {
+	_frameDemand.Note(StatusFrameEnhanced::Status_1_General);
+	double param = 0;
+	ErrorCode retval = (ErrorCode)c_MotController_GetMotorOutputPercent(m_handle, &param);
+	motorOutputPercent.Update(param, retval, GetMonotonicUs());
+	return retval;
+}
 
 /**
  * @return applied voltage to motor in volts.
@@ -499,20 +650,124 @@ double BaseMotorController::GetMotorOutputVoltage() {
  * @return The output current (in amps).
  */
 double BaseMotorController::GetOutputCurrent() {
+	_frameDemand.Note(StatusFrameEnhanced::Status_2_Feedback0);
 	double param = 0;
 	c_MotController_GetOutputCurrent(m_handle, &param);
 	return param;
 }
+/**
+ * Gets the output current (in amps) with the time of the read, see Timestamped.
+ *
+ * @param outputCurrent Caller's value to update.
+ * @return Error Code of the read. 0 indicates the value is fresh.
+ */
+ErrorCode BaseMotorController::GetOutputCurrent(Timestamped<double> & outputCurrent) {
+	_frameDemand.Note(StatusFrameEnhanced::Status_2_Feedback0);
+	double param = 0;
+	ErrorCode retval = (ErrorCode)c_MotController_GetOutputCurrent(m_handle, &param);
+	outputCurrent.Update(param, retval, GetMonotonicUs());
+	return retval;
+}
 /**
  * Gets the temperature of the motor controller.
  *
  * @return Temperature of the motor controller (in 'C)
  */
 double BaseMotorController::GetTemperature() {
+	_frameDemand.Note(StatusFrameEnhanced::Status_4_AinTempVbat);
 	double param = 0;
 	c_MotController_GetTemperature(m_handle, &param);
 	return param;
 }
+/**
+ * Gets the temperature (in 'C) with the time of the read, see Timestamped.
+ *
+ * @param temperature Caller's value to update.
+ * @return Error Code of the read. 0 indicates the value is fresh.
+ */
+ErrorCode BaseMotorController::GetTemperature(Timestamped<double> & temperature) {
+	_frameDemand.Note(StatusFrameEnhanced::Status_4_AinTempVbat);
+	double param = 0;
+	ErrorCode retval = (ErrorCode)c_MotController_GetTemperature(m_handle, &param);
+	temperature.Update(param, retval, GetMonotonicUs());
+	return retval;
+}
+
+/**
+ * Reads position, velocity, current, bus voltage, temperature, output,
+ * closed-loop error and faults in one call, and publishes them as the
+ * latest snapshot for GetLastTelemetry().
+ *
+ * @param snapshot
+ *            Caller's snapshot to fill.
+ * @return First error reading the signals. 0 indicates every signal is fresh.
+ */
+ErrorCode BaseMotorController::GetTelemetry(MotorTelemetrySnapshot & snapshot) {
+	_frameDemand.Note(StatusFrameEnhanced::Status_1_General);
+	_frameDemand.Note(StatusFrameEnhanced::Status_2_Feedback0);
+	_frameDemand.Note(StatusFrameEnhanced::Status_4_AinTempVbat);
+	_frameDemand.Note(StatusFrameEnhanced::Status_13_Base_PIDF0);
+	void * handle = m_handle;
+	_telemetry.Modify([handle, &snapshot](MotorTelemetrySnapshot & latest) {
+		int64_t nowUs = GetMonotonicUs();
+		ErrorCollection errorCollection;
+		ErrorCode er;
+		int intValue = 0;
+		double doubleValue = 0;
+
+		er = c_MotController_GetSelectedSensorPosition(handle, &intValue, 0);
+		latest.selectedSensorPosition.Update(intValue, er, nowUs);
+		errorCollection.NewError(er);
+
+		er = c_MotController_GetSelectedSensorVelocity(handle, &intValue, 0);
+		latest.selectedSensorVelocity.Update(intValue, er, nowUs);
+		errorCollection.NewError(er);
+
+		er = c_MotController_GetOutputCurrent(handle, &doubleValue);
+		latest.outputCurrent.Update(doubleValue, er, nowUs);
+		errorCollection.NewError(er);
+
+		er = c_MotController_GetBusVoltage(handle, &doubleValue);
+		latest.busVoltage.Update(doubleValue, er, nowUs);
+		errorCollection.NewError(er);
+
+		er = c_MotController_GetTemperature(handle, &doubleValue);
+		latest.temperature.Update(doubleValue, er, nowUs);
+		errorCollection.NewError(er);
+
+		er = c_MotController_GetMotorOutputPercent(handle, &doubleValue);
+		latest.motorOutputPercent.Update(doubleValue, er, nowUs);
+		errorCollection.NewError(er);
+
+		er = c_MotController_GetClosedLoopError(handle, &intValue, 0);
+		latest.closedLoopError.Update(intValue, er, nowUs);
+		errorCollection.NewError(er);
+
+		er = c_MotController_GetFaults(handle, &intValue);
+		latest.faults.Update(intValue, er, nowUs);
+		errorCollection.NewError(er);
+
+		er = c_MotController_GetStickyFaults(handle, &intValue);
+		latest.stickyFaults.Update(intValue, er, nowUs);
+		errorCollection.NewError(er);
+
+		latest.snapshotUs = nowUs;
+		latest.error = errorCollection._worstError;
+		snapshot = latest;
+	});
+	return snapshot.error;
+}
+/**
+ * Copies the snapshot last taken by GetTelemetry() without any reads.
+ * Lock-free and consistent, so another thread (such as a logger) can
+ * read while GetTelemetry() runs.
+ *
+ * @param snapshot
+ *            Caller's snapshot to fill.
+ */
+void BaseMotorController::GetLastTelemetry(MotorTelemetrySnapshot & snapshot) const {
+	_telemetry.Read(snapshot);
+}
 
 //------ sensor selection ----------//
 /**
@@ -531,8 +786,11 @@ double BaseMotorController::GetTemperature() {
  */
 ErrorCode BaseMotorController::ConfigSelectedFeedbackSensor(
 		RemoteFeedbackDevice feedbackDevice, int pidIdx, int timeoutMs) {
-	return c_MotController_ConfigSelectedFeedbackSensor(m_handle,
-			feedbackDevice, pidIdx, timeoutMs);
+	if (Shadow().IsCurrent(eFeedbackSensorType, pidIdx, feedbackDevice))
+		return OK;
+	DeviceStats::Call call(_stats, __func__, DeviceStats::Call_ConfigSet, timeoutMs);
+	return _configShadow.RecordWrite(call.Done(c_MotController_ConfigSelectedFeedbackSensor(m_handle, feedbackDevice, pidIdx, timeoutMs)),
+			eFeedbackSensorType, pidIdx, feedbackDevice, timeoutMs);
 }
 /**
  * Select the feedback device for the motor controller.
@@ -549,8 +807,11 @@ ErrorCode BaseMotorController::ConfigSelectedFeedbackSensor(
  */
 ErrorCode BaseMotorController::ConfigSelectedFeedbackSensor(
 		FeedbackDevice feedbackDevice, int pidIdx, int timeoutMs) {
-	return c_MotController_ConfigSelectedFeedbackSensor(m_handle,
-			feedbackDevice, pidIdx, timeoutMs);
+	if (Shadow().IsCurrent(eFeedbackSensorType, pidIdx, feedbackDevice))
+		return OK;
+	DeviceStats::Call call(_stats, __func__, DeviceStats::Call_ConfigSet, timeoutMs);
+	return _configShadow.RecordWrite(call.Done(c_MotController_ConfigSelectedFeedbackSensor(m_handle, feedbackDevice, pidIdx, timeoutMs)),
+			eFeedbackSensorType, pidIdx, feedbackDevice, timeoutMs);
 }
 
 /**
@@ -574,8 +835,11 @@ ErrorCode BaseMotorController::ConfigSelectedFeedbackSensor(
  */
 ErrorCode BaseMotorController::ConfigSelectedFeedbackCoefficient(
 		double coefficient, int pidIdx, int timeoutMs) {
-	return c_MotController_ConfigSelectedFeedbackCoefficient(m_handle,
-			coefficient, pidIdx, timeoutMs);
+	if (Shadow().IsCurrent(eSelectedSensorCoefficient, pidIdx, coefficient))
+		return OK;
+	DeviceStats::Call call(_stats, __func__, DeviceStats::Call_ConfigSet, timeoutMs);
+	return _configShadow.RecordWrite(call.Done(c_MotController_ConfigSelectedFeedbackCoefficient(m_handle, coefficient, pidIdx, timeoutMs)),
+			eSelectedSensorCoefficient, pidIdx, coefficient, timeoutMs);
 }
 
 /**
@@ -599,8 +863,16 @@ ErrorCode BaseMotorController::ConfigSelectedFeedbackCoefficient(
 ErrorCode BaseMotorController::ConfigRemoteFeedbackFilter(int deviceID,
 		RemoteSensorSource remoteSensorSource, int remoteOrdinal,
 		int timeoutMs) {
-	return c_MotController_ConfigRemoteFeedbackFilter(m_handle, deviceID,
-			(int) remoteSensorSource, remoteOrdinal, timeoutMs);
+	ConfigShadow & shadow = Shadow();
+	if (shadow.IsCurrent(eRemoteSensorDeviceID, remoteOrdinal, deviceID) &&
+			shadow.IsCurrent(eRemoteSensorSource, remoteOrdinal, (int) remoteSensorSource))
+		return OK;
+	DeviceStats::Call call(_stats, __func__, DeviceStats::Call_ConfigSet, timeoutMs);
+	ErrorCode retval = call.Done(c_MotController_ConfigRemoteFeedbackFilter(m_handle, deviceID,
+			(int) remoteSensorSource, remoteOrdinal, timeoutMs));
+	shadow.RecordWrite(retval, eRemoteSensorDeviceID, remoteOrdinal, deviceID, timeoutMs);
+	shadow.RecordWrite(retval, eRemoteSensorSource, remoteOrdinal, (int) remoteSensorSource, timeoutMs);
+	return retval;
 }
 /**
  * Select what sensor term should be bound to switch feedback device.
@@ -619,8 +891,11 @@ ErrorCode BaseMotorController::ConfigRemoteFeedbackFilter(int deviceID,
  */
 ErrorCode BaseMotorController::ConfigSensorTerm(SensorTerm sensorTerm,
 		FeedbackDevice feedbackDevice, int timeoutMs) {
-	return c_MotController_ConfigSensorTerm(m_handle, (int) sensorTerm,
-			(int) feedbackDevice, timeoutMs);
+	if (Shadow().IsCurrent(eSensorTerm, (int) sensorTerm, feedbackDevice))
+		return OK;
+	DeviceStats::Call call(_stats, __func__, DeviceStats::Call_ConfigSet, timeoutMs);
+	return _configShadow.RecordWrite(call.Done(c_MotController_ConfigSensorTerm(m_handle, (int) sensorTerm, (int) feedbackDevice, timeoutMs)),
+			eSensorTerm, (int) sensorTerm, feedbackDevice, timeoutMs);
 }
 
 ErrorCode BaseMotorController::ConfigSensorTerm(SensorTerm sensorTerm,
@@ -638,10 +913,26 @@ ErrorCode BaseMotorController::ConfigSensorTerm(SensorTerm sensorTerm,
  * @return Position of selected sensor (in raw sensor units).
  */
 int BaseMotorController::GetSelectedSensorPosition(int pidIdx) {
+	_frameDemand.Note(StatusFrameDemand::FeedbackFrame(pidIdx));
 	int retval;
 	c_MotController_GetSelectedSensorPosition(m_handle, &retval, pidIdx);
 	return retval;
 }
+/**
+ * Gets the selected sensor position (in raw sensor units) with the time of the read, see Timestamped.
+ *
+ * @param position Caller's value to update.
+ * @param pidIdx
+ *            0 for Primary closed-loop. 1 for auxiliary closed-loop.
+ * @return Error Code of the read. 0 indicates the value is fresh.
+ */
+ErrorCode BaseMotorController::GetSelectedSensorPosition(Timestamped<int> & position, int pidIdx) {
+	_frameDemand.Note(StatusFrameDemand::FeedbackFrame(pidIdx));
+	int param = 0;
+	ErrorCode retval = (ErrorCode)c_MotController_GetSelectedSensorPosition(m_handle, &param, pidIdx);
+	position.Update(param, retval, GetMonotonicUs());
+	return retval;
+}
 /**
  * Get the selected sensor velocity.
  *
@@ -651,10 +942,26 @@ int BaseMotorController::GetSelectedSensorPosition(int pidIdx) {
  * See Phoenix-Documentation for how to interpret.
  */
 int BaseMotorController::GetSelectedSensorVelocity(int pidIdx) {
+	_frameDemand.Note(StatusFrameDemand::FeedbackFrame(pidIdx));
 	int retval;
 	c_MotController_GetSelectedSensorVelocity(m_handle, &retval, pidIdx);
 	return retval;
 }
+/**
+ * Gets the selected sensor velocity (in raw sensor units per 100ms) with the time of the read, see Timestamped.
+ *
+ * @param velocity Caller's value to update.
+ * @param pidIdx
+ *            0 for Primary closed-loop. 1 for auxiliary closed-loop.
+ * @return Error Code of the read. 0 indicates the value is fresh.
+ */
+ErrorCode BaseMotorController::GetSelectedSensorVelocity(Timestamped<int> & velocity, int pidIdx) {
+	_frameDemand.Note(StatusFrameDemand::FeedbackFrame(pidIdx));
+	int param = 0;
+	ErrorCode retval = (ErrorCode)c_MotController_GetSelectedSensorVelocity(m_handle, &param, pidIdx);
+	velocity.Update(param, retval, GetMonotonicUs());
+	return retval;
+}
 /**
  * Sets the sensor position to the given value.
  *
@@ -670,8 +977,8 @@ int BaseMotorController::GetSelectedSensorVelocity(int pidIdx) {
  */
 ErrorCode BaseMotorController::SetSelectedSensorPosition(int sensorPos,
 		int pidIdx, int timeoutMs) {
-	return c_MotController_SetSelectedSensorPosition(m_handle, sensorPos,
-			pidIdx, timeoutMs);
+	return _stats.Record(c_MotController_SetSelectedSensorPosition(m_handle, sensorPos,
+			pidIdx, timeoutMs), __func__, DeviceStats::Call_General, timeoutMs);
 }
 
 //------ status frame period changes ----------//
@@ -686,7 +993,7 @@ ErrorCode BaseMotorController::SetSelectedSensorPosition(int sensorPos,
  */
 ErrorCode BaseMotorController::SetControlFramePeriod(ControlFrame frame,
 		int periodMs) {
-	return c_MotController_SetControlFramePeriod(m_handle, frame, periodMs);
+	return _stats.Record(c_MotController_SetControlFramePeriod(m_handle, frame, periodMs), __func__);
 }
 /**
  * Sets the period of the given status frame.
@@ -709,8 +1016,8 @@ ErrorCode BaseMotorController::SetControlFramePeriod(ControlFrame frame,
  */
 ErrorCode BaseMotorController::SetStatusFramePeriod(StatusFrame frame,
 		uint8_t periodMs, int timeoutMs) {
-	return c_MotController_SetStatusFramePeriod(m_handle, frame, periodMs,
-			timeoutMs);
+	return _stats.Record(c_MotController_SetStatusFramePeriod(m_handle, frame, periodMs,
+			timeoutMs), __func__, DeviceStats::Call_General, timeoutMs);
 }
 /**
  * Sets the period of the given status frame.
@@ -733,8 +1040,8 @@ ErrorCode BaseMotorController::SetStatusFramePeriod(StatusFrame frame,
  */
 ErrorCode BaseMotorController::SetStatusFramePeriod(StatusFrameEnhanced frame,
 		uint8_t periodMs, int timeoutMs) {
-	return c_MotController_SetStatusFramePeriod(m_handle, frame, periodMs,
-			timeoutMs);
+	return _stats.Record(c_MotController_SetStatusFramePeriod(m_handle, frame, periodMs,
+			timeoutMs), __func__, DeviceStats::Call_General, timeoutMs);
 }
 /**
  * Gets the period of the given status frame.
@@ -772,6 +1079,71 @@ int BaseMotorController::GetStatusFramePeriod(StatusFrameEnhanced frame,
 	return periodMs;
 }
 
+/**
+ * Reads the signals carried by a status frame in one call.
+ *
+ * @param frame
+ *            Frame to decode.
+ * @param sample
+ *            Caller's sample to fill.
+ * @return Error Code of the reads. 0 indicates every signal is fresh.
+ */
+ErrorCode BaseMotorController::GetStatusFrameSample(StatusFrameEnhanced frame,
+		StatusFrameSample & sample) {
+	_frameDemand.Note(frame);
+	sample = StatusFrameSample();
+	sample.frame = frame;
+	sample.timestampUs = GetMonotonicUs();
+
+	ErrorCollection errorCollection;
+	switch (frame) {
+	case StatusFrameEnhanced::Status_1_General:
+		errorCollection.NewError(c_MotController_GetMotorOutputPercent(m_handle, &sample.motorOutputPercent));
+		errorCollection.NewError(c_MotController_GetFaults(m_handle, &sample.faults));
+		break;
+	case StatusFrameEnhanced::Status_2_Feedback0:
+		errorCollection.NewError(c_MotController_GetSelectedSensorPosition(m_handle, &sample.selectedSensorPosition, 0));
+		errorCollection.NewError(c_MotController_GetSelectedSensorVelocity(m_handle, &sample.selectedSensorVelocity, 0));
+		errorCollection.NewError(c_MotController_GetOutputCurrent(m_handle, &sample.outputCurrent));
+		errorCollection.NewError(c_MotController_GetStickyFaults(m_handle, &sample.stickyFaults));
+		break;
+	case StatusFrameEnhanced::Status_3_Quadrature:
+		errorCollection.NewError(c_MotController_GetQuadraturePosition(m_handle, &sample.quadraturePosition));
+		errorCollection.NewError(c_MotController_GetQuadratureVelocity(m_handle, &sample.quadratureVelocity));
+		break;
+	case StatusFrameEnhanced::Status_4_AinTempVbat:
+		errorCollection.NewError(c_MotController_GetAnalogIn(m_handle, &sample.analogIn));
+		errorCollection.NewError(c_MotController_GetTemperature(m_handle, &sample.temperature));
+		errorCollection.NewError(c_MotController_GetBusVoltage(m_handle, &sample.busVoltage));
+		break;
+	case StatusFrameEnhanced::Status_8_PulseWidth:
+		errorCollection.NewError(c_MotController_GetPulseWidthPosition(m_handle, &sample.pulseWidthPosition));
+		errorCollection.NewError(c_MotController_GetPulseWidthVelocity(m_handle, &sample.pulseWidthVelocity));
+		break;
+	case StatusFrameEnhanced::Status_10_Targets:
+		errorCollection.NewError(c_MotController_GetActiveTrajectoryPosition_3(m_handle, &sample.activeTrajectoryPosition, 0));
+		errorCollection.NewError(c_MotController_GetActiveTrajectoryVelocity_3(m_handle, &sample.activeTrajectoryVelocity, 0));
+		break;
+	case StatusFrameEnhanced::Status_12_Feedback1:
+		errorCollection.NewError(c_MotController_GetSelectedSensorPosition(m_handle, &sample.selectedSensorPosition, 1));
+		errorCollection.NewError(c_MotController_GetSelectedSensorVelocity(m_handle, &sample.selectedSensorVelocity, 1));
+		break;
+	case StatusFrameEnhanced::Status_13_Base_PIDF0:
+	case StatusFrameEnhanced::Status_14_Turn_PIDF1: {
+		int pidIdx = (frame == StatusFrameEnhanced::Status_13_Base_PIDF0) ? 0 : 1;
+		errorCollection.NewError(c_MotController_GetClosedLoopError(m_handle, &sample.closedLoopError, pidIdx));
+		errorCollection.NewError(c_MotController_GetIntegralAccumulator(m_handle, &sample.integralAccumulator, pidIdx));
+		errorCollection.NewError(c_MotController_GetErrorDerivative(m_handle, &sample.errorDerivative, pidIdx));
+		break;
+	}
+	default:
+		errorCollection.NewError(InvalidParamValue);
+		break;
+	}
+	sample.error = errorCollection._worstError;
+	return sample.error;
+}
+
 //----- velocity signal conditioning ------//
 
 /**
@@ -791,8 +1163,11 @@ int BaseMotorController::GetStatusFramePeriod(StatusFrameEnhanced frame,
  */
 ErrorCode BaseMotorController::ConfigVelocityMeasurementPeriod(
 		VelocityMeasPeriod period, int timeoutMs) {
-	return c_MotController_ConfigVelocityMeasurementPeriod(m_handle, period,
-			timeoutMs);
+	if (Shadow().IsCurrent(eSampleVelocityPeriod, 0, period))
+		return OK;
+	DeviceStats::Call call(_stats, __func__, DeviceStats::Call_ConfigSet, timeoutMs);
+	return _configShadow.RecordWrite(call.Done(c_MotController_ConfigVelocityMeasurementPeriod(m_handle, period, timeoutMs)),
+			eSampleVelocityPeriod, 0, period, timeoutMs);
 }
 /**
  * Sets the number of velocity samples used in the rolling average velocity
@@ -810,8 +1185,11 @@ ErrorCode BaseMotorController::ConfigVelocityMeasurementPeriod(
  */
 ErrorCode BaseMotorController::ConfigVelocityMeasurementWindow(int windowSize,
 		int timeoutMs) {
-	return c_MotController_ConfigVelocityMeasurementWindow(m_handle, windowSize,
-			timeoutMs);
+	if (Shadow().IsCurrent(eSampleVelocityWindow, 0, windowSize))
+		return OK;
+	DeviceStats::Call call(_stats, __func__, DeviceStats::Call_ConfigSet, timeoutMs);
+	return _configShadow.RecordWrite(call.Done(c_MotController_ConfigVelocityMeasurementWindow(m_handle, windowSize, timeoutMs)),
+			eSampleVelocityWindow, 0, windowSize, timeoutMs);
 }
 
 //------ remote limit switch ----------//
@@ -838,8 +1216,7 @@ ErrorCode BaseMotorController::ConfigForwardLimitSwitchSource(
 		RemoteLimitSwitchSource type, LimitSwitchNormal normalOpenOrClose,
 		int deviceID, int timeoutMs) {
 	LimitSwitchSource cciType = LimitSwitchRoutines::Promote(type);
-	return c_MotController_ConfigForwardLimitSwitchSource(m_handle, cciType,
-			normalOpenOrClose, deviceID, timeoutMs);
+	return ConfigLimitSwitchSourceShadowed(0, cciType, normalOpenOrClose, deviceID, timeoutMs);
 }
 /**
  * Configures the reverse limit switch for a remote source.
@@ -864,8 +1241,39 @@ ErrorCode BaseMotorController::ConfigReverseLimitSwitchSource(
 		RemoteLimitSwitchSource type, LimitSwitchNormal normalOpenOrClose,
 		int deviceID, int timeoutMs) {
 	LimitSwitchSource cciType = LimitSwitchRoutines::Promote(type);
-	return c_MotController_ConfigReverseLimitSwitchSource(m_handle, cciType,
-			normalOpenOrClose, deviceID, timeoutMs);
+	return ConfigLimitSwitchSourceShadowed(1, cciType, normalOpenOrClose, deviceID, timeoutMs);
+}
+/**
+ * Configures a limit switch source through the config shadow.
+ * A local source (deviceID of -1) leaves the remote device ID unshadowed.
+ */
+ErrorCode BaseMotorController::ConfigLimitSwitchSourceShadowed(int ordinal,
+		LimitSwitchSource type, LimitSwitchNormal normalOpenOrClose,
+		int deviceID, int timeoutMs) {
+	ConfigShadow & shadow = Shadow();
+	/* the device ID sent for a local source is not a value the device reports back */
+	bool remote = (deviceID >= 0);
+	if (shadow.IsCurrent(eLimitSwitchSource, ordinal, type) &&
+			shadow.IsCurrent(eLimitSwitchNormClosedAndDis, ordinal, normalOpenOrClose) &&
+			(!remote || shadow.IsCurrent(eLimitSwitchRemoteDevID, ordinal, deviceID)))
+		return OK;
+	ErrorCode retval;
+	if (ordinal == 0) {
+		DeviceStats::Call call(_stats, "ConfigForwardLimitSwitchSource", DeviceStats::Call_ConfigSet, timeoutMs);
+		retval = call.Done(c_MotController_ConfigForwardLimitSwitchSource(m_handle, type,
+				normalOpenOrClose, deviceID, timeoutMs));
+	} else {
+		DeviceStats::Call call(_stats, "ConfigReverseLimitSwitchSource", DeviceStats::Call_ConfigSet, timeoutMs);
+		retval = call.Done(c_MotController_ConfigReverseLimitSwitchSource(m_handle, type,
+				normalOpenOrClose, deviceID, timeoutMs));
+	}
+	shadow.RecordWrite(retval, eLimitSwitchSource, ordinal, type, timeoutMs);
+	shadow.RecordWrite(retval, eLimitSwitchNormClosedAndDis, ordinal, normalOpenOrClose, timeoutMs);
+	if (remote)
+		shadow.RecordWrite(retval, eLimitSwitchRemoteDevID, ordinal, deviceID, timeoutMs);
+	else
+		shadow.Invalidate(eLimitSwitchRemoteDevID, ordinal);
+	return retval;
 }
 /**
  * Sets the enable state for limit switches.
@@ -910,8 +1318,7 @@ void BaseMotorController::OverrideLimitSwitchesEnable(bool enable) {
 ErrorCode BaseMotorController::ConfigForwardLimitSwitchSource(
 		LimitSwitchSource type, LimitSwitchNormal normalOpenOrClose,
 		int timeoutMs) {
-	return c_MotController_ConfigForwardLimitSwitchSource(m_handle, type,
-			normalOpenOrClose, -1, timeoutMs);
+	return ConfigLimitSwitchSourceShadowed(0, type, normalOpenOrClose, -1, timeoutMs);
 }
 /**
  * Configures a limit switch for a local/remote source.
@@ -937,8 +1344,7 @@ ErrorCode BaseMotorController::ConfigForwardLimitSwitchSource(
 ErrorCode BaseMotorController::ConfigReverseLimitSwitchSource(
 		LimitSwitchSource type, LimitSwitchNormal normalOpenOrClose,
 		int timeoutMs) {
-	return c_MotController_ConfigReverseLimitSwitchSource(m_handle, type,
-			normalOpenOrClose, -1, timeoutMs);
+	return ConfigLimitSwitchSourceShadowed(1, type, normalOpenOrClose, -1, timeoutMs);
 }
 
 //------ soft limit ----------//
@@ -955,8 +1361,11 @@ ErrorCode BaseMotorController::ConfigReverseLimitSwitchSource(
  */
 ErrorCode BaseMotorController::ConfigForwardSoftLimitThreshold(int forwardSensorLimit,
 		int timeoutMs) {
-	return c_MotController_ConfigForwardSoftLimitThreshold(m_handle, forwardSensorLimit,
-			timeoutMs);
+	if (Shadow().IsCurrent(eForwardSoftLimitThreshold, 0, forwardSensorLimit))
+		return OK;
+	DeviceStats::Call call(_stats, __func__, DeviceStats::Call_ConfigSet, timeoutMs);
+	return _configShadow.RecordWrite(call.Done(c_MotController_ConfigForwardSoftLimitThreshold(m_handle, forwardSensorLimit, timeoutMs)),
+			eForwardSoftLimitThreshold, 0, forwardSensorLimit, timeoutMs);
 }
 
 /**
@@ -972,8 +1381,11 @@ ErrorCode BaseMotorController::ConfigForwardSoftLimitThreshold(int forwardSensor
  */
 ErrorCode BaseMotorController::ConfigReverseSoftLimitThreshold(int reverseSensorLimit,
 		int timeoutMs) {
-	return c_MotController_ConfigReverseSoftLimitThreshold(m_handle, reverseSensorLimit,
-			timeoutMs);
+	if (Shadow().IsCurrent(eReverseSoftLimitThreshold, 0, reverseSensorLimit))
+		return OK;
+	DeviceStats::Call call(_stats, __func__, DeviceStats::Call_ConfigSet, timeoutMs);
+	return _configShadow.RecordWrite(call.Done(c_MotController_ConfigReverseSoftLimitThreshold(m_handle, reverseSensorLimit, timeoutMs)),
+			eReverseSoftLimitThreshold, 0, reverseSensorLimit, timeoutMs);
 }
 
 /**
@@ -989,8 +1401,11 @@ ErrorCode BaseMotorController::ConfigReverseSoftLimitThreshold(int reverseSensor
  */
 ErrorCode BaseMotorController::ConfigForwardSoftLimitEnable(bool enable,
 		int timeoutMs) {
-	return c_MotController_ConfigForwardSoftLimitEnable(m_handle, enable,
-			timeoutMs);
+	if (Shadow().IsCurrent(eForwardSoftLimitEnable, 0, enable))
+		return OK;
+	DeviceStats::Call call(_stats, __func__, DeviceStats::Call_ConfigSet, timeoutMs);
+	return _configShadow.RecordWrite(call.Done(c_MotController_ConfigForwardSoftLimitEnable(m_handle, enable, timeoutMs)),
+			eForwardSoftLimitEnable, 0, enable, timeoutMs);
 }
 
 
@@ -1007,8 +1422,11 @@ ErrorCode BaseMotorController::ConfigForwardSoftLimitEnable(bool enable,
  */
 ErrorCode BaseMotorController::ConfigReverseSoftLimitEnable(bool enable,
 		int timeoutMs) {
-	return c_MotController_ConfigReverseSoftLimitEnable(m_handle, enable,
-			timeoutMs);
+	if (Shadow().IsCurrent(eReverseSoftLimitEnable, 0, enable))
+		return OK;
+	DeviceStats::Call call(_stats, __func__, DeviceStats::Call_ConfigSet, timeoutMs);
+	return _configShadow.RecordWrite(call.Done(c_MotController_ConfigReverseSoftLimitEnable(m_handle, enable, timeoutMs)),
+			eReverseSoftLimitEnable, 0, enable, timeoutMs);
 }
 
 /**
@@ -1045,7 +1463,11 @@ void BaseMotorController::OverrideSoftLimitsEnable(bool enable) {
  */
 ErrorCode BaseMotorController::Config_kP(int slotIdx, double value,
 		int timeoutMs) {
-	return c_MotController_Config_kP(m_handle, slotIdx, value, timeoutMs);
+	if (Shadow().IsCurrent(eProfileParamSlot_P, slotIdx, value))
+		return OK;
+	DeviceStats::Call call(_stats, __func__, DeviceStats::Call_ConfigSet, timeoutMs);
+	return _configShadow.RecordWrite(call.Done(c_MotController_Config_kP(m_handle, slotIdx, value, timeoutMs)),
+			eProfileParamSlot_P, slotIdx, value, timeoutMs);
 }
 
 
@@ -1068,7 +1490,11 @@ ErrorCode BaseMotorController::Config_kP(int slotIdx, double value,
  */
 ErrorCode BaseMotorController::Config_kI(int slotIdx, double value,
 		int timeoutMs) {
-	return c_MotController_Config_kI(m_handle, slotIdx, value, timeoutMs);
+	if (Shadow().IsCurrent(eProfileParamSlot_I, slotIdx, value))
+		return OK;
+	DeviceStats::Call call(_stats, __func__, DeviceStats::Call_ConfigSet, timeoutMs);
+	return _configShadow.RecordWrite(call.Done(c_MotController_Config_kI(m_handle, slotIdx, value, timeoutMs)),
+			eProfileParamSlot_I, slotIdx, value, timeoutMs);
 }
 
 
@@ -1091,7 +1517,11 @@ ErrorCode BaseMotorController::Config_kI(int slotIdx, double value,
  */
 ErrorCode BaseMotorController::Config_kD(int slotIdx, double value,
 		int timeoutMs) {
-	return c_MotController_Config_kD(m_handle, slotIdx, value, timeoutMs);
+	if (Shadow().IsCurrent(eProfileParamSlot_D, slotIdx, value))
+		return OK;
+	DeviceStats::Call call(_stats, __func__, DeviceStats::Call_ConfigSet, timeoutMs);
+	return _configShadow.RecordWrite(call.Done(c_MotController_Config_kD(m_handle, slotIdx, value, timeoutMs)),
+			eProfileParamSlot_D, slotIdx, value, timeoutMs);
 }
 
 /**
@@ -1113,7 +1543,11 @@ ErrorCode BaseMotorController::Config_kD(int slotIdx, double value,
  */
 ErrorCode BaseMotorController::Config_kF(int slotIdx, double value,
 		int timeoutMs) {
-	return c_MotController_Config_kF(m_handle, slotIdx, value, timeoutMs);
+	if (Shadow().IsCurrent(eProfileParamSlot_F, slotIdx, value))
+		return OK;
+	DeviceStats::Call call(_stats, __func__, DeviceStats::Call_ConfigSet, timeoutMs);
+	return _configShadow.RecordWrite(call.Done(c_MotController_Config_kF(m_handle, slotIdx, value, timeoutMs)),
+			eProfileParamSlot_F, slotIdx, value, timeoutMs);
 }
 
 /**
@@ -1134,8 +1568,11 @@ ErrorCode BaseMotorController::Config_kF(int slotIdx, double value,
  */
 ErrorCode BaseMotorController::Config_IntegralZone(int slotIdx, int izone,
 		int timeoutMs) {
-	return c_MotController_Config_IntegralZone(m_handle, slotIdx, izone,
-			timeoutMs);
+	if (Shadow().IsCurrent(eProfileParamSlot_IZone, slotIdx, izone))
+		return OK;
+	DeviceStats::Call call(_stats, __func__, DeviceStats::Call_ConfigSet, timeoutMs);
+	return _configShadow.RecordWrite(call.Done(c_MotController_Config_IntegralZone(m_handle, slotIdx, izone, timeoutMs)),
+			eProfileParamSlot_IZone, slotIdx, izone, timeoutMs);
 }
 
 /**
@@ -1154,8 +1591,11 @@ ErrorCode BaseMotorController::Config_IntegralZone(int slotIdx, int izone,
  */
 ErrorCode BaseMotorController::ConfigAllowableClosedloopError(int slotIdx,
 		int allowableCloseLoopError, int timeoutMs) {
-	return c_MotController_ConfigAllowableClosedloopError(m_handle, slotIdx,
-			allowableCloseLoopError, timeoutMs);
+	if (Shadow().IsCurrent(eProfileParamSlot_AllowableErr, slotIdx, allowableCloseLoopError))
+		return OK;
+	DeviceStats::Call call(_stats, __func__, DeviceStats::Call_ConfigSet, timeoutMs);
+	return _configShadow.RecordWrite(call.Done(c_MotController_ConfigAllowableClosedloopError(m_handle, slotIdx, allowableCloseLoopError, timeoutMs)),
+			eProfileParamSlot_AllowableErr, slotIdx, allowableCloseLoopError, timeoutMs);
 }
 
 /**
@@ -1173,8 +1613,11 @@ ErrorCode BaseMotorController::ConfigAllowableClosedloopError(int slotIdx,
  */
 ErrorCode BaseMotorController::ConfigMaxIntegralAccumulator(int slotIdx,
 		double iaccum, int timeoutMs) {
-	return c_MotController_ConfigMaxIntegralAccumulator(m_handle, slotIdx,
-			iaccum, timeoutMs);
+	if (Shadow().IsCurrent(eProfileParamSlot_MaxIAccum, slotIdx, iaccum))
+		return OK;
+	DeviceStats::Call call(_stats, __func__, DeviceStats::Call_ConfigSet, timeoutMs);
+	return _configShadow.RecordWrite(call.Done(c_MotController_ConfigMaxIntegralAccumulator(m_handle, slotIdx, iaccum, timeoutMs)),
+			eProfileParamSlot_MaxIAccum, slotIdx, iaccum, timeoutMs);
 }
 
 /**
@@ -1194,7 +1637,11 @@ ErrorCode BaseMotorController::ConfigMaxIntegralAccumulator(int slotIdx,
  * @return Error Code generated by function. 0 indicates no error.
  */
 ErrorCode BaseMotorController::ConfigClosedLoopPeakOutput(int slotIdx, double percentOut, int timeoutMs) {
-	return c_MotController_ConfigClosedLoopPeakOutput(m_handle, slotIdx, percentOut, timeoutMs);
+	if (Shadow().IsCurrent(eProfileParamSlot_PeakOutput, slotIdx, percentOut))
+		return OK;
+	DeviceStats::Call call(_stats, __func__, DeviceStats::Call_ConfigSet, timeoutMs);
+	return _configShadow.RecordWrite(call.Done(c_MotController_ConfigClosedLoopPeakOutput(m_handle, slotIdx, percentOut, timeoutMs)),
+			eProfileParamSlot_PeakOutput, slotIdx, percentOut, timeoutMs);
 }
 
 /**
@@ -1213,7 +1660,11 @@ ErrorCode BaseMotorController::ConfigClosedLoopPeakOutput(int slotIdx, double pe
  * @return Error Code generated by function. 0 indicates no error.
  */
 ErrorCode BaseMotorController::ConfigClosedLoopPeriod(int slotIdx, int loopTimeMs, int timeoutMs) {
-	return c_MotController_ConfigClosedLoopPeriod(m_handle, slotIdx, loopTimeMs, timeoutMs);
+	if (Shadow().IsCurrent(ePIDLoopPeriod, slotIdx, loopTimeMs))
+		return OK;
+	DeviceStats::Call call(_stats, __func__, DeviceStats::Call_ConfigSet, timeoutMs);
+	return _configShadow.RecordWrite(call.Done(c_MotController_ConfigClosedLoopPeriod(m_handle, slotIdx, loopTimeMs, timeoutMs)),
+			ePIDLoopPeriod, slotIdx, loopTimeMs, timeoutMs);
 }
 
 /**
@@ -1256,8 +1707,8 @@ ErrorCode BaseMotorController::ConfigAuxPIDPolarity(bool invert, int timeoutMs){
  */
 ErrorCode BaseMotorController::SetIntegralAccumulator(double iaccum, int pidIdx,
 		int timeoutMs) {
-	return c_MotController_SetIntegralAccumulator(m_handle, iaccum, pidIdx,
-			timeoutMs);
+	return _stats.Record(c_MotController_SetIntegralAccumulator(m_handle, iaccum, pidIdx,
+			timeoutMs), __func__, DeviceStats::Call_General, timeoutMs);
 }
 
 /**
@@ -1280,10 +1731,26 @@ ErrorCode BaseMotorController::SetIntegralAccumulator(double iaccum, int pidIdx,
  * @return Closed-loop error value.
  */
 int BaseMotorController::GetClosedLoopError(int pidIdx) {
+	_frameDemand.Note(StatusFrameDemand::PidfFrame(pidIdx));
 	int closedLoopError = 0;
 	c_MotController_GetClosedLoopError(m_handle, &closedLoopError, pidIdx);
 	return closedLoopError;
 }
+/**
+ * Gets the closed-loop error (in raw sensor units) with the time of the read, see Timestamped.
+ *
+ * @param closedLoopError Caller's value to update.
+ * @param pidIdx
+ *            0 for Primary closed-loop. 1 for auxiliary closed-loop.
+ * @return Error Code of the read. 0 indicates the value is fresh.
+ */
+ErrorCode BaseMotorController::GetClosedLoopError(Timestamped<int> & closedLoopError, int pidIdx) {
+	_frameDemand.Note(StatusFrameDemand::PidfFrame(pidIdx));
+	int param = 0;
+	ErrorCode retval = (ErrorCode)c_MotController_GetClosedLoopError(m_handle, &param, pidIdx);
+	closedLoopError.Update(param, retval, GetMonotonicUs());
+	return retval;
+}
 
 /**
  * Gets the iaccum value.
@@ -1292,6 +1759,7 @@ int BaseMotorController::GetClosedLoopError(int pidIdx) {
  * @return Integral accumulator value (Closed-loop error X 1ms).
  */
 double BaseMotorController::GetIntegralAccumulator(int pidIdx) {
+	_frameDemand.Note(StatusFrameDemand::PidfFrame(pidIdx));
 	double iaccum = 0;
 	c_MotController_GetIntegralAccumulator(m_handle, &iaccum, pidIdx);
 	return iaccum;
@@ -1306,6 +1774,7 @@ double BaseMotorController::GetIntegralAccumulator(int pidIdx) {
  * @return The error derivative value.
  */
 double BaseMotorController::GetErrorDerivative(int pidIdx) {
+	_frameDemand.Note(StatusFrameDemand::PidfFrame(pidIdx));
 	double derror = 0;
 	c_MotController_GetErrorDerivative(m_handle, &derror, pidIdx);
 	return derror;
@@ -1330,10 +1799,11 @@ ErrorCode BaseMotorController::SelectProfileSlot(int slotIdx, int pidIdx) {
  * @return The closed loop target.
  */
 double BaseMotorController::GetClosedLoopTarget(int pidIdx) {
+	_frameDemand.Note(StatusFrameDemand::PidfFrame(pidIdx));
 	int param = 0;
 	c_MotController_GetClosedLoopTarget(m_handle, &param, pidIdx);
 	double value = param;
-	if(m_controlMode == ControlMode::Current){
+	if(m_controlMode.load(std::memory_order_relaxed) == ControlMode::Current){
 		value = value / 1000; //convert back to amps
 	}
 	return value;
@@ -1347,6 +1817,8 @@ double BaseMotorController::GetClosedLoopTarget(int pidIdx) {
  * @return The Active Trajectory Position in sensor units.
  */
 int BaseMotorController::GetActiveTrajectoryPosition(int pidIdx) {
+	if (pidIdx == 0)
+		_frameDemand.Note(StatusFrameEnhanced::Status_10_Targets);
 	int param = 0;
 	c_MotController_GetActiveTrajectoryPosition_3(m_handle, &param, pidIdx);
 	return param;
@@ -1360,6 +1832,8 @@ int BaseMotorController::GetActiveTrajectoryPosition(int pidIdx) {
  * @return The Active Trajectory Velocity in sensor units per 100ms.
  */
 int BaseMotorController::GetActiveTrajectoryVelocity(int pidIdx) {
+	if (pidIdx == 0)
+		_frameDemand.Note(StatusFrameEnhanced::Status_10_Targets);
 	int param = 0;
 	c_MotController_GetActiveTrajectoryVelocity_3(m_handle, &param, pidIdx);
 	return param;
@@ -1375,6 +1849,8 @@ int BaseMotorController::GetActiveTrajectoryVelocity(int pidIdx) {
  * 			(where 0.01 is 1%).
  */
 double BaseMotorController::GetActiveTrajectoryArbFeedFwd(int pidIdx){
+	if (pidIdx == 0)
+		_frameDemand.Note(StatusFrameEnhanced::Status_10_Targets);
 	double param = 0;
 	c_MotController_GetActiveTrajectoryArbFeedFwd_3(m_handle, &param, pidIdx);
 	return param;
@@ -1409,8 +1885,11 @@ double BaseMotorController::GetActiveTrajectoryHeading() {
  */
 ErrorCode BaseMotorController::ConfigMotionCruiseVelocity(
 		int sensorUnitsPer100ms, int timeoutMs) {
-	return c_MotController_ConfigMotionCruiseVelocity(m_handle,
-			sensorUnitsPer100ms, timeoutMs);
+	if (Shadow().IsCurrent(eMotMag_VelCruise, 0, sensorUnitsPer100ms))
+		return OK;
+	DeviceStats::Call call(_stats, __func__, DeviceStats::Call_ConfigSet, timeoutMs);
+	return _configShadow.RecordWrite(call.Done(c_MotController_ConfigMotionCruiseVelocity(m_handle, sensorUnitsPer100ms, timeoutMs)),
+			eMotMag_VelCruise, 0, sensorUnitsPer100ms, timeoutMs);
 }
 /**
  * Sets the Motion Magic Acceleration.  This is the target acceleration
@@ -1427,8 +1906,11 @@ ErrorCode BaseMotorController::ConfigMotionCruiseVelocity(
  */
 ErrorCode BaseMotorController::ConfigMotionAcceleration(
 		int sensorUnitsPer100msPerSec, int timeoutMs) {
-	return c_MotController_ConfigMotionAcceleration(m_handle,
-			sensorUnitsPer100msPerSec, timeoutMs);
+	if (Shadow().IsCurrent(eMotMag_Accel, 0, sensorUnitsPer100msPerSec))
+		return OK;
+	DeviceStats::Call call(_stats, __func__, DeviceStats::Call_ConfigSet, timeoutMs);
+	return _configShadow.RecordWrite(call.Done(c_MotController_ConfigMotionAcceleration(m_handle, sensorUnitsPer100msPerSec, timeoutMs)),
+			eMotMag_Accel, 0, sensorUnitsPer100msPerSec, timeoutMs);
 }
 /**
  * Sets the Motion Magic S Curve Strength.
@@ -1444,7 +1926,11 @@ ErrorCode BaseMotorController::ConfigMotionAcceleration(
  * @return Error Code generated by function. 0 indicates no error.
  */
 ErrorCode BaseMotorController::ConfigMotionSCurveStrength(int curveStrength, int timeoutMs) {
-	return c_MotController_ConfigMotionSCurveStrength(m_handle, curveStrength, timeoutMs);
+	if (Shadow().IsCurrent(eMotMag_SCurveLevel, 0, curveStrength))
+		return OK;
+	DeviceStats::Call call(_stats, __func__, DeviceStats::Call_ConfigSet, timeoutMs);
+	return _configShadow.RecordWrite(call.Done(c_MotController_ConfigMotionSCurveStrength(m_handle, curveStrength, timeoutMs)),
+			eMotMag_SCurveLevel, 0, curveStrength, timeoutMs);
 }
 //------ Motion Profile Buffer ----------//
 /**
@@ -1520,8 +2006,13 @@ ErrorCode BaseMotorController::PushMotionProfileTrajectory(const ctre::phoenix::
 }
 
 ErrorCode BaseMotorController::StartMotionProfile(ctre::phoenix::motion::BufferedTrajectoryPointStream & stream, uint32_t minBufferedPts, ControlMode motionProfControlMode) {
-	ErrorCode retval = c_MotController_StartMotionProfile(m_handle, stream.GetHandle(), minBufferedPts, motionProfControlMode);
-	return retval;
+	/* the MP start changes the control mode under us, so the next Set() must go through */
+	_lastSentValid = false;
+	/* hand any staged points to the stream before it is started */
+	ErrorCollection errorCollection;
+	errorCollection.NewError(stream.Flush());
+	errorCollection.NewError(c_MotController_StartMotionProfile(m_handle, stream.GetHandle(), minBufferedPts, motionProfControlMode));
+	return errorCollection._worstError;
 }
 bool BaseMotorController::IsMotionProfileFinished() {
 	bool retval = false;
@@ -1623,7 +2114,8 @@ ErrorCode BaseMotorController::GetMotionProfileStatus(
  * @return Error Code generated by function. 0 indicates no error.
  */
 ErrorCode BaseMotorController::ClearMotionProfileHasUnderrun(int timeoutMs) {
-	return c_MotController_ClearMotionProfileHasUnderrun(m_handle, timeoutMs);
+	return _stats.Record(c_MotController_ClearMotionProfileHasUnderrun(m_handle, timeoutMs), __func__,
+			DeviceStats::Call_General, timeoutMs);
 }
 /**
  * Calling application can opt to speed up the handshaking between the robot API
@@ -1652,7 +2144,11 @@ ErrorCode BaseMotorController::ChangeMotionControlFramePeriod(int periodMs) {
  * @return Error Code generated by function. 0 indicates no error.
  */
 ErrorCode BaseMotorController::ConfigMotionProfileTrajectoryPeriod(int baseTrajDurationMs, int timeoutMs) {
-	return c_MotController_ConfigMotionProfileTrajectoryPeriod(m_handle, baseTrajDurationMs, timeoutMs);
+	if (Shadow().IsCurrent(eMotionProfileTrajectoryPointDurationMs, 0, baseTrajDurationMs))
+		return OK;
+	DeviceStats::Call call(_stats, __func__, DeviceStats::Call_ConfigSet, timeoutMs);
+	return _configShadow.RecordWrite(call.Done(c_MotController_ConfigMotionProfileTrajectoryPeriod(m_handle, baseTrajDurationMs, timeoutMs)),
+			eMotionProfileTrajectoryPointDurationMs, 0, baseTrajDurationMs, timeoutMs);
 }
 
 /**
@@ -1670,7 +2166,8 @@ ErrorCode BaseMotorController::ConfigMotionProfileTrajectoryPeriod(int baseTrajD
  * @return Error Code generated by function. 0 indicates no error.
  */
 ErrorCode BaseMotorController::ConfigMotionProfileTrajectoryInterpolationEnable(bool enable, int timeoutMs) {
-	return c_MotController_ConfigMotionProfileTrajectoryInterpolationEnable(m_handle, enable, timeoutMs);
+	DeviceStats::Call call(_stats, __func__, DeviceStats::Call_ConfigSet, timeoutMs);
+	return call.Done(c_MotController_ConfigMotionProfileTrajectoryInterpolationEnable(m_handle, enable, timeoutMs));
 }
 
 //------Feedback Device Interaction Settings---------//
@@ -1693,7 +2190,11 @@ ErrorCode BaseMotorController::ConfigMotionProfileTrajectoryInterpolationEnable(
  * @return Error Code generated by function. 0 indicates no error.
  */
 ErrorCode BaseMotorController::ConfigFeedbackNotContinuous(bool feedbackNotContinuous, int timeoutMs) {
-    return c_MotController_ConfigFeedbackNotContinuous(m_handle, feedbackNotContinuous, timeoutMs);
+	if (Shadow().IsCurrent(eFeedbackNotContinuous, 0, feedbackNotContinuous))
+		return OK;
+	DeviceStats::Call call(_stats, __func__, DeviceStats::Call_ConfigSet, timeoutMs);
+	return _configShadow.RecordWrite(call.Done(c_MotController_ConfigFeedbackNotContinuous(m_handle, feedbackNotContinuous, timeoutMs)),
+			eFeedbackNotContinuous, 0, feedbackNotContinuous, timeoutMs);
 }
 
 /**
@@ -1708,7 +2209,11 @@ ErrorCode BaseMotorController::ConfigFeedbackNotContinuous(bool feedbackNotConti
  * @return Error Code generated by function. 0 indicates no error.
  */
 ErrorCode BaseMotorController::ConfigRemoteSensorClosedLoopDisableNeutralOnLOS(bool remoteSensorClosedLoopDisableNeutralOnLOS, int timeoutMs) {
-    return c_MotController_ConfigRemoteSensorClosedLoopDisableNeutralOnLOS(m_handle, remoteSensorClosedLoopDisableNeutralOnLOS, timeoutMs);
+	if (Shadow().IsCurrent(eRemoteSensorClosedLoopDisableNeutralOnLOS, 0, remoteSensorClosedLoopDisableNeutralOnLOS))
+		return OK;
+	DeviceStats::Call call(_stats, __func__, DeviceStats::Call_ConfigSet, timeoutMs);
+	return _configShadow.RecordWrite(call.Done(c_MotController_ConfigRemoteSensorClosedLoopDisableNeutralOnLOS(m_handle, remoteSensorClosedLoopDisableNeutralOnLOS, timeoutMs)),
+			eRemoteSensorClosedLoopDisableNeutralOnLOS, 0, remoteSensorClosedLoopDisableNeutralOnLOS, timeoutMs);
 }
 
 /**
@@ -1723,7 +2228,11 @@ ErrorCode BaseMotorController::ConfigRemoteSensorClosedLoopDisableNeutralOnLOS(b
  * @return Error Code generated by function. 0 indicates no error.
  */
 ErrorCode BaseMotorController::ConfigClearPositionOnLimitF(bool clearPositionOnLimitF, int timeoutMs) {
-    return c_MotController_ConfigClearPositionOnLimitF(m_handle, clearPositionOnLimitF, timeoutMs);
+	if (Shadow().IsCurrent(eClearPositionOnLimitF, 0, clearPositionOnLimitF))
+		return OK;
+	DeviceStats::Call call(_stats, __func__, DeviceStats::Call_ConfigSet, timeoutMs);
+	return _configShadow.RecordWrite(call.Done(c_MotController_ConfigClearPositionOnLimitF(m_handle, clearPositionOnLimitF, timeoutMs)),
+			eClearPositionOnLimitF, 0, clearPositionOnLimitF, timeoutMs);
 }
 
 /**
@@ -1738,7 +2247,11 @@ ErrorCode BaseMotorController::ConfigClearPositionOnLimitF(bool clearPositionOnL
  * @return Error Code generated by function. 0 indicates no error.
  */
 ErrorCode BaseMotorController::ConfigClearPositionOnLimitR(bool clearPositionOnLimitR, int timeoutMs) {
-    return c_MotController_ConfigClearPositionOnLimitR(m_handle, clearPositionOnLimitR, timeoutMs);
+	if (Shadow().IsCurrent(eClearPositionOnLimitR, 0, clearPositionOnLimitR))
+		return OK;
+	DeviceStats::Call call(_stats, __func__, DeviceStats::Call_ConfigSet, timeoutMs);
+	return _configShadow.RecordWrite(call.Done(c_MotController_ConfigClearPositionOnLimitR(m_handle, clearPositionOnLimitR, timeoutMs)),
+			eClearPositionOnLimitR, 0, clearPositionOnLimitR, timeoutMs);
 }
 
 /**
@@ -1753,7 +2266,11 @@ ErrorCode BaseMotorController::ConfigClearPositionOnLimitR(bool clearPositionOnL
  * @return Error Code generated by function. 0 indicates no error.
  */
 ErrorCode BaseMotorController::ConfigClearPositionOnQuadIdx(bool clearPositionOnQuadIdx, int timeoutMs) {
-    return c_MotController_ConfigClearPositionOnQuadIdx(m_handle, clearPositionOnQuadIdx, timeoutMs);
+	if (Shadow().IsCurrent(eClearPositionOnQuadIdx, 0, clearPositionOnQuadIdx))
+		return OK;
+	DeviceStats::Call call(_stats, __func__, DeviceStats::Call_ConfigSet, timeoutMs);
+	return _configShadow.RecordWrite(call.Done(c_MotController_ConfigClearPositionOnQuadIdx(m_handle, clearPositionOnQuadIdx, timeoutMs)),
+			eClearPositionOnQuadIdx, 0, clearPositionOnQuadIdx, timeoutMs);
 }
 
 /**
@@ -1768,7 +2285,11 @@ ErrorCode BaseMotorController::ConfigClearPositionOnQuadIdx(bool clearPositionOn
  * @return Error Code generated by function. 0 indicates no error.
  */
 ErrorCode BaseMotorController::ConfigLimitSwitchDisableNeutralOnLOS(bool limitSwitchDisableNeutralOnLOS, int timeoutMs) {
-    return c_MotController_ConfigLimitSwitchDisableNeutralOnLOS(m_handle, limitSwitchDisableNeutralOnLOS, timeoutMs);
+	if (Shadow().IsCurrent(eLimitSwitchDisableNeutralOnLOS, 0, limitSwitchDisableNeutralOnLOS))
+		return OK;
+	DeviceStats::Call call(_stats, __func__, DeviceStats::Call_ConfigSet, timeoutMs);
+	return _configShadow.RecordWrite(call.Done(c_MotController_ConfigLimitSwitchDisableNeutralOnLOS(m_handle, limitSwitchDisableNeutralOnLOS, timeoutMs)),
+			eLimitSwitchDisableNeutralOnLOS, 0, limitSwitchDisableNeutralOnLOS, timeoutMs);
 }
 
 /**
@@ -1783,7 +2304,11 @@ ErrorCode BaseMotorController::ConfigLimitSwitchDisableNeutralOnLOS(bool limitSw
  * @return Error Code generated by function. 0 indicates no error.
  */
 ErrorCode BaseMotorController::ConfigSoftLimitDisableNeutralOnLOS(bool softLimitDisableNeutralOnLOS, int timeoutMs) {
-    return c_MotController_ConfigSoftLimitDisableNeutralOnLOS(m_handle, softLimitDisableNeutralOnLOS, timeoutMs);
+	if (Shadow().IsCurrent(eSoftLimitDisableNeutralOnLOS, 0, softLimitDisableNeutralOnLOS))
+		return OK;
+	DeviceStats::Call call(_stats, __func__, DeviceStats::Call_ConfigSet, timeoutMs);
+	return _configShadow.RecordWrite(call.Done(c_MotController_ConfigSoftLimitDisableNeutralOnLOS(m_handle, softLimitDisableNeutralOnLOS, timeoutMs)),
+			eSoftLimitDisableNeutralOnLOS, 0, softLimitDisableNeutralOnLOS, timeoutMs);
 }
 
 /**
@@ -1799,7 +2324,11 @@ ErrorCode BaseMotorController::ConfigSoftLimitDisableNeutralOnLOS(bool softLimit
  * @return Error Code generated by function. 0 indicates no error.
  */
 ErrorCode BaseMotorController::ConfigPulseWidthPeriod_EdgesPerRot(int pulseWidthPeriod_EdgesPerRot, int timeoutMs) {
-    return c_MotController_ConfigPulseWidthPeriod_EdgesPerRot(m_handle, pulseWidthPeriod_EdgesPerRot, timeoutMs);
+	if (Shadow().IsCurrent(ePulseWidthPeriod_EdgesPerRot, 0, pulseWidthPeriod_EdgesPerRot))
+		return OK;
+	DeviceStats::Call call(_stats, __func__, DeviceStats::Call_ConfigSet, timeoutMs);
+	return _configShadow.RecordWrite(call.Done(c_MotController_ConfigPulseWidthPeriod_EdgesPerRot(m_handle, pulseWidthPeriod_EdgesPerRot, timeoutMs)),
+			ePulseWidthPeriod_EdgesPerRot, 0, pulseWidthPeriod_EdgesPerRot, timeoutMs);
 }
 
 /**
@@ -1815,7 +2344,11 @@ ErrorCode BaseMotorController::ConfigPulseWidthPeriod_EdgesPerRot(int pulseWidth
  * @return Error Code generated by function. 0 indicates no error.
  */
 ErrorCode BaseMotorController::ConfigPulseWidthPeriod_FilterWindowSz(int pulseWidthPeriod_FilterWindowSz, int timeoutMs) {
-    return c_MotController_ConfigPulseWidthPeriod_FilterWindowSz(m_handle, pulseWidthPeriod_FilterWindowSz, timeoutMs);
+	if (Shadow().IsCurrent(ePulseWidthPeriod_FilterWindowSz, 0, pulseWidthPeriod_FilterWindowSz))
+		return OK;
+	DeviceStats::Call call(_stats, __func__, DeviceStats::Call_ConfigSet, timeoutMs);
+	return _configShadow.RecordWrite(call.Done(c_MotController_ConfigPulseWidthPeriod_FilterWindowSz(m_handle, pulseWidthPeriod_FilterWindowSz, timeoutMs)),
+			ePulseWidthPeriod_FilterWindowSz, 0, pulseWidthPeriod_FilterWindowSz, timeoutMs);
 }
 
 //------ error ----------//
@@ -1837,8 +2370,9 @@ ErrorCode BaseMotorController::GetLastError() {
  * @return Last Error Code generated by a function.
  */
 ErrorCode BaseMotorController::GetFaults(Faults & toFill) {
+	_frameDemand.Note(StatusFrameEnhanced::Status_1_General);
 	int faultBits;
-	ErrorCode retval = c_MotController_GetFaults(m_handle, &faultBits);
+	ErrorCode retval = _stats.Record(c_MotController_GetFaults(m_handle, &faultBits), __func__);
 	toFill = Faults(faultBits);
 	return retval;
 }
@@ -1848,8 +2382,9 @@ ErrorCode BaseMotorController::GetFaults(Faults & toFill) {
  * @return Last Error Code generated by a function.
  */
 ErrorCode BaseMotorController::GetStickyFaults(StickyFaults & toFill) {
+	_frameDemand.Note(StatusFrameEnhanced::Status_2_Feedback0);
 	int faultBits;
-	ErrorCode retval = c_MotController_GetStickyFaults(m_handle, &faultBits);
+	ErrorCode retval = _stats.Record(c_MotController_GetStickyFaults(m_handle, &faultBits), __func__);
 	toFill = StickyFaults(faultBits);
 	return retval;
 }
@@ -1862,7 +2397,8 @@ ErrorCode BaseMotorController::GetStickyFaults(StickyFaults & toFill) {
  * @return Last Error Code generated by a function.
  */
 ErrorCode BaseMotorController::ClearStickyFaults(int timeoutMs) {
-	return c_MotController_ClearStickyFaults(m_handle, timeoutMs);
+	return _stats.Record(c_MotController_ClearStickyFaults(m_handle, timeoutMs), __func__,
+			DeviceStats::Call_General, timeoutMs);
 }
 
 //------ Firmware ----------//
@@ -1882,9 +2418,64 @@ int BaseMotorController::GetFirmwareVersion() {
  * @return Has a Device Reset Occurred?
  */
 bool BaseMotorController::HasResetOccurred() {
-	bool retval = false;
-	c_MotController_HasResetOccurred(m_handle, &retval);
-	return retval;
+	_configShadow.PollReset(m_handle, &PollResetForShadow);
+	/* include any reset consumed by the config shadow or GetResetCount() */
+	return _configShadow.TakeReset();
+}
+/**
+ * Counts device resets without consuming HasResetOccurred(), so several
+ * helpers (such as StatusFramePeriodManager) can each detect a reset.
+ *
+ * @return Number of device resets observed since construction.
+ */
+uint32_t BaseMotorController::GetResetCount() {
+	_configShadow.PollReset(m_handle, &PollResetForShadow);
+	return _configShadow.GetResetCount();
+}
+/**
+ * @return config shadow, invalidated first if the device has reset.
+ */
+ConfigShadow & BaseMotorController::Shadow() {
+	return _configShadow.Checked(m_handle, &PollResetForShadow);
+}
+//------ Config Shadow ----------//
+/**
+ * Enables the client-side config shadow, see ConfigShadow.
+ *
+ * @param enable
+ *            true to enable the shadow, false to disable and clear it.
+ * @param maxAgeMs
+ *            Entries older than this are read from the device again.
+ *            Zero to keep entries until the device resets.
+ */
+void BaseMotorController::EnableConfigShadow(bool enable, int maxAgeMs) {
+	_configShadow.Enable(enable, maxAgeMs);
+}
+/**
+ * Clears the config shadow so the next config reads go to the device.
+ */
+void BaseMotorController::InvalidateConfigShadow() {
+	_configShadow.Invalidate();
+}
+/**
+ * @return Checksum over the config shadow. Compare against a previously
+ *         saved checksum to detect that the shadowed configuration changed.
+ */
+uint32_t BaseMotorController::GetConfigShadowChecksum() {
+	return Shadow().GetChecksum();
+}
+/**
+ * Reads back every shadowed parameter in a single batch and drops any entry
+ * that no longer matches the device, so the next write of it goes through.
+ *
+ * @param mismatches
+ *            Filled with the number of shadowed parameters that did not match.
+ * @param timeoutMs
+ *            Timeout value in ms for the entire readback.
+ * @return Error Code generated by function. 0 indicates every parameter was read.
+ */
+ErrorCode BaseMotorController::VerifyConfigShadow(int & mismatches, int timeoutMs) {
+	return Shadow().Verify(m_handle, &GetParamForReadback, timeoutMs, mismatches);
 }
 
 //------ Custom Persistent Params ----------//
@@ -1907,8 +2498,11 @@ bool BaseMotorController::HasResetOccurred() {
  */
 ErrorCode BaseMotorController::ConfigSetCustomParam(int newValue,
 		int paramIndex, int timeoutMs) {
-	return c_MotController_ConfigSetCustomParam(m_handle, newValue, paramIndex,
-			timeoutMs);
+	if (Shadow().IsCurrent(eCustomParam, paramIndex, newValue))
+		return OK;
+	DeviceStats::Call call(_stats, __func__, DeviceStats::Call_ConfigSet, timeoutMs);
+	return _configShadow.RecordWrite(call.Done(c_MotController_ConfigSetCustomParam(m_handle, newValue, paramIndex, timeoutMs)),
+			eCustomParam, paramIndex, newValue, timeoutMs);
 }
 
 /**
@@ -1923,9 +2517,14 @@ ErrorCode BaseMotorController::ConfigSetCustomParam(int newValue,
  * @return Value of the custom param.
  */
 int BaseMotorController::ConfigGetCustomParam(int paramIndex, int timeoutMs) {
-	int readValue;
-	c_MotController_ConfigGetCustomParam(m_handle, &readValue, paramIndex,
-			timeoutMs);
+	double shadowed = 0;
+	if (Shadow().Get(eCustomParam, paramIndex, shadowed))
+		return (int) shadowed;
+	int readValue = 0;
+	DeviceStats::Call call(_stats, __func__, DeviceStats::Call_ConfigGet, timeoutMs);
+	ErrorCode retval = call.Done(c_MotController_ConfigGetCustomParam(m_handle, &readValue, paramIndex,
+			timeoutMs));
+	_configShadow.RecordRead(retval, eCustomParam, paramIndex, readValue);
 	return readValue;
 }
 
@@ -1953,8 +2552,16 @@ int BaseMotorController::ConfigGetCustomParam(int paramIndex, int timeoutMs) {
  */
 ErrorCode BaseMotorController::ConfigSetParameter(ParamEnum param, double value,
 		uint8_t subValue, int ordinal, int timeoutMs) {
-	return c_MotController_ConfigSetParameter(m_handle, param, value, subValue,
-			ordinal, timeoutMs);
+	/* sub value is not shadowed, so only plain writes can be skipped */
+	if (subValue == 0 && Shadow().IsCurrent(param, ordinal, value))
+		return OK;
+	DeviceStats::Call call(_stats, __func__, DeviceStats::Call_ConfigSet, timeoutMs);
+	ErrorCode retval = call.Done(c_MotController_ConfigSetParameter(m_handle, param, value, subValue,
+			ordinal, timeoutMs));
+	if (subValue == 0)
+		return _configShadow.RecordWrite(retval, param, ordinal, value, timeoutMs);
+	_configShadow.Invalidate(param, ordinal);
+	return retval;
 }
 
 /**
@@ -1973,8 +2580,12 @@ ErrorCode BaseMotorController::ConfigSetParameter(ParamEnum param, double value,
 double BaseMotorController::ConfigGetParameter(ctre::phoenix::ParamEnum param, int ordinal,
 		int timeoutMs) {
 	double value = 0;
-	c_MotController_ConfigGetParameter(m_handle, param, &value, ordinal,
-			timeoutMs);
+	if (Shadow().Get(param, ordinal, value))
+		return value;
+	DeviceStats::Call call(_stats, __func__, DeviceStats::Call_ConfigGet, timeoutMs);
+	ErrorCode retval = call.Done(c_MotController_ConfigGetParameter(m_handle, param, &value, ordinal,
+			timeoutMs));
+	_configShadow.RecordRead(retval, param, ordinal, value);
 	return (double) value;
 }
 
@@ -2006,7 +2617,8 @@ double BaseMotorController::ConfigGetParameter(ctre::phoenix::ParamEnum param, i
 ErrorCode BaseMotorController::ConfigGetParameter(ParamEnum param, int32_t valueToSend,
             int32_t & valueReceived, uint8_t & subValue, int32_t ordinal,
             int32_t timeoutMs) {
-	return c_MotController_ConfigGetParameter_6(m_handle, param, valueToSend, &valueReceived, &subValue, ordinal, timeoutMs);
+	DeviceStats::Call call(_stats, __func__, DeviceStats::Call_ConfigGet, timeoutMs);
+	return call.Done(c_MotController_ConfigGetParameter_6(m_handle, param, valueToSend, &valueReceived, &subValue, ordinal, timeoutMs));
 }
 
 //------ Misc. ----------//
@@ -2017,7 +2629,7 @@ int BaseMotorController::GetBaseID() {
  * @return control mode motor controller is in
  */
 ControlMode BaseMotorController::GetControlMode() {
-	return m_controlMode;
+	return m_controlMode.load(std::memory_order_relaxed);
 }
 
 // ----- Follower ------//
@@ -2271,3 +2883,190 @@ void BaseMotorController::BaseGetAllConfigs(BaseMotorControllerConfiguration &al
 
 
 }
+
+/**
+ * Creates an empty batched config readback for this device.
+ *
+ * @param timeoutMs
+ *              Timeout value in ms for the entire readback.
+ *              If zero, no blocking is performed.
+ * @return Readback to register parameters with.
+ */
+ConfigReadback BaseMotorController::NewConfigReadback(int timeoutMs) {
+	return ConfigReadback(m_handle, &GetParamForReadback, timeoutMs);
+}
+
+void BaseMotorController::AddSlotConfigs(ConfigReadback &readback, SlotConfiguration &slot, int slotIdx) {
+	readback.Add(eProfileParamSlot_P, slotIdx, slot.kP);
+	readback.Add(eProfileParamSlot_I, slotIdx, slot.kI);
+	readback.Add(eProfileParamSlot_D, slotIdx, slot.kD);
+	readback.Add(eProfileParamSlot_F, slotIdx, slot.kF);
+	readback.Add(eProfileParamSlot_IZone, slotIdx, slot.integralZone);
+	readback.Add(eProfileParamSlot_AllowableErr, slotIdx, slot.allowableClosedloopError);
+	readback.Add(eProfileParamSlot_MaxIAccum, slotIdx, slot.maxIntegralAccumulator);
+	readback.Add(eProfileParamSlot_PeakOutput, slotIdx, slot.closedLoopPeakOutput);
+	readback.Add(ePIDLoopPeriod, slotIdx, slot.closedLoopPeriod);
+}
+
+void BaseMotorController::AddFilterConfigs(ConfigReadback &readback, FilterConfiguration &filter, int ordinal) {
+	readback.Add(eRemoteSensorDeviceID, ordinal, filter.remoteSensorDeviceID);
+	readback.Add(eRemoteSensorSource, ordinal, filter.remoteSensorSource);
+}
+
+/**
+ * Registers all base PID set persistant settings with a batched readback.
+ *
+ * @param readback      Readback to register parameters with
+ * @param pid           Object to fill with all of the base PID set persistant settings
+ * @param pidIdx        0 for Primary closed-loop. 1 for auxiliary closed-loop.
+ */
+void BaseMotorController::BaseGetPIDConfigsAsync(ConfigReadback &readback, BasePIDSetConfiguration &pid, int pidIdx) {
+	readback.Add(eSelectedSensorCoefficient, pidIdx, pid.selectedFeedbackCoefficient);
+}
+
+/**
+ * Registers all base persistant settings with a batched readback.
+ * Mirrors BaseGetAllConfigs, but nothing is read until the readback is sent.
+ *
+ * @param readback          Readback to register parameters with
+ * @param allConfigs        Object to fill with all of the base persistant settings
+ */
+void BaseMotorController::BaseGetAllConfigsAsync(ConfigReadback &readback, BaseMotorControllerConfiguration &allConfigs) {
+
+	readback.Add(eOpenloopRamp, 0, allConfigs.openloopRamp);
+	readback.Add(eClosedloopRamp, 0, allConfigs.closedloopRamp);
+	readback.Add(ePeakPosOutput, 0, allConfigs.peakOutputForward);
+	readback.Add(ePeakNegOutput, 0, allConfigs.peakOutputReverse);
+	readback.Add(eNominalPosOutput, 0, allConfigs.nominalOutputForward);
+	readback.Add(eNominalNegOutput, 0, allConfigs.nominalOutputReverse);
+	readback.Add(eNeutralDeadband, 0, allConfigs.neutralDeadband);
+	readback.Add(eNominalBatteryVoltage, 0, allConfigs.voltageCompSaturation);
+	readback.Add(eBatteryVoltageFilterSize, 0, allConfigs.voltageMeasurementFilter);
+	readback.Add(eSampleVelocityPeriod, 0, allConfigs.velocityMeasurementPeriod);
+	readback.Add(eSampleVelocityWindow, 0, allConfigs.velocityMeasurementWindow);
+	readback.Add(eForwardSoftLimitThreshold, 0, allConfigs.forwardSoftLimitThreshold);
+	readback.Add(eReverseSoftLimitThreshold, 0, allConfigs.reverseSoftLimitThreshold);
+	readback.Add(eForwardSoftLimitEnable, 0, allConfigs.forwardSoftLimitEnable);
+	readback.Add(eReverseSoftLimitEnable, 0, allConfigs.reverseSoftLimitEnable);
+
+	AddSlotConfigs(readback, allConfigs.slot0, 0);
+	AddSlotConfigs(readback, allConfigs.slot1, 1);
+	AddSlotConfigs(readback, allConfigs.slot2, 2);
+	AddSlotConfigs(readback, allConfigs.slot3, 3);
+
+	readback.Add(ePIDLoopPolarity, 1, allConfigs.auxPIDPolarity);
+
+	AddFilterConfigs(readback, allConfigs.remoteFilter0, 0);
+	AddFilterConfigs(readback, allConfigs.remoteFilter1, 1);
+
+	readback.Add(eMotMag_VelCruise, 0, allConfigs.motionCruiseVelocity);
+	readback.Add(eMotMag_Accel, 0, allConfigs.motionAcceleration);
+	readback.Add(eMotMag_SCurveLevel, 0, allConfigs.motionCurveStrength);
+	readback.Add(eMotionProfileTrajectoryPointDurationMs, 0, allConfigs.motionProfileTrajectoryPeriod);
+	readback.Add(eCustomParam, 0, allConfigs.customParam0);
+	readback.Add(eCustomParam, 1, allConfigs.customParam1);
+
+	readback.Add(eFeedbackNotContinuous, 0, allConfigs.feedbackNotContinuous);
+	readback.Add(eRemoteSensorClosedLoopDisableNeutralOnLOS, 0, allConfigs.remoteSensorClosedLoopDisableNeutralOnLOS);
+	readback.Add(eClearPositionOnLimitF, 0, allConfigs.clearPositionOnLimitF);
+	readback.Add(eClearPositionOnLimitR, 0, allConfigs.clearPositionOnLimitR);
+	readback.Add(eClearPositionOnQuadIdx, 0, allConfigs.clearPositionOnQuadIdx);
+	readback.Add(eLimitSwitchDisableNeutralOnLOS, 0, allConfigs.limitSwitchDisableNeutralOnLOS);
+	readback.Add(eSoftLimitDisableNeutralOnLOS, 0, allConfigs.softLimitDisableNeutralOnLOS);
+	readback.Add(ePulseWidthPeriod_EdgesPerRot, 0, allConfigs.pulseWidthPeriod_EdgesPerRot);
+	readback.Add(ePulseWidthPeriod_FilterWindowSz, 0, allConfigs.pulseWidthPeriod_FilterWindowSz);
+}
+
+ctre::phoenix::ErrorCode BaseMotorController::ReconcileSlot(const SlotConfiguration &slot, const SlotConfiguration &actual, int slotIdx, ConfigReconcileReport &report, int timeoutMs) {
+
+	ErrorCollection errorCollection;
+
+	if(ConfigReconcileUtil::Different(slot.kP, actual.kP, eProfileParamSlot_P, slotIdx, report)) errorCollection.NewError(Config_kP(slotIdx, slot.kP, timeoutMs));
+	if(ConfigReconcileUtil::Different(slot.kI, actual.kI, eProfileParamSlot_I, slotIdx, report)) errorCollection.NewError(Config_kI(slotIdx, slot.kI, timeoutMs));
+	if(ConfigReconcileUtil::Different(slot.kD, actual.kD, eProfileParamSlot_D, slotIdx, report)) errorCollection.NewError(Config_kD(slotIdx, slot.kD, timeoutMs));
+	if(ConfigReconcileUtil::Different(slot.kF, actual.kF, eProfileParamSlot_F, slotIdx, report)) errorCollection.NewError(Config_kF(slotIdx, slot.kF, timeoutMs));
+	if(ConfigReconcileUtil::Different(slot.integralZone, actual.integralZone, eProfileParamSlot_IZone, slotIdx, report)) errorCollection.NewError(Config_IntegralZone(slotIdx, slot.integralZone, timeoutMs));
+	if(ConfigReconcileUtil::Different(slot.allowableClosedloopError, actual.allowableClosedloopError, eProfileParamSlot_AllowableErr, slotIdx, report)) errorCollection.NewError(ConfigAllowableClosedloopError(slotIdx, slot.allowableClosedloopError, timeoutMs));
+	if(ConfigReconcileUtil::Different(slot.maxIntegralAccumulator, actual.maxIntegralAccumulator, eProfileParamSlot_MaxIAccum, slotIdx, report)) errorCollection.NewError(ConfigMaxIntegralAccumulator(slotIdx, slot.maxIntegralAccumulator, timeoutMs));
+	if(ConfigReconcileUtil::Different(slot.closedLoopPeakOutput, actual.closedLoopPeakOutput, eProfileParamSlot_PeakOutput, slotIdx, report)) errorCollection.NewError(ConfigClosedLoopPeakOutput(slotIdx, slot.closedLoopPeakOutput, timeoutMs));
+	if(ConfigReconcileUtil::Different(slot.closedLoopPeriod, actual.closedLoopPeriod, ePIDLoopPeriod, slotIdx, report)) errorCollection.NewError(ConfigClosedLoopPeriod(slotIdx, slot.closedLoopPeriod, timeoutMs));
+
+	return errorCollection._worstError;
+}
+
+ctre::phoenix::ErrorCode BaseMotorController::ReconcileFilter(const FilterConfiguration &filter, const FilterConfiguration &actual, int ordinal, ConfigReconcileReport &report, int timeoutMs) {
+
+	/* device ID and source are written together, so evaluate both to record each change */
+	bool idDifferent = ConfigReconcileUtil::Different(filter.remoteSensorDeviceID, actual.remoteSensorDeviceID, eRemoteSensorDeviceID, ordinal, report);
+	bool sourceDifferent = ConfigReconcileUtil::Different(filter.remoteSensorSource, actual.remoteSensorSource, eRemoteSensorSource, ordinal, report);
+	if(idDifferent || sourceDifferent)
+		return ConfigRemoteFeedbackFilter(filter.remoteSensorDeviceID, filter.remoteSensorSource, ordinal, timeoutMs);
+
+	return ctre::phoenix::ErrorCode::OK;
+}
+
+/**
+ * Writes only the base persistant settings that differ from the device's
+ * actual settings.  No factory default is performed.
+ *
+ * @param allConfigs        Object with all of the requested base persistant settings
+ * @param actual            Object with the base persistant settings read back from the device
+ * @param report            Report to record the changed parameters in
+ * @param timeoutMs
+ *              Timeout value in ms. If nonzero, function will wait for
+ *              config success and report an error if it times out.
+ *              If zero, no blocking or checking is performed.
+ *
+ * @return Error Code generated by function. 0 indicates no error.
+ */
+ctre::phoenix::ErrorCode BaseMotorController::BaseReconcileAllSettings(const BaseMotorControllerConfiguration &allConfigs,
+		const BaseMotorControllerConfiguration &actual, ConfigReconcileReport &report, int timeoutMs) {
+
+	ErrorCollection errorCollection;
+
+	if(ConfigReconcileUtil::Different(allConfigs.openloopRamp, actual.openloopRamp, eOpenloopRamp, 0, report)) errorCollection.NewError(ConfigOpenloopRamp(allConfigs.openloopRamp, timeoutMs));
+	if(ConfigReconcileUtil::Different(allConfigs.closedloopRamp, actual.closedloopRamp, eClosedloopRamp, 0, report)) errorCollection.NewError(ConfigClosedloopRamp(allConfigs.closedloopRamp, timeoutMs));
+	if(ConfigReconcileUtil::Different(allConfigs.peakOutputForward, actual.peakOutputForward, ePeakPosOutput, 0, report)) errorCollection.NewError(ConfigPeakOutputForward(allConfigs.peakOutputForward, timeoutMs));
+	if(ConfigReconcileUtil::Different(allConfigs.peakOutputReverse, actual.peakOutputReverse, ePeakNegOutput, 0, report)) errorCollection.NewError(ConfigPeakOutputReverse(allConfigs.peakOutputReverse, timeoutMs));
+	if(ConfigReconcileUtil::Different(allConfigs.nominalOutputForward, actual.nominalOutputForward, eNominalPosOutput, 0, report)) errorCollection.NewError(ConfigNominalOutputForward(allConfigs.nominalOutputForward, timeoutMs));
+	if(ConfigReconcileUtil::Different(allConfigs.nominalOutputReverse, actual.nominalOutputReverse, eNominalNegOutput, 0, report)) errorCollection.NewError(ConfigNominalOutputReverse(allConfigs.nominalOutputReverse, timeoutMs));
+	if(ConfigReconcileUtil::Different(allConfigs.neutralDeadband, actual.neutralDeadband, eNeutralDeadband, 0, report)) errorCollection.NewError(ConfigNeutralDeadband(allConfigs.neutralDeadband, timeoutMs));
+	if(ConfigReconcileUtil::Different(allConfigs.voltageCompSaturation, actual.voltageCompSaturation, eNominalBatteryVoltage, 0, report)) errorCollection.NewError(ConfigVoltageCompSaturation(allConfigs.voltageCompSaturation, timeoutMs));
+	if(ConfigReconcileUtil::Different(allConfigs.voltageMeasurementFilter, actual.voltageMeasurementFilter, eBatteryVoltageFilterSize, 0, report)) errorCollection.NewError(ConfigVoltageMeasurementFilter(allConfigs.voltageMeasurementFilter, timeoutMs));
+	if(ConfigReconcileUtil::Different(allConfigs.velocityMeasurementPeriod, actual.velocityMeasurementPeriod, eSampleVelocityPeriod, 0, report)) errorCollection.NewError(ConfigVelocityMeasurementPeriod(allConfigs.velocityMeasurementPeriod, timeoutMs));
+	if(ConfigReconcileUtil::Different(allConfigs.velocityMeasurementWindow, actual.velocityMeasurementWindow, eSampleVelocityWindow, 0, report)) errorCollection.NewError(ConfigVelocityMeasurementWindow(allConfigs.velocityMeasurementWindow, timeoutMs));
+	if(ConfigReconcileUtil::Different(allConfigs.forwardSoftLimitThreshold, actual.forwardSoftLimitThreshold, eForwardSoftLimitThreshold, 0, report)) errorCollection.NewError(ConfigForwardSoftLimitThreshold(allConfigs.forwardSoftLimitThreshold, timeoutMs));
+	if(ConfigReconcileUtil::Different(allConfigs.reverseSoftLimitThreshold, actual.reverseSoftLimitThreshold, eReverseSoftLimitThreshold, 0, report)) errorCollection.NewError(ConfigReverseSoftLimitThreshold(allConfigs.reverseSoftLimitThreshold, timeoutMs));
+	if(ConfigReconcileUtil::Different(allConfigs.forwardSoftLimitEnable, actual.forwardSoftLimitEnable, eForwardSoftLimitEnable, 0, report)) errorCollection.NewError(ConfigForwardSoftLimitEnable(allConfigs.forwardSoftLimitEnable, timeoutMs));
+	if(ConfigReconcileUtil::Different(allConfigs.reverseSoftLimitEnable, actual.reverseSoftLimitEnable, eReverseSoftLimitEnable, 0, report)) errorCollection.NewError(ConfigReverseSoftLimitEnable(allConfigs.reverseSoftLimitEnable, timeoutMs));
+	if(ConfigReconcileUtil::Different(allConfigs.auxPIDPolarity, actual.auxPIDPolarity, ePIDLoopPolarity, 1, report)) errorCollection.NewError(ConfigAuxPIDPolarity(allConfigs.auxPIDPolarity, timeoutMs));
+	if(ConfigReconcileUtil::Different(allConfigs.motionCruiseVelocity, actual.motionCruiseVelocity, eMotMag_VelCruise, 0, report)) errorCollection.NewError(ConfigMotionCruiseVelocity(allConfigs.motionCruiseVelocity, timeoutMs));
+	if(ConfigReconcileUtil::Different(allConfigs.motionAcceleration, actual.motionAcceleration, eMotMag_Accel, 0, report)) errorCollection.NewError(ConfigMotionAcceleration(allConfigs.motionAcceleration, timeoutMs));
+	if(ConfigReconcileUtil::Different(allConfigs.motionCurveStrength, actual.motionCurveStrength, eMotMag_SCurveLevel, 0, report)) errorCollection.NewError(ConfigMotionSCurveStrength(allConfigs.motionCurveStrength, timeoutMs));
+	if(ConfigReconcileUtil::Different(allConfigs.motionProfileTrajectoryPeriod, actual.motionProfileTrajectoryPeriod, eMotionProfileTrajectoryPointDurationMs, 0, report)) errorCollection.NewError(ConfigMotionProfileTrajectoryPeriod(allConfigs.motionProfileTrajectoryPeriod, timeoutMs));
+	if(ConfigReconcileUtil::Different(allConfigs.feedbackNotContinuous, actual.feedbackNotContinuous, eFeedbackNotContinuous, 0, report)) errorCollection.NewError(ConfigFeedbackNotContinuous(allConfigs.feedbackNotContinuous, timeoutMs));
+	if(ConfigReconcileUtil::Different(allConfigs.remoteSensorClosedLoopDisableNeutralOnLOS, actual.remoteSensorClosedLoopDisableNeutralOnLOS, eRemoteSensorClosedLoopDisableNeutralOnLOS, 0, report)) errorCollection.NewError(ConfigRemoteSensorClosedLoopDisableNeutralOnLOS(allConfigs.remoteSensorClosedLoopDisableNeutralOnLOS, timeoutMs));
+	if(ConfigReconcileUtil::Different(allConfigs.clearPositionOnLimitF, actual.clearPositionOnLimitF, eClearPositionOnLimitF, 0, report)) errorCollection.NewError(ConfigClearPositionOnLimitF(allConfigs.clearPositionOnLimitF, timeoutMs));
+	if(ConfigReconcileUtil::Different(allConfigs.clearPositionOnLimitR, actual.clearPositionOnLimitR, eClearPositionOnLimitR, 0, report)) errorCollection.NewError(ConfigClearPositionOnLimitR(allConfigs.clearPositionOnLimitR, timeoutMs));
+	if(ConfigReconcileUtil::Different(allConfigs.clearPositionOnQuadIdx, actual.clearPositionOnQuadIdx, eClearPositionOnQuadIdx, 0, report)) errorCollection.NewError(ConfigClearPositionOnQuadIdx(allConfigs.clearPositionOnQuadIdx, timeoutMs));
+	if(ConfigReconcileUtil::Different(allConfigs.limitSwitchDisableNeutralOnLOS, actual.limitSwitchDisableNeutralOnLOS, eLimitSwitchDisableNeutralOnLOS, 0, report)) errorCollection.NewError(ConfigLimitSwitchDisableNeutralOnLOS(allConfigs.limitSwitchDisableNeutralOnLOS, timeoutMs));
+	if(ConfigReconcileUtil::Different(allConfigs.softLimitDisableNeutralOnLOS, actual.softLimitDisableNeutralOnLOS, eSoftLimitDisableNeutralOnLOS, 0, report)) errorCollection.NewError(ConfigSoftLimitDisableNeutralOnLOS(allConfigs.softLimitDisableNeutralOnLOS, timeoutMs));
+	if(ConfigReconcileUtil::Different(allConfigs.pulseWidthPeriod_EdgesPerRot, actual.pulseWidthPeriod_EdgesPerRot, ePulseWidthPeriod_EdgesPerRot, 0, report)) errorCollection.NewError(ConfigPulseWidthPeriod_EdgesPerRot(allConfigs.pulseWidthPeriod_EdgesPerRot, timeoutMs));
+	if(ConfigReconcileUtil::Different(allConfigs.pulseWidthPeriod_FilterWindowSz, actual.pulseWidthPeriod_FilterWindowSz, ePulseWidthPeriod_FilterWindowSz, 0, report)) errorCollection.NewError(ConfigPulseWidthPeriod_FilterWindowSz(allConfigs.pulseWidthPeriod_FilterWindowSz, timeoutMs));
+	/* interpolation enable has no readable param, so it is always written */
+	if(ConfigReconcileUtil::Unverified(report)) errorCollection.NewError(ConfigMotionProfileTrajectoryInterpolationEnable(allConfigs.trajectoryInterpolationEnable, timeoutMs));
+
+	//Custom Params
+	if(ConfigReconcileUtil::Different(allConfigs.customParam0, actual.customParam0, eCustomParam, 0, report)) errorCollection.NewError(ConfigSetCustomParam(allConfigs.customParam0, 0, timeoutMs));
+	if(ConfigReconcileUtil::Different(allConfigs.customParam1, actual.customParam1, eCustomParam, 1, report)) errorCollection.NewError(ConfigSetCustomParam(allConfigs.customParam1, 1, timeoutMs));
+
+	errorCollection.NewError(ReconcileFilter(allConfigs.remoteFilter0, actual.remoteFilter0, 0, report, timeoutMs));
+	errorCollection.NewError(ReconcileFilter(allConfigs.remoteFilter1, actual.remoteFilter1, 1, report, timeoutMs));
+
+	errorCollection.NewError(ReconcileSlot(allConfigs.slot0, actual.slot0, 0, report, timeoutMs));
+	errorCollection.NewError(ReconcileSlot(allConfigs.slot1, actual.slot1, 1, report, timeoutMs));
+	errorCollection.NewError(ReconcileSlot(allConfigs.slot2, actual.slot2, 2, report, timeoutMs));
+	errorCollection.NewError(ReconcileSlot(allConfigs.slot3, actual.slot3, 3, report, timeoutMs));
+
+	return errorCollection._worstError;
+}
@@ -16,7 +16,7 @@ TalonSRXConfiguration TalonConfigUtil::_default;
  */
 TalonSRX::TalonSRX(int deviceNumber) :
     BaseMotorController(deviceNumber | 0x02040000) {
-    _sensorColl = new motorcontrol::SensorCollection((void*) m_handle);
+    _sensorColl = new motorcontrol::SensorCollection((void*) m_handle, &GetStatusFrameDemand());
 }
 /**
  *
@@ -310,7 +310,12 @@ ctre::phoenix::ErrorCode TalonSRX::ConfigReverseLimitSwitchSource(
  *            If zero, no blocking or checking is performed.
  */
 ctre::phoenix::ErrorCode TalonSRX::ConfigPeakCurrentLimit(int amps, int timeoutMs) {
-	return c_MotController_ConfigPeakCurrentLimit(m_handle, amps, timeoutMs);
+	ConfigShadow & shadow = Shadow();
+	if (shadow.IsCurrent(ePeakCurrentLimitAmps, 0, amps))
+		return OK;
+	DeviceStats::Call call(GetStats(), __func__, DeviceStats::Call_ConfigSet, timeoutMs);
+	return shadow.RecordWrite(call.Done(c_MotController_ConfigPeakCurrentLimit(m_handle, amps, timeoutMs)),
+			ePeakCurrentLimitAmps, 0, amps, timeoutMs);
 }
 /**
  * Configure the peak allowable duration (when current limit is enabled).
@@ -329,8 +334,12 @@ ctre::phoenix::ErrorCode TalonSRX::ConfigPeakCurrentLimit(int amps, int timeoutM
  *            If zero, no blocking or checking is performed.
  */
 ctre::phoenix::ErrorCode TalonSRX::ConfigPeakCurrentDuration(int milliseconds, int timeoutMs) {
-	return c_MotController_ConfigPeakCurrentDuration(m_handle, milliseconds,
-			timeoutMs);
+	ConfigShadow & shadow = Shadow();
+	if (shadow.IsCurrent(ePeakCurrentLimitMs, 0, milliseconds))
+		return OK;
+	DeviceStats::Call call(GetStats(), __func__, DeviceStats::Call_ConfigSet, timeoutMs);
+	return shadow.RecordWrite(call.Done(c_MotController_ConfigPeakCurrentDuration(m_handle, milliseconds, timeoutMs)),
+			ePeakCurrentLimitMs, 0, milliseconds, timeoutMs);
 }
 /**
  * Configure the continuous allowable current-draw (when current limit is enabled).
@@ -349,7 +358,12 @@ ctre::phoenix::ErrorCode TalonSRX::ConfigPeakCurrentDuration(int milliseconds, i
  *            If zero, no blocking or checking is performed.
  */
 ctre::phoenix::ErrorCode TalonSRX::ConfigContinuousCurrentLimit(int amps, int timeoutMs) {
-	return c_MotController_ConfigContinuousCurrentLimit(m_handle, amps, timeoutMs);
+	ConfigShadow & shadow = Shadow();
+	if (shadow.IsCurrent(eContinuousCurrentLimitAmps, 0, amps))
+		return OK;
+	DeviceStats::Call call(GetStats(), __func__, DeviceStats::Call_ConfigSet, timeoutMs);
+	return shadow.RecordWrite(call.Done(c_MotController_ConfigContinuousCurrentLimit(m_handle, amps, timeoutMs)),
+			eContinuousCurrentLimitAmps, 0, amps, timeoutMs);
 }
 /**
  * Enable or disable Current Limit.
@@ -418,10 +432,10 @@ ErrorCode TalonSRX::ConfigAllSettings(const TalonSRXConfiguration &allConfigs, i
 	errorCollection.NewError(ConfigurePID(allConfigs.primaryPID, 0, timeoutMs, allConfigs.enableOptimizations));
 	errorCollection.NewError(ConfigurePID(allConfigs.auxiliaryPID, 1, timeoutMs, allConfigs.enableOptimizations));
 	if(TalonConfigUtil::ForwardLimitSwitchDifferent(allConfigs))
-		errorCollection.NewError(c_MotController_ConfigForwardLimitSwitchSource(m_handle, allConfigs.forwardLimitSwitchSource,
+		errorCollection.NewError(ConfigLimitSwitchSourceShadowed(0, allConfigs.forwardLimitSwitchSource,
 			allConfigs.forwardLimitSwitchNormal, allConfigs.forwardLimitSwitchDeviceID, timeoutMs));
 	if(TalonConfigUtil::ReverseLimitSwitchDifferent(allConfigs)) 
-		errorCollection.NewError(c_MotController_ConfigReverseLimitSwitchSource(m_handle, allConfigs.reverseLimitSwitchSource,
+		errorCollection.NewError(ConfigLimitSwitchSourceShadowed(1, allConfigs.reverseLimitSwitchSource,
 			allConfigs.reverseLimitSwitchNormal, allConfigs.reverseLimitSwitchDeviceID, timeoutMs));
 	
 	if(TalonConfigUtil::Sum0TermDifferent(allConfigs)) errorCollection.NewError(ConfigSensorTerm(SensorTerm::SensorTerm_Sum0, allConfigs.sum0Term, timeoutMs));
@@ -435,6 +449,77 @@ ErrorCode TalonSRX::ConfigAllSettings(const TalonSRXConfiguration &allConfigs, i
 
     return errorCollection._worstError;
 }
+
+ErrorCode TalonSRX::ReconcilePID(const TalonSRXPIDSetConfiguration &pid, const TalonSRXPIDSetConfiguration &actual, int pidIdx, ConfigReconcileReport &report, int timeoutMs) {
+
+	ErrorCollection errorCollection;
+
+	if(ConfigReconcileUtil::Different(pid.selectedFeedbackCoefficient, actual.selectedFeedbackCoefficient, eSelectedSensorCoefficient, pidIdx, report))
+		errorCollection.NewError(ConfigSelectedFeedbackCoefficient(pid.selectedFeedbackCoefficient, pidIdx, timeoutMs));
+	if(ConfigReconcileUtil::Different(pid.selectedFeedbackSensor, actual.selectedFeedbackSensor, eFeedbackSensorType, pidIdx, report))
+		errorCollection.NewError(ConfigSelectedFeedbackSensor(pid.selectedFeedbackSensor, pidIdx, timeoutMs));
+
+	return errorCollection._worstError;
+}
+
+/**
+ * Configures all peristant settings by reconciling against the device's
+ * actual settings.  The current settings are read back in one batch, then
+ * only the parameters that differ are written.  Unlike ConfigAllSettings,
+ * no factory default is performed, so a device that already holds the
+ * requested settings generates no config writes.
+ *
+ * @param allConfigs        Object with all of the persistant settings
+ * @param report            Report filled with the parameters that were changed
+ * @param timeoutMs
+ *              Timeout value in ms. If nonzero, function will wait for
+ *              config success and report an error if it times out.
+ *              If zero, the readback cannot complete and every
+ *              parameter is written without blocking or checking.
+ *
+ * @return Error Code generated by function. 0 indicates no error.
+ */
+ErrorCode TalonSRX::ConfigReconcileAllSettings(const TalonSRXConfiguration &allConfigs, ConfigReconcileReport &report, int timeoutMs) {
+
+	ErrorCollection errorCollection;
+
+	report.Clear();
+
+	/* read back everything in one batch, params that are not read back are written */
+	TalonSRXConfiguration actual;
+	ConfigReadback readback = GetAllConfigsAsync(actual, timeoutMs);
+	ConfigReconcileUtil::Readback(readback, readback.Wait(), report);
+
+	errorCollection.NewError(BaseReconcileAllSettings(allConfigs, actual, report, timeoutMs));
+
+	//--------PIDs---------------//
+	errorCollection.NewError(ReconcilePID(allConfigs.primaryPID, actual.primaryPID, 0, report, timeoutMs));
+	errorCollection.NewError(ReconcilePID(allConfigs.auxiliaryPID, actual.auxiliaryPID, 1, report, timeoutMs));
+
+	bool fwdSource = ConfigReconcileUtil::Different(allConfigs.forwardLimitSwitchSource, actual.forwardLimitSwitchSource, eLimitSwitchSource, 0, report);
+	bool fwdNormal = ConfigReconcileUtil::Different(allConfigs.forwardLimitSwitchNormal, actual.forwardLimitSwitchNormal, eLimitSwitchNormClosedAndDis, 0, report);
+	bool fwdDevID = ConfigReconcileUtil::Different(allConfigs.forwardLimitSwitchDeviceID, actual.forwardLimitSwitchDeviceID, eLimitSwitchRemoteDevID, 0, report);
+	if(fwdSource || fwdNormal || fwdDevID)
+		errorCollection.NewError(ConfigLimitSwitchSourceShadowed(0, allConfigs.forwardLimitSwitchSource,
+			allConfigs.forwardLimitSwitchNormal, allConfigs.forwardLimitSwitchDeviceID, timeoutMs));
+	bool revSource = ConfigReconcileUtil::Different(allConfigs.reverseLimitSwitchSource, actual.reverseLimitSwitchSource, eLimitSwitchSource, 1, report);
+	bool revNormal = ConfigReconcileUtil::Different(allConfigs.reverseLimitSwitchNormal, actual.reverseLimitSwitchNormal, eLimitSwitchNormClosedAndDis, 1, report);
+	bool revDevID = ConfigReconcileUtil::Different(allConfigs.reverseLimitSwitchDeviceID, actual.reverseLimitSwitchDeviceID, eLimitSwitchRemoteDevID, 1, report);
+	if(revSource || revNormal || revDevID)
+		errorCollection.NewError(ConfigLimitSwitchSourceShadowed(1, allConfigs.reverseLimitSwitchSource,
+			allConfigs.reverseLimitSwitchNormal, allConfigs.reverseLimitSwitchDeviceID, timeoutMs));
+
+	if(ConfigReconcileUtil::Different(allConfigs.sum0Term, actual.sum0Term, eSensorTerm, 0, report)) errorCollection.NewError(ConfigSensorTerm(SensorTerm::SensorTerm_Sum0, allConfigs.sum0Term, timeoutMs));
+	if(ConfigReconcileUtil::Different(allConfigs.sum1Term, actual.sum1Term, eSensorTerm, 1, report)) errorCollection.NewError(ConfigSensorTerm(SensorTerm::SensorTerm_Sum1, allConfigs.sum1Term, timeoutMs));
+	if(ConfigReconcileUtil::Different(allConfigs.diff0Term, actual.diff0Term, eSensorTerm, 2, report)) errorCollection.NewError(ConfigSensorTerm(SensorTerm::SensorTerm_Diff0, allConfigs.diff0Term, timeoutMs));
+	if(ConfigReconcileUtil::Different(allConfigs.diff1Term, actual.diff1Term, eSensorTerm, 3, report)) errorCollection.NewError(ConfigSensorTerm(SensorTerm::SensorTerm_Diff1, allConfigs.diff1Term, timeoutMs));
+
+	if(ConfigReconcileUtil::Different(allConfigs.peakCurrentLimit, actual.peakCurrentLimit, ePeakCurrentLimitAmps, 0, report)) errorCollection.NewError(ConfigPeakCurrentLimit(allConfigs.peakCurrentLimit, timeoutMs));
+	if(ConfigReconcileUtil::Different(allConfigs.peakCurrentDuration, actual.peakCurrentDuration, ePeakCurrentLimitMs, 0, report)) errorCollection.NewError(ConfigPeakCurrentDuration(allConfigs.peakCurrentDuration, timeoutMs));
+	if(ConfigReconcileUtil::Different(allConfigs.continuousCurrentLimit, actual.continuousCurrentLimit, eContinuousCurrentLimitAmps, 0, report)) errorCollection.NewError(ConfigContinuousCurrentLimit(allConfigs.continuousCurrentLimit, timeoutMs));
+
+	return errorCollection._worstError;
+}
 /**
  * Gets all persistant settings.
  *
@@ -467,3 +552,46 @@ void TalonSRX::GetAllConfigs(TalonSRXConfiguration &allConfigs, int timeoutMs) {
 	allConfigs.continuousCurrentLimit  = (int) ConfigGetParameter(eContinuousCurrentLimitAmps, 0, timeoutMs); 
 
 }
+
+/**
+ * Gets all persistant settings using a single batched readback.
+ * All parameter requests are sent immediately, and the returned readback
+ * collects the responses in any order.  The entire readback is bounded by
+ * timeoutMs rather than one timeout per parameter.
+ *
+ * @param allConfigs        Object to fill with all of the persistant settings.
+ *                          Must outlive the returned readback.
+ * @param timeoutMs
+ *              Timeout value in ms for the entire readback.
+ *              If zero, no blocking is performed.
+ *
+ * @return Readback to Poll() or Wait() on.
+ */
+ConfigReadback TalonSRX::GetAllConfigsAsync(TalonSRXConfiguration &allConfigs, int timeoutMs) {
+
+	ConfigReadback readback = NewConfigReadback(timeoutMs);
+
+	BaseGetAllConfigsAsync(readback, allConfigs);
+
+	BaseGetPIDConfigsAsync(readback, allConfigs.primaryPID, 0);
+	readback.Add(eFeedbackSensorType, 0, allConfigs.primaryPID.selectedFeedbackSensor);
+	BaseGetPIDConfigsAsync(readback, allConfigs.auxiliaryPID, 1);
+	readback.Add(eFeedbackSensorType, 1, allConfigs.auxiliaryPID.selectedFeedbackSensor);
+	readback.Add(eSensorTerm, 0, allConfigs.sum0Term);
+	readback.Add(eSensorTerm, 1, allConfigs.sum1Term);
+	readback.Add(eSensorTerm, 2, allConfigs.diff0Term);
+	readback.Add(eSensorTerm, 3, allConfigs.diff1Term);
+
+	readback.Add(eLimitSwitchSource, 0, allConfigs.forwardLimitSwitchSource);
+	readback.Add(eLimitSwitchSource, 1, allConfigs.reverseLimitSwitchSource);
+	readback.Add(eLimitSwitchRemoteDevID, 0, allConfigs.forwardLimitSwitchDeviceID);
+	readback.Add(eLimitSwitchRemoteDevID, 1, allConfigs.reverseLimitSwitchDeviceID);
+	readback.Add(eLimitSwitchNormClosedAndDis, 0, allConfigs.forwardLimitSwitchNormal);
+	readback.Add(eLimitSwitchNormClosedAndDis, 1, allConfigs.reverseLimitSwitchNormal);
+	readback.Add(ePeakCurrentLimitAmps, 0, allConfigs.peakCurrentLimit);
+	readback.Add(ePeakCurrentLimitMs, 0, allConfigs.peakCurrentDuration);
+	readback.Add(eContinuousCurrentLimitAmps, 0, allConfigs.continuousCurrentLimit);
+
+	readback.Send();
+	return readback;
+}
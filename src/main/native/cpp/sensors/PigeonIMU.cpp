@@ -31,6 +31,18 @@
 
 using namespace ctre::phoenix::motorcontrol::can;
 
+/**
+ * Single parameter getter used by batched config readbacks.
+ */
+static ctre::phoenix::ErrorCode GetParamForReadback(void * handle, ctre::phoenix::ParamEnum param, int ordinal, double & value, int timeoutMs) {
+	return c_PigeonIMU_ConfigGetParameter(handle, param, &value, ordinal, timeoutMs);
+}
+static bool PollResetForShadow(void * handle) {
+	bool hasReset = false;
+	c_PigeonIMU_HasResetOccurred(handle, &hasReset);
+	return hasReset;
+}
+
 namespace ctre {
 namespace phoenix {
 namespace sensors {
@@ -76,7 +88,8 @@ void PigeonIMU::DestroyAllPigeonIMUs() {
  * @return Error Code generated by function. 0 indicates no error.
  */
 int PigeonIMU::SetYaw(double angleDeg, int timeoutMs) {
-	int errCode = c_PigeonIMU_SetYaw(_handle, angleDeg, timeoutMs);
+	int errCode = _stats.Record(c_PigeonIMU_SetYaw(_handle, angleDeg, timeoutMs), __func__,
+			DeviceStats::Call_General, timeoutMs);
 	return errCode;
 }
 /**
@@ -90,7 +103,8 @@ int PigeonIMU::SetYaw(double angleDeg, int timeoutMs) {
  * @return Error Code generated by function. 0 indicates no error.
  */
 int PigeonIMU::AddYaw(double angleDeg, int timeoutMs) {
-	int errCode = c_PigeonIMU_AddYaw(_handle, angleDeg, timeoutMs);
+	int errCode = _stats.Record(c_PigeonIMU_AddYaw(_handle, angleDeg, timeoutMs), __func__,
+			DeviceStats::Call_General, timeoutMs);
 	return errCode;
 }
 /**
@@ -103,7 +117,8 @@ int PigeonIMU::AddYaw(double angleDeg, int timeoutMs) {
  * @return Error Code generated by function. 0 indicates no error.
  */
 int PigeonIMU::SetYawToCompass(int timeoutMs) {
-	int errCode = c_PigeonIMU_SetYawToCompass(_handle, timeoutMs);
+	int errCode = _stats.Record(c_PigeonIMU_SetYawToCompass(_handle, timeoutMs), __func__,
+			DeviceStats::Call_General, timeoutMs);
 	return errCode;
 }
 /**
@@ -117,7 +132,8 @@ int PigeonIMU::SetYawToCompass(int timeoutMs) {
  * @return Error Code generated by function. 0 indicates no error.
  */
 int PigeonIMU::SetFusedHeading(double angleDeg, int timeoutMs) {
-	int errCode = c_PigeonIMU_SetFusedHeading(_handle, angleDeg, timeoutMs);
+	int errCode = _stats.Record(c_PigeonIMU_SetFusedHeading(_handle, angleDeg, timeoutMs), __func__,
+			DeviceStats::Call_General, timeoutMs);
 	return errCode;
 }
 /**
@@ -131,7 +147,8 @@ int PigeonIMU::SetFusedHeading(double angleDeg, int timeoutMs) {
  * @return Error Code generated by function. 0 indicates no error.
  */
 int PigeonIMU::SetAccumZAngle(double angleDeg, int timeoutMs) {
-	int errCode = c_PigeonIMU_SetAccumZAngle(_handle, angleDeg, timeoutMs);
+	int errCode = _stats.Record(c_PigeonIMU_SetAccumZAngle(_handle, angleDeg, timeoutMs), __func__,
+			DeviceStats::Call_General, timeoutMs);
 	return errCode;
 }
 /**
@@ -166,8 +183,8 @@ int PigeonIMU::ConfigTemperatureCompensationEnable(bool bTempCompEnable,
  */
 int PigeonIMU::SetTemperatureCompensationDisable(bool bTempCompDisable,
 		int timeoutMs) {
-	int errCode = c_PigeonIMU_SetTemperatureCompensationDisable(_handle,
-			bTempCompDisable, timeoutMs);
+	int errCode = _stats.Record(c_PigeonIMU_SetTemperatureCompensationDisable(_handle,
+			bTempCompDisable, timeoutMs), __func__, DeviceStats::Call_General, timeoutMs);
 	return errCode;
 }
 /**
@@ -181,7 +198,8 @@ int PigeonIMU::SetTemperatureCompensationDisable(bool bTempCompDisable,
  * @return Error Code generated by function. 0 indicates no error.
  */
 int PigeonIMU::AddFusedHeading(double angleDeg, int timeoutMs) {
-	int errCode = c_PigeonIMU_AddFusedHeading(_handle, angleDeg, timeoutMs);
+	int errCode = _stats.Record(c_PigeonIMU_AddFusedHeading(_handle, angleDeg, timeoutMs), __func__,
+			DeviceStats::Call_General, timeoutMs);
 	return errCode;
 }
 /**
@@ -194,7 +212,8 @@ int PigeonIMU::AddFusedHeading(double angleDeg, int timeoutMs) {
  * @return Error Code generated by function. 0 indicates no error.
  */
 int PigeonIMU::SetFusedHeadingToCompass(int timeoutMs) {
-	int errCode = c_PigeonIMU_SetFusedHeadingToCompass(_handle, timeoutMs);
+	int errCode = _stats.Record(c_PigeonIMU_SetFusedHeadingToCompass(_handle, timeoutMs), __func__,
+			DeviceStats::Call_General, timeoutMs);
 	return errCode;
 }
 /**
@@ -209,8 +228,8 @@ int PigeonIMU::SetFusedHeadingToCompass(int timeoutMs) {
  * @return Error Code generated by function. 0 indicates no error.
  */
 int PigeonIMU::SetCompassDeclination(double angleDegOffset, int timeoutMs) {
-	int errCode = c_PigeonIMU_SetCompassDeclination(_handle, angleDegOffset,
-			timeoutMs);
+	int errCode = _stats.Record(c_PigeonIMU_SetCompassDeclination(_handle, angleDegOffset,
+			timeoutMs), __func__, DeviceStats::Call_General, timeoutMs);
 	return errCode;
 }
 /**
@@ -225,7 +244,8 @@ int PigeonIMU::SetCompassDeclination(double angleDegOffset, int timeoutMs) {
  * @return Error Code generated by function. 0 indicates no error.
  */
 int PigeonIMU::SetCompassAngle(double angleDeg, int timeoutMs) {
-	int errCode = c_PigeonIMU_SetCompassAngle(_handle, angleDeg, timeoutMs);
+	int errCode = _stats.Record(c_PigeonIMU_SetCompassAngle(_handle, angleDeg, timeoutMs), __func__,
+			DeviceStats::Call_General, timeoutMs);
 	return errCode;
 }
 //----------------------- Calibration routines -----------------------//
@@ -244,7 +264,8 @@ int PigeonIMU::SetCompassAngle(double angleDeg, int timeoutMs) {
  * @return Error Code generated by function. 0 indicates no error.
  */
 int PigeonIMU::EnterCalibrationMode(CalibrationMode calMode, int timeoutMs) {
-	return c_PigeonIMU_EnterCalibrationMode(_handle, calMode, timeoutMs);
+	return _stats.Record(c_PigeonIMU_EnterCalibrationMode(_handle, calMode, timeoutMs), __func__,
+			DeviceStats::Call_General, timeoutMs);
 }
 /**
  * Get the status of the current (or previousley complete) calibration.
@@ -253,6 +274,33 @@ int PigeonIMU::EnterCalibrationMode(CalibrationMode calMode, int timeoutMs) {
  * @return Error Code generated by function. 0 indicates no error.
  */
 int PigeonIMU::GetGeneralStatus(PigeonIMU::GeneralStatus & statusToFill) {
+	GeneralStatusData data;
+	int errCode = GetGeneralStatus(data);
+
+	statusToFill.currentMode = data.currentMode;
+	statusToFill.calibrationError = data.calibrationError;
+	statusToFill.bCalIsBooting = data.bCalIsBooting;
+	statusToFill.state = data.state;
+	statusToFill.tempC = data.tempC;
+	statusToFill.noMotionBiasCount = data.noMotionBiasCount;
+	statusToFill.tempCompensationCount = data.tempCompensationCount;
+	statusToFill.upTimeSec = data.upTimeSec;
+	statusToFill.lastError = data.lastError;
+	/* an unknown calibration mode leaves the description as it was */
+	if (data.state != UserCalibration || data.description != Description_Unknown)
+		statusToFill.description = GetGeneralStatusDescription(data);
+
+	return errCode;
+}
+/**
+ * Get the status of the current (or previousley complete) calibration,
+ * without building the description text.  Does no heap allocation, so it
+ * is suitable for periodic health checks.
+ *
+ * @param [out] statusToFill Container for the status information.
+ * @return Error Code generated by function. 0 indicates no error.
+ */
+int PigeonIMU::GetGeneralStatus(PigeonIMU::GeneralStatusData & statusToFill) {
 	int state;
 	int currentMode;
 	int calibrationError;
@@ -277,54 +325,77 @@ int PigeonIMU::GetGeneralStatus(PigeonIMU::GeneralStatus & statusToFill) {
 	statusToFill.upTimeSec = upTimeSec;
 	statusToFill.lastError = errCode;
 
-	/* build description string */
+	/* pick description */
 	if (errCode != 0) { // same as NoComm
-		statusToFill.description =
-				"Status frame was not received, check wired connections and Phoenix Tuner.";
+		statusToFill.description = Description_NoComm;
 	} else if (statusToFill.bCalIsBooting) {
-		statusToFill.description =
-				"Pigeon is boot-caling to properly bias accel and gyro.  Do not move Pigeon.  When finished biasing, calibration mode will start.";
+		statusToFill.description = Description_CalIsBooting;
 	} else if (statusToFill.state == UserCalibration) {
 		/* mode specific descriptions */
 		switch (currentMode) {
 		case BootTareGyroAccel:
-			statusToFill.description =
-					"Boot-Calibration: Gyro and Accelerometer are being biased.";
+			statusToFill.description = Description_CalBootTareGyroAccel;
 			break;
 		case Temperature:
-			statusToFill.description =
-					"Temperature-Calibration: Pigeon is collecting temp data and will finish when temp range is reached.  "
-							"Do not move Pigeon.";
+			statusToFill.description = Description_CalTemperature;
 			break;
 		case Magnetometer12Pt:
-			statusToFill.description =
-					"Magnetometer Level 1 calibration: Orient the Pigeon PCB in the 12 positions documented in the User's Manual.";
+			statusToFill.description = Description_CalMagnetometer12Pt;
 			break;
 		case Magnetometer360:
-			statusToFill.description =
-					"Magnetometer Level 2 calibration: Spin robot slowly in 360' fashion.  ";
+			statusToFill.description = Description_CalMagnetometer360;
 			break;
 		case Accelerometer:
-			statusToFill.description =
-					"Accelerometer Calibration: Pigeon PCB must be placed on a level source.  Follow User's Guide for how to level surfacee.  ";
+			statusToFill.description = Description_CalAccelerometer;
+			break;
+		default:
+			statusToFill.description = Description_Unknown;
 			break;
 		}
 	} else if (statusToFill.state == Ready) {
-		/* definitely not doing anything cal-related.  So just instrument the motion driver state */
-		statusToFill.description =
-				"Pigeon is running normally.  Last CAL error code was ";
-		statusToFill.description += std::to_string(calibrationError);
-		statusToFill.description += ".";
+		statusToFill.description = Description_Ready;
 	} else if (statusToFill.state == Initializing) {
-		/* definitely not doing anything cal-related.  So just instrument the motion driver state */
-		statusToFill.description =
-				"Pigeon is boot-caling to properly bias accel and gyro.  Do not move Pigeon.";
+		statusToFill.description = Description_Initializing;
 	} else {
-		statusToFill.description = "Not enough data to determine status.";
+		statusToFill.description = Description_Unknown;
 	}
 
 	return errCode;
 }
+/**
+ * Build the description text of a general status, the same text as
+ * GeneralStatus::description.
+ *
+ * @param status Status filled by GetGeneralStatus().
+ * @return Human-readable description.
+ */
+std::string PigeonIMU::GetGeneralStatusDescription(const PigeonIMU::GeneralStatusData & status) {
+	switch (status.description) {
+	case Description_NoComm:
+		return "Status frame was not received, check wired connections and Phoenix Tuner.";
+	case Description_CalIsBooting:
+		return "Pigeon is boot-caling to properly bias accel and gyro.  Do not move Pigeon.  When finished biasing, calibration mode will start.";
+	case Description_CalBootTareGyroAccel:
+		return "Boot-Calibration: Gyro and Accelerometer are being biased.";
+	case Description_CalTemperature:
+		return "Temperature-Calibration: Pigeon is collecting temp data and will finish when temp range is reached.  "
+				"Do not move Pigeon.";
+	case Description_CalMagnetometer12Pt:
+		return "Magnetometer Level 1 calibration: Orient the Pigeon PCB in the 12 positions documented in the User's Manual.";
+	case Description_CalMagnetometer360:
+		return "Magnetometer Level 2 calibration: Spin robot slowly in 360' fashion.  ";
+	case Description_CalAccelerometer:
+		return "Accelerometer Calibration: Pigeon PCB must be placed on a level source.  Follow User's Guide for how to level surfacee.  ";
+	case Description_Ready:
+		/* definitely not doing anything cal-related.  So just instrument the motion driver state */
+		return "Pigeon is running normally.  Last CAL error code was " + std::to_string(status.calibrationError) + ".";
+	case Description_Initializing:
+		/* definitely not doing anything cal-related.  So just instrument the motion driver state */
+		return "Pigeon is boot-caling to properly bias accel and gyro.  Do not move Pigeon.";
+	default:
+		return "Not enough data to determine status.";
+	}
+}
 //----------------------- General Error status  -----------------------//
 /**
  * Call GetLastError() generated by this object.
@@ -364,6 +435,18 @@ int PigeonIMU::GetYawPitchRoll(double ypr[3]) {
 	int errCode = c_PigeonIMU_GetYawPitchRoll(_handle, ypr);
 	return errCode;
 }
+/**
+ * Gets yaw[0], pitch[1] and roll[2] (in degrees) with the time of the read, see Timestamped.
+ *
+ * @param ypr Caller's value to update.
+ * @return Error Code of the read. 0 indicates the value is fresh.
+ */
+ErrorCode PigeonIMU::GetYawPitchRoll(Timestamped<std::array<double, 3>> & ypr) {
+	std::array<double, 3> param = {};
+	ErrorCode retval = (ErrorCode)c_PigeonIMU_GetYawPitchRoll(_handle, param.data());
+	ypr.Update(param, retval, GetMonotonicUs());
+	return retval;
+}
 /**
  * Get AccumGyro data.
  * AccumGyro is the integrated gyro value on each axis.
@@ -375,6 +458,18 @@ int PigeonIMU::GetAccumGyro(double xyz_deg[3]) {
 	int errCode = c_PigeonIMU_GetAccumGyro(_handle, xyz_deg);
 	return errCode;
 }
+/**
+ * Gets the AccumGyro x[0], y[1] and z[2] (in degrees) with the time of the read, see Timestamped.
+ *
+ * @param xyz_deg Caller's value to update.
+ * @return Error Code of the read. 0 indicates the value is fresh.
+ */
+ErrorCode PigeonIMU::GetAccumGyro(Timestamped<std::array<double, 3>> & xyz_deg) {
+	std::array<double, 3> param = {};
+	ErrorCode retval = (ErrorCode)c_PigeonIMU_GetAccumGyro(_handle, param.data());
+	xyz_deg.Update(param, retval, GetMonotonicUs());
+	return retval;
+}
 /**
  * Get the absolute compass heading.
  * @return compass heading [0,360) degrees.
@@ -467,6 +562,18 @@ int PigeonIMU::GetBiasedAccelerometer(int16_t ba_xyz[3]) {
 	int errCode = c_PigeonIMU_GetBiasedAccelerometer(_handle, ba_xyz);
 	return errCode;
 }
+/**
+ * Gets the biased accelerometer x[0], y[1] and z[2] (Q2.14, 16384 = 1G) with the time of the read, see Timestamped.
+ *
+ * @param ba_xyz Caller's value to update.
+ * @return Error Code of the read. 0 indicates the value is fresh.
+ */
+ErrorCode PigeonIMU::GetBiasedAccelerometer(Timestamped<std::array<int16_t, 3>> & ba_xyz) {
+	std::array<int16_t, 3> param = {};
+	ErrorCode retval = (ErrorCode)c_PigeonIMU_GetBiasedAccelerometer(_handle, param.data());
+	ba_xyz.Update(param, retval, GetMonotonicUs());
+	return retval;
+}
 /**
  * Get Raw Gyro data.
  *
@@ -477,6 +584,18 @@ int PigeonIMU::GetRawGyro(double xyz_dps[3]) {
 	int errCode = c_PigeonIMU_GetRawGyro(_handle, xyz_dps);
 	return errCode;
 }
+/**
+ * Gets the raw gyro x[0], y[1] and z[2] (in degrees per second) with the time of the read, see Timestamped.
+ *
+ * @param xyz_dps Caller's value to update.
+ * @return Error Code of the read. 0 indicates the value is fresh.
+ */
+ErrorCode PigeonIMU::GetRawGyro(Timestamped<std::array<double, 3>> & xyz_dps) {
+	std::array<double, 3> param = {};
+	ErrorCode retval = (ErrorCode)c_PigeonIMU_GetRawGyro(_handle, param.data());
+	xyz_dps.Update(param, retval, GetMonotonicUs());
+	return retval;
+}
 /**
  * Get Accelerometer tilt angles.
  *
@@ -538,6 +657,105 @@ double PigeonIMU::GetFusedHeading() {
 	c_PigeonIMU_GetFusedHeading1(_handle, &fusedHeading);
 	return fusedHeading;
 }
+/**
+ * Gets the fused heading (in degrees) with the time of the read, see Timestamped.
+ *
+ * @param fusedHeading Caller's value to update.
+ * @return Error Code of the read. 0 indicates the value is fresh.
+ */
+ErrorCode PigeonIMU::GetFusedHeading(Timestamped<double> & fusedHeading) {
+	double param = 0;
+	ErrorCode retval = (ErrorCode)c_PigeonIMU_GetFusedHeading1(_handle, &param);
+	fusedHeading.Update(param, retval, GetMonotonicUs());
+	return retval;
+}
+/**
+ * Reads the quaternion, yaw/pitch/roll, raw gyro, AccumGyro, biased
+ * accelerometer and fused heading with its fusion status in one call,
+ * and publishes them as the latest snapshot for GetLastImuSnapshot().
+ *
+ * By default each signal is read once, six reads in all, the same as the
+ * individual getters, and the snapshot is not checked for consistency.
+ *
+ * With maxAttempts above one the quaternion is read again after the other
+ * signals, and the signals are re-read while it changed.  A consistent
+ * snapshot only means no new quaternion frame arrived while the signals
+ * were read, which bounds the read time to one quaternion frame period;
+ * yaw/pitch/roll, gyro, accelerometer and fused heading come from other
+ * status frames with their own periods and ages.  Each attempt then costs
+ * seven reads.
+ *
+ * @param snapshot Caller's snapshot to fill.
+ * @param maxAttempts Most times to read the signals, at least once.
+ * @return First error reading the signals. 0 indicates every signal is fresh.
+ */
+ErrorCode PigeonIMU::GetImuSnapshot(ImuSnapshot & snapshot, int maxAttempts) {
+	void * handle = _handle;
+	_imuSnapshot.Modify([handle, maxAttempts, &snapshot](ImuSnapshot & latest) {
+		std::array<double, 4> wxyz = {};
+		std::array<double, 4> wxyzAfter = {};
+		std::array<double, 3> ypr = {};
+		std::array<double, 3> rawGyro = {};
+		std::array<double, 3> accumGyro = {};
+		std::array<int16_t, 3> biasedAccel = {};
+		double fusedHeading = 0;
+		int bIsFusing = 0, bIsValid = 0, fusionError = 0;
+		ErrorCode erQuat = OK, erYpr = OK, erRawGyro = OK, erAccumGyro = OK, erAccel = OK, erFused = OK;
+
+		int attempts = 0;
+		bool consistent = false;
+		do {
+			++attempts;
+			erQuat = (ErrorCode)c_PigeonIMU_Get6dQuaternion(handle, wxyz.data());
+			erYpr = (ErrorCode)c_PigeonIMU_GetYawPitchRoll(handle, ypr.data());
+			erFused = (ErrorCode)c_PigeonIMU_GetFusedHeading2(handle, &bIsFusing, &bIsValid,
+					&fusedHeading, &fusionError);
+			erRawGyro = (ErrorCode)c_PigeonIMU_GetRawGyro(handle, rawGyro.data());
+			erAccumGyro = (ErrorCode)c_PigeonIMU_GetAccumGyro(handle, accumGyro.data());
+			erAccel = (ErrorCode)c_PigeonIMU_GetBiasedAccelerometer(handle, biasedAccel.data());
+			/* the verification read is only worth its cost when it can trigger a retry */
+			if (maxAttempts > 1) {
+				c_PigeonIMU_Get6dQuaternion(handle, wxyzAfter.data());
+				consistent = (wxyz == wxyzAfter);
+			}
+		} while (!consistent && attempts < maxAttempts);
+
+		int64_t nowUs = GetMonotonicUs();
+		ErrorCollection errorCollection;
+		latest.quaternion.Update(wxyz, erQuat, nowUs);
+		errorCollection.NewError(erQuat);
+		latest.yawPitchRoll.Update(ypr, erYpr, nowUs);
+		errorCollection.NewError(erYpr);
+		latest.fusedHeading.Update(fusedHeading, erFused, nowUs);
+		errorCollection.NewError(erFused);
+		latest.rawGyro.Update(rawGyro, erRawGyro, nowUs);
+		errorCollection.NewError(erRawGyro);
+		latest.accumGyro.Update(accumGyro, erAccumGyro, nowUs);
+		errorCollection.NewError(erAccumGyro);
+		latest.biasedAccelerometer.Update(biasedAccel, erAccel, nowUs);
+		errorCollection.NewError(erAccel);
+
+		/* same rules as GetFusedHeading(FusionStatus&) */
+		latest.isFusing = (erFused == OK) && bIsFusing;
+		latest.isFusionValid = (erFused == OK) && bIsValid;
+		latest.consistent = consistent;
+		latest.attempts = attempts;
+		latest.snapshotUs = nowUs;
+		latest.error = errorCollection._worstError;
+		snapshot = latest;
+	});
+	return snapshot.error;
+}
+/**
+ * Copies the snapshot last taken by GetImuSnapshot() without any reads.
+ * Lock-free and consistent, so another thread (such as a logger) can
+ * read while GetImuSnapshot() runs.
+ *
+ * @param snapshot Caller's snapshot to fill.
+ */
+void PigeonIMU::GetLastImuSnapshot(ImuSnapshot & snapshot) const {
+	_imuSnapshot.Read(snapshot);
+}
 //----------------------- Startup/Reset status -----------------------//
 /**
  * Use HasResetOccurred() instead.
@@ -564,9 +782,53 @@ uint32_t PigeonIMU::GetFirmVers() {
  * @return true iff a reset has occurred since last call.
  */
 bool PigeonIMU::HasResetOccurred() {
-	bool retval = false;
-	c_PigeonIMU_HasResetOccurred(_handle, &retval);
-	return retval;
+	_configShadow.PollReset(_handle, &PollResetForShadow);
+	/* include any reset consumed by the config shadow */
+	return _configShadow.TakeReset();
+}
+/**
+ * @return config shadow, invalidated first if the device has reset.
+ */
+ConfigShadow & PigeonIMU::Shadow() {
+	return _configShadow.Checked(_handle, &PollResetForShadow);
+}
+/**
+ * Enables the client-side config shadow, see ConfigShadow.
+ *
+ * @param enable
+ *            true to enable the shadow, false to disable and clear it.
+ * @param maxAgeMs
+ *            Entries older than this are read from the device again.
+ *            Zero to keep entries until the device resets.
+ */
+void PigeonIMU::EnableConfigShadow(bool enable, int maxAgeMs) {
+	_configShadow.Enable(enable, maxAgeMs);
+}
+/**
+ * Clears the config shadow so the next config reads go to the device.
+ */
+void PigeonIMU::InvalidateConfigShadow() {
+	_configShadow.Invalidate();
+}
+/**
+ * @return Checksum over the config shadow. Compare against a previously
+ *         saved checksum to detect that the shadowed configuration changed.
+ */
+uint32_t PigeonIMU::GetConfigShadowChecksum() {
+	return Shadow().GetChecksum();
+}
+/**
+ * Reads back every shadowed parameter in a single batch and drops any entry
+ * that no longer matches the device, so the next write of it goes through.
+ *
+ * @param mismatches
+ *            Filled with the number of shadowed parameters that did not match.
+ * @param timeoutMs
+ *            Timeout value in ms for the entire readback.
+ * @return Error Code generated by function. 0 indicates every parameter was read.
+ */
+ErrorCode PigeonIMU::VerifyConfigShadow(int & mismatches, int timeoutMs) {
+	return Shadow().Verify(_handle, &GetParamForReadback, timeoutMs, mismatches);
 }
 
 /**
@@ -627,8 +889,11 @@ std::string PigeonIMU::ToString(CalibrationMode cm) {
  */
 ErrorCode PigeonIMU::ConfigSetCustomParam(int newValue, int paramIndex,
 		int timeoutMs) {
-	return c_PigeonIMU_ConfigSetCustomParam(_handle, newValue, paramIndex,
-			timeoutMs);
+	if (Shadow().IsCurrent(eCustomParam, paramIndex, newValue))
+		return OK;
+	DeviceStats::Call call(_stats, __func__, DeviceStats::Call_ConfigSet, timeoutMs);
+	return _configShadow.RecordWrite(call.Done(c_PigeonIMU_ConfigSetCustomParam(_handle, newValue, paramIndex, timeoutMs)),
+			eCustomParam, paramIndex, newValue, timeoutMs);
 }
 /**
  * Gets the value of a custom parameter. This is for arbitrary use.
@@ -646,9 +911,13 @@ ErrorCode PigeonIMU::ConfigSetCustomParam(int newValue, int paramIndex,
  * @return Value of the custom param.
  */
 int PigeonIMU::ConfigGetCustomParam(int paramIndex, int timeoutMs) {
-	int readValue;
-	c_PigeonIMU_ConfigGetCustomParam(_handle, &readValue, paramIndex,
-			timeoutMs);
+	double shadowed = 0;
+	if (Shadow().Get(eCustomParam, paramIndex, shadowed))
+		return (int) shadowed;
+	int readValue = 0;
+	DeviceStats::Call call(_stats, __func__, DeviceStats::Call_ConfigGet, timeoutMs);
+	ErrorCode retval = call.Done(c_PigeonIMU_ConfigGetCustomParam(_handle, &readValue, paramIndex, timeoutMs));
+	_configShadow.RecordRead(retval, eCustomParam, paramIndex, readValue);
 	return readValue;
 }
 /**
@@ -674,9 +943,15 @@ int PigeonIMU::ConfigGetCustomParam(int paramIndex, int timeoutMs) {
  */
 ErrorCode PigeonIMU::ConfigSetParameter(ctre::phoenix::ParamEnum param, double value,
 		uint8_t subValue, int ordinal, int timeoutMs) {
-	return c_PigeonIMU_ConfigSetParameter(_handle, param, value, subValue,
-			ordinal, timeoutMs);
-
+	/* sub value is not shadowed, so only plain writes can be skipped */
+	if (subValue == 0 && Shadow().IsCurrent(param, ordinal, value))
+		return OK;
+	DeviceStats::Call call(_stats, __func__, DeviceStats::Call_ConfigSet, timeoutMs);
+	ErrorCode retval = call.Done(c_PigeonIMU_ConfigSetParameter(_handle, param, value, subValue, ordinal, timeoutMs));
+	if (subValue == 0)
+		return _configShadow.RecordWrite(retval, param, ordinal, value, timeoutMs);
+	_configShadow.Invalidate(param, ordinal);
+	return retval;
 }
 /**
  * Gets a parameter. Generally this is not used.
@@ -698,7 +973,11 @@ ErrorCode PigeonIMU::ConfigSetParameter(ctre::phoenix::ParamEnum param, double v
 double PigeonIMU::ConfigGetParameter(ctre::phoenix::ParamEnum param, int ordinal,
 		int timeoutMs) {
 	double value = 0;
-	c_PigeonIMU_ConfigGetParameter(_handle, param, &value, ordinal, timeoutMs);
+	if (Shadow().Get(param, ordinal, value))
+		return value;
+	DeviceStats::Call call(_stats, __func__, DeviceStats::Call_ConfigGet, timeoutMs);
+	ErrorCode retval = call.Done(c_PigeonIMU_ConfigGetParameter(_handle, param, &value, ordinal, timeoutMs));
+	_configShadow.RecordRead(retval, param, ordinal, value);
 	return value;
 }
 
@@ -730,7 +1009,8 @@ double PigeonIMU::ConfigGetParameter(ctre::phoenix::ParamEnum param, int ordinal
 ErrorCode PigeonIMU::ConfigGetParameter(ParamEnum param, int32_t valueToSend,
             int32_t & valueReceived, uint8_t & subValue, int32_t ordinal,
             int32_t timeoutMs) {
-	return c_PigeonIMU_ConfigGetParameter_6(_handle, param, valueToSend, &valueReceived, &subValue, ordinal, timeoutMs);
+	DeviceStats::Call call(_stats, __func__, DeviceStats::Call_ConfigGet, timeoutMs);
+	return call.Done(c_PigeonIMU_ConfigGetParameter_6(_handle, param, valueToSend, &valueReceived, &subValue, ordinal, timeoutMs));
 }
 
 //------ Frames ----------//
@@ -749,8 +1029,8 @@ ErrorCode PigeonIMU::ConfigGetParameter(ParamEnum param, int32_t valueToSend,
  */
 ErrorCode PigeonIMU::SetStatusFramePeriod(PigeonIMU_StatusFrame statusFrame,
 	    uint8_t periodMs, int timeoutMs) {
-	return c_PigeonIMU_SetStatusFramePeriod(_handle, statusFrame, periodMs,
-			timeoutMs);
+	return _stats.Record(c_PigeonIMU_SetStatusFramePeriod(_handle, statusFrame, periodMs,
+			timeoutMs), __func__, DeviceStats::Call_General, timeoutMs);
 }
 /**
  * Gets the period of the given status frame.
@@ -780,7 +1060,7 @@ int PigeonIMU::GetStatusFramePeriod(PigeonIMU_StatusFrame frame,
  */
 ErrorCode PigeonIMU::SetControlFramePeriod(PigeonIMU_ControlFrame frame,
 		int periodMs) {
-	return c_PigeonIMU_SetControlFramePeriod(_handle, frame, periodMs);
+	return _stats.Record(c_PigeonIMU_SetControlFramePeriod(_handle, frame, periodMs), __func__);
 }
 //------ Firmware ----------//
 /**
@@ -804,7 +1084,7 @@ int PigeonIMU::GetFirmwareVersion() {
  */
 ErrorCode PigeonIMU::GetFaults(PigeonIMU_Faults & toFill) {
 	int faultBits;
-	ErrorCode retval = c_PigeonIMU_GetFaults(_handle, &faultBits);
+	ErrorCode retval = _stats.Record(c_PigeonIMU_GetFaults(_handle, &faultBits), __func__);
 	toFill = PigeonIMU_Faults(faultBits);
 	return retval;
 }
@@ -817,7 +1097,7 @@ ErrorCode PigeonIMU::GetFaults(PigeonIMU_Faults & toFill) {
  */
 ErrorCode PigeonIMU::GetStickyFaults(PigeonIMU_StickyFaults & toFill) {
 	int faultBits;
-	ErrorCode retval = c_PigeonIMU_GetFaults(_handle, &faultBits);
+	ErrorCode retval = _stats.Record(c_PigeonIMU_GetFaults(_handle, &faultBits), __func__);
 	toFill = PigeonIMU_StickyFaults(faultBits);
 	return retval;
 }
@@ -827,7 +1107,8 @@ ErrorCode PigeonIMU::GetStickyFaults(PigeonIMU_StickyFaults & toFill) {
  * @return Error Code generated by function. 0 indicates no error.
  */
 ErrorCode PigeonIMU::ClearStickyFaults(int timeoutMs) {
-	return c_PigeonIMU_ClearStickyFaults(_handle, timeoutMs);
+	return _stats.Record(c_PigeonIMU_ClearStickyFaults(_handle, timeoutMs), __func__,
+			DeviceStats::Call_General, timeoutMs);
 }
 
 /**
@@ -869,6 +1150,31 @@ void PigeonIMU::GetAllConfigs(PigeonIMUConfiguration &allConfigs, int timeoutMs)
 	allConfigs.customParam1 = (int) ConfigGetParameter(eCustomParam, 1,  timeoutMs); 
 }
 
+/**
+ * Gets all persistant settings using a single batched readback.
+ * All parameter requests are sent immediately, and the returned readback
+ * collects the responses in any order.  The entire readback is bounded by
+ * timeoutMs rather than one timeout per parameter.
+ *
+ * @param allConfigs        Object to fill with all of the persistant settings.
+ *                          Must outlive the returned readback.
+ * @param timeoutMs
+ *              Timeout value in ms for the entire readback.
+ *              If zero, no blocking is performed.
+ *
+ * @return Readback to Poll() or Wait() on.
+ */
+ConfigReadback PigeonIMU::GetAllConfigsAsync(PigeonIMUConfiguration &allConfigs, int timeoutMs) {
+
+	ConfigReadback readback(_handle, &GetParamForReadback, timeoutMs);
+
+	readback.Add(eCustomParam, 0, allConfigs.customParam0);
+	readback.Add(eCustomParam, 1, allConfigs.customParam1);
+
+	readback.Send();
+	return readback;
+}
+
 /**
  * Configures all peristant settings to defaults.
  *
@@ -880,7 +1186,9 @@ void PigeonIMU::GetAllConfigs(PigeonIMUConfiguration &allConfigs, int timeoutMs)
  * @return Error Code generated by function. 0 indicates no error. 
  */
 ErrorCode PigeonIMU::ConfigFactoryDefault(int timeoutMs) {
-    return c_PigeonIMU_ConfigFactoryDefault(_handle, timeoutMs);
+	_configShadow.Invalidate();
+	DeviceStats::Call call(_stats, __func__, DeviceStats::Call_ConfigSet, timeoutMs);
+	return call.Done(c_PigeonIMU_ConfigFactoryDefault(_handle, timeoutMs));
 }
 
 
@@ -4,13 +4,20 @@
 #define Phoenix_WPI
 #endif
 
+#include "ctre/phoenix/CANBusPlanner.h"
 #include "ctre/phoenix/CANifier.h"
+#include "ctre/phoenix/ConfigEngine.h"
+#include "ctre/phoenix/DeviceStats.h"
 #include "ctre/phoenix/ErrorCode.h"
 #include "ctre/phoenix/paramEnum.h"
 #include "ctre/phoenix/HsvToRgb.h"
 #include "ctre/phoenix/LinearInterpolation.h"
 #include "ctre/phoenix/motion/BufferedTrajectoryPointStream.h"
+#include "ctre/phoenix/motion/MotionProfileFeeder.h"
+#include "ctre/phoenix/motion/MotionProfileGroup.h"
 #include "ctre/phoenix/motion/MotionProfileStatus.h"
+#include "ctre/phoenix/motion/TrajectoryFile.h"
+#include "ctre/phoenix/motion/TrajectoryGenerator.h"
 #include "ctre/phoenix/motion/TrajectoryPoint.h"
 #include "ctre/phoenix/motorcontrol/can/TalonSRX.h"
 #include "ctre/phoenix/motorcontrol/can/VictorSPX.h"
@@ -20,9 +27,16 @@
 #include "ctre/phoenix/motorcontrol/IMotorController.h"
 #include "ctre/phoenix/motorcontrol/IMotorControllerEnhanced.h"
 #include "ctre/phoenix/motorcontrol/InvertType.h"
+#include "ctre/phoenix/motorcontrol/MotorGroup.h"
+#include "ctre/phoenix/motorcontrol/OutputTransaction.h"
+#include "ctre/phoenix/motorcontrol/ScaledMotorController.h"
 #include "ctre/phoenix/motorcontrol/SensorCollection.h"
+#include "ctre/phoenix/motorcontrol/SensorHistory.h"
+#include "ctre/phoenix/motorcontrol/StatusFramePeriodManager.h"
+#include "ctre/phoenix/motorcontrol/StatusFrameSubscriber.h"
 #include "ctre/phoenix/sensors/PigeonIMU.h"
 #include "ctre/phoenix/signals/MovingAverage.h"
+#include "ctre/phoenix/Units.h"
 #include "ctre/phoenix/tasking/Schedulers/ConcurrentScheduler.h"
 #include "ctre/phoenix/tasking/ILoopable.h"
 #include "ctre/phoenix/tasking/IProcessable.h"
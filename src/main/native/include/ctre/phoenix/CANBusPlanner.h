@@ -0,0 +1,186 @@
+#pragma once
+
+#include <stdint.h>
+#include <functional>
+#include <string>
+#include <vector>
+#include "ctre/phoenix/ErrorCode.h"
+
+/* forward proto's */
+namespace ctre {
+namespace phoenix {
+class CANifier;
+namespace motorcontrol {
+namespace can {
+class BaseMotorController;
+}
+}
+namespace sensors {
+class PigeonIMU;
+}
+}
+}
+
+namespace ctre {
+namespace phoenix {
+
+/**
+ * A periodic frame on the CAN bus, as seen by CANBusPlanner.
+ */
+struct CANBusFrame {
+	/**
+	 * Applies a new period to the device, returns nonzero error code on failure.
+	 */
+	typedef std::function<ErrorCode(int periodMs)> PeriodSetter;
+
+	/**
+	 * Description for reports, such as "TalonSRX 3 status 0x1440"
+	 */
+	std::string name;
+	/**
+	 * Payload length in bytes [0,8]
+	 */
+	int dataBytes = 8;
+	/**
+	 * Period currently configured, in ms
+	 */
+	int periodMs = 10;
+	/**
+	 * Fastest period the planner may assign, in ms
+	 */
+	int minPeriodMs = 1;
+	/**
+	 * Slowest period the planner may assign, in ms
+	 */
+	int maxPeriodMs = 255;
+	/**
+	 * Higher priority frames are slowed last
+	 */
+	int priority = 0;
+	/**
+	 * Period proposed by the last Plan(), in ms.  0 until planned.
+	 */
+	int plannedPeriodMs = 0;
+	/**
+	 * Applies plannedPeriodMs, empty if the frame cannot be changed
+	 */
+	PeriodSetter setter;
+};
+
+/**
+ * Estimates the CAN bus load of the configured frame periods and proposes
+ * periods that fit a target utilization.
+ *
+ * Every frame is costed as a CAN 2.0B extended frame at 1 Mbps, including the
+ * worst case bit stuffing (one stuff bit per four bits of the stuffed region)
+ * and the interframe space, so the estimate errs on the high side.  An 8 byte
+ * frame costs 160 bits, so a frame every 1ms is 16% of the bus.
+ *
+ * Devices are added with their status frame periods read back from the
+ * device.  Frames not visible to the library (such as other vendors' devices
+ * or the motion profile control frame) can be added with AddFrame().
+ *
+ * Plan() keeps each frame within its bounds and slows the lowest priority
+ * frames first until the load fits.  Apply() sends the proposed periods.
+ *
+ *	Example:
+ *		CANBusPlanner planner;
+ *		planner.AddMotorController(_talonLeft, 10);
+ *		planner.AddMotorController(_intake, 0);
+ *		planner.AddPigeonIMU(_pigeon, 5);
+ *		if (planner.IsOversubscribed(0.7)) {
+ *			planner.Plan(0.7);
+ *			planner.Apply();
+ *		}
+ */
+class CANBusPlanner {
+public:
+	/**
+	 * Bus bit rate in bits per second
+	 */
+	static const int kBitRate = 1000000;
+
+	/**
+	 * @brief Add a frame.
+	 * @param frame Frame to add.
+	 * @return Index of the frame in GetFrames().
+	 */
+	int AddFrame(const CANBusFrame & frame);
+	/**
+	 * @brief Add the status frames and general control frame of a Talon SRX or Victor SPX.
+	 * Frames the device reports no period for are skipped.
+	 * @param motor Controller to add, must outlive the planner's use of it.
+	 * @param priority Priority of the controller's frames.
+	 * @param controlPeriodMs Period of the general control frame, as set with SetControlFramePeriod.
+	 * @param timeoutMs Timeout for reading each status frame period.
+	 * @return nonzero error code if no period could be read.
+	 */
+	ErrorCode AddMotorController(motorcontrol::can::BaseMotorController & motor, int priority,
+			int controlPeriodMs = 10, int timeoutMs = 10);
+	/**
+	 * @brief Add the status frames of a Pigeon IMU.
+	 * @param pigeon Pigeon to add, must outlive the planner's use of it.
+	 * @param priority Priority of the Pigeon's frames.
+	 * @param timeoutMs Timeout for reading each status frame period.
+	 * @return nonzero error code if no period could be read.
+	 */
+	ErrorCode AddPigeonIMU(sensors::PigeonIMU & pigeon, int priority, int timeoutMs = 10);
+	/**
+	 * @brief Add the status frames of a CANifier.
+	 * @param canifier CANifier to add, must outlive the planner's use of it.
+	 * @param priority Priority of the CANifier's frames.
+	 * @param timeoutMs Timeout for reading each status frame period.
+	 * @return nonzero error code if no period could be read.
+	 */
+	ErrorCode AddCANifier(CANifier & canifier, int priority, int timeoutMs = 10);
+	/**
+	 * @brief Remove every frame.
+	 */
+	void Clear() { _frames.clear(); }
+	/**
+	 * @return Frames added, whose priority and bounds may be adjusted before Plan().
+	 */
+	std::vector<CANBusFrame> & GetFrames() { return _frames; }
+
+	/**
+	 * @param dataBytes Payload length in bytes [0,8]
+	 * @return Bits on the wire of one extended frame, including worst case stuffing and interframe space.
+	 */
+	static int GetFrameBits(int dataBytes);
+	/**
+	 * @return Bits per second of the configured periods.
+	 */
+	double GetBitsPerSecond() const;
+	/**
+	 * @return Bus utilization of the configured periods, 1.0 is a saturated bus.
+	 */
+	double GetUtilization() const;
+	/**
+	 * @return Bus utilization of the periods proposed by the last Plan().
+	 */
+	double GetPlannedUtilization() const;
+	/**
+	 * @param targetUtilization Utilization not to exceed, such as 0.7.
+	 * @return true if the configured periods exceed the target.
+	 */
+	bool IsOversubscribed(double targetUtilization = 1.0) const;
+	/**
+	 * @brief Propose a period for every frame that fits the target utilization.
+	 * Frames without a setter keep their current period and count toward the load.
+	 * @param targetUtilization Utilization not to exceed, such as 0.7.
+	 * @return nonzero error code if the target cannot be met with every changeable
+	 *         frame at its slowest period.
+	 */
+	ErrorCode Plan(double targetUtilization);
+	/**
+	 * @brief Send the proposed periods to the devices.
+	 * @return Worst error of the frames updated. 0 indicates no error.
+	 */
+	ErrorCode Apply();
+
+private:
+	std::vector<CANBusFrame> _frames;
+};
+
+} // namespace phoenix
+} // namespace ctre
@@ -1,10 +1,15 @@
 #pragma once
 
+#include <array>
 #include <cstdint>
 #include "ctre/phoenix/CANBusAddressable.h"
 #include "ctre/phoenix/CustomParamConfiguration.h"
+#include "ctre/phoenix/ConfigReadback.h"
+#include "ctre/phoenix/ConfigShadow.h"
+#include "ctre/phoenix/DeviceStats.h"
 #include "ctre/phoenix/ErrorCode.h"
 #include "ctre/phoenix/paramEnum.h"
+#include "ctre/phoenix/Timestamped.h"
 #include "ctre/phoenix/CANifierControlFrame.h"
 #include "ctre/phoenix/CANifierStatusFrame.h"
 #include "ctre/phoenix/CANifierStickyFaults.h"
@@ -298,11 +303,25 @@ public:
 	 * @return Position of encoder 
 	 */
 	int GetQuadraturePosition();
+	/**
+	 * Gets the quadrature encoder's position with the time of the read, see Timestamped.
+	 *
+	 * @param position Caller's value to update.
+	 * @return Error Code of the read. 0 indicates the value is fresh.
+	 */
+	ErrorCode GetQuadraturePosition(Timestamped<int> & position);
 	/**
 	 * Gets the quadrature encoder's velocity
 	 * @return Velocity of encoder
 	 */
 	int GetQuadratureVelocity();
+	/**
+	 * Gets the quadrature encoder's velocity with the time of the read, see Timestamped.
+	 *
+	 * @param velocity Caller's value to update.
+	 * @return Error Code of the read. 0 indicates the value is fresh.
+	 */
+	ErrorCode GetQuadratureVelocity(Timestamped<int> & velocity);
 	/**
 	 * Sets the quadrature encoder's position
 	 * @param newPosition  Position to set
@@ -379,6 +398,13 @@ public:
 	 * @return The bus voltage value (in volts).
 	 */
 	double GetBusVoltage();
+	/**
+	 * Gets the bus voltage (in volts) with the time of the read, see Timestamped.
+	 *
+	 * @param busVoltage Caller's value to update.
+	 * @return Error Code of the read. 0 indicates the value is fresh.
+	 */
+	ErrorCode GetBusVoltage(Timestamped<double> & busVoltage);
 	/**
 	 * Call GetLastError() generated by this object.
 	 * Not all functions return an error code but can
@@ -389,6 +415,14 @@ public:
 	 * @return The last ErrorCode generated.
 	 */
 	ErrorCode GetLastError();
+	/**
+	 * Gets the error and latency statistics of this object.  Every config
+	 * call, and every other call that returns an Error Code, is counted by
+	 * Error Code, function and timeout outcome.
+	 *
+	 * @return Statistics of this object, see DeviceStats.
+	 */
+	DeviceStats & GetStats() { return _stats; }
 	/**
 	 * Sets the PWM Output
 	 * Currently supports PWM 0, PWM 1, and PWM 2
@@ -409,6 +443,14 @@ public:
 	 * @param pulseWidthAndPeriod	Double array to hold Duty Cycle [0] and Period [1].
 	 */
 	ErrorCode GetPWMInput(PWMChannel pwmChannel, double pulseWidthAndPeriod[]);
+	/**
+	 * Gets the PWM input duty cycle [0] and period [1] with the time of the read, see Timestamped.
+	 *
+	 * @param pwmChannel PWM channel to get.
+	 * @param pulseWidthAndPeriod Caller's value to update.
+	 * @return Error Code of the read. 0 indicates the value is fresh.
+	 */
+	ErrorCode GetPWMInput(PWMChannel pwmChannel, Timestamped<std::array<double, 2>> & pulseWidthAndPeriod);
 
 	//------ Custom Persistent Params ----------//
 	/**
@@ -543,6 +585,32 @@ public:
 	 * @return Has a Device Reset Occurred?
 	 */
 	bool HasResetOccurred();
+	/**
+	 * Enables the client-side config shadow, see ConfigShadow.
+	 *
+	 * @param enable      true to enable the shadow, false to disable and clear it.
+	 * @param maxAgeMs    Entries older than this are read from the device again.
+	 *                    Zero to keep entries until the device resets.
+	 */
+	void EnableConfigShadow(bool enable, int maxAgeMs = 0);
+	/**
+	 * Clears the config shadow so the next config reads go to the device.
+	 */
+	void InvalidateConfigShadow();
+	/**
+	 * @return Checksum over the config shadow. Compare against a previously
+	 *         saved checksum to detect that the shadowed configuration changed.
+	 */
+	uint32_t GetConfigShadowChecksum();
+	/**
+	 * Reads back every shadowed parameter in a single batch and drops any entry
+	 * that no longer matches the device, so the next write of it goes through.
+	 *
+	 * @param mismatches  Filled with the number of shadowed parameters that did not match.
+	 * @param timeoutMs   Timeout value in ms for the entire readback.
+	 * @return Error Code generated by function. 0 indicates every parameter was read.
+	 */
+	ctre::phoenix::ErrorCode VerifyConfigShadow(int & mismatches, int timeoutMs = 50);
 	/**
 	 * Gets the CANifier fault status
 	 *
@@ -591,6 +659,21 @@ public:
      *              If zero, no blocking or checking is performed.
      */
     void GetAllConfigs(CANifierConfiguration &allConfigs, int timeoutMs = 50);
+    /**
+     * Gets all persistant settings using a single batched readback.
+     * All parameter requests are sent immediately, and the returned readback
+     * collects the responses in any order.  The entire readback is bounded by
+     * timeoutMs rather than one timeout per parameter.
+     *
+	 * @param allConfigs        Object to fill with all of the persistant settings.
+	 *                          Must outlive the returned readback.
+     * @param timeoutMs
+     *              Timeout value in ms for the entire readback.
+     *              If zero, no blocking is performed.
+     *
+     * @return Readback to Poll() or Wait() on.
+     */
+    ctre::phoenix::ConfigReadback GetAllConfigsAsync(CANifierConfiguration &allConfigs, int timeoutMs = 50);
     /**
      * Configures all peristant settings to defaults (overloaded so timeoutMs is 50 ms).
 	 * 
@@ -605,6 +688,9 @@ public:
 
 private:
 	void* m_handle;
+	ctre::phoenix::ConfigShadow _configShadow;
+	ctre::phoenix::DeviceStats _stats;
+	ctre::phoenix::ConfigShadow & Shadow();
 	bool _tempPins[11];
 };// class CANifier 
 
@@ -1,4 +1,5 @@
 #include "ctre/phoenix/ErrorCode.h" // ErrorCode
+#include <stdint.h>
 #include <string>
 
 namespace ctre {
@@ -10,16 +11,72 @@ namespace phoenix {
 class CTRLogger {
 public:
 	/**
-	 * Close the logger
+	 * Close the logger, reporting and writing any outstanding entries
 	 */
 	static void Close();
 	/**
 	 * Logs an entry into the Phoenix DS Error/Logger stream
+	 *
+	 * Entries are reported from a background thread.  Only the first
+	 * occurrence of a (code, dev, func) entry captures a stack trace, and
+	 * repeats are counted and reported at most once per report interval,
+	 * so an error storm costs the caller little more than a counter.
+	 * Once the table of distinct entries is full, new entries are reported
+	 * directly, at most one per report interval.
+	 *
 	 * @param code Error code to log.  If OKAY is passed, no action is taken.
 	 * @param origin Origin string to send to DS/Log
-	 * @return OKAY error code.
+	 * @return code, so callers can return the result directly.
 	 */
 	static ErrorCode Log(ErrorCode code, const char * dev, const char * func);
+	/**
+	 * Sets how often repeats of an entry are reported
+	 * @param intervalMs Minimum time between reports of the same entry
+	 */
+	static void SetReportInterval(int intervalMs);
+	/**
+	 * @return Number of entries not reported because too many distinct entries were logged
+	 *         and another such entry was already reported within the report interval.
+	 */
+	static uint32_t GetDroppedCount();
+	/**
+	 * Also write every logged entry to a file.
+	 *
+	 * Log() only appends a fixed-size record to a ring owned by the calling
+	 * thread; the logger's background thread drains the rings and writes the
+	 * file.  Memory is bounded: a full ring drops records and the number
+	 * dropped is written to the file and counted by GetOverflowCount().
+	 *
+	 * The binary format is little endian: a 24 byte header ("CTRLOG01", the
+	 * wall clock and the monotonic clock in microseconds at open), then
+	 * entries each starting with a one byte tag:
+	 *	'N' name:     uint16 ID, uint8 length, characters (before the first record using the ID)
+	 *	'R' record:   int64 monotonic timestamp us, int32 ErrorCode, uint16 device ID, uint16 function ID
+	 *	'O' overflow: int64 monotonic timestamp us, uint32 records dropped
+	 * Name ID 0 is an unknown name.  Use DecodeFile() to convert it to text.
+	 *
+	 * @param path File to create, replacing any existing file.
+	 * @param binary True for the binary format, false for text.
+	 * @return Error Code generated by function. 0 indicates no error.
+	 */
+	static ErrorCode LogToFile(const char * path, bool binary = true);
+	/**
+	 * Also write every logged entry as text to stderr, see LogToFile().
+	 */
+	static void LogToStderr();
+	/**
+	 * @return Number of entries not written to the file or stderr because a ring was full
+	 */
+	static uint32_t GetOverflowCount();
+	/**
+	 * Convert a binary log file to text, one tab separated line per entry
+	 * (seconds, ErrorCode, device, function).  Entries before a truncated or
+	 * corrupt entry are still converted.
+	 * @param binaryPath File written by LogToFile().
+	 * @param textPath Text file to create, or nullptr for stdout.
+	 * @return Error Code generated by function. 0 indicates no error.
+	 */
+	static ErrorCode DecodeFile(const char * binaryPath, const char * textPath);
 	/**
 	 * Open the logger
 	 * @param language the language you're using
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+#include "ctre/phoenix/ErrorCode.h"
+#include "ctre/phoenix/CANifier.h"
+#include "ctre/phoenix/motorcontrol/can/TalonSRX.h"
+#include "ctre/phoenix/motorcontrol/can/VictorSPX.h"
+#include "ctre/phoenix/sensors/PigeonIMU.h"
+
+namespace ctre {
+namespace phoenix {
+
+/**
+ * Configures many devices at once.
+ *
+ * Each device's ConfigAllSettings blocks on its own config round trips, so
+ * configuring devices one after another takes the sum of all of them.  The
+ * engine instead keeps several devices in flight at once, so total config
+ * time approaches that of the slowest device.
+ *
+ * The number of devices in flight is bounded by a bus-utilization ceiling.
+ * Each in-flight device is budgeted one config request/response pair per
+ * nominal round trip, which over-estimates the load of a real config
+ * sequence, so the ceiling is conservative.
+ *
+ *	Example:
+ *		ConfigEngine engine;
+ *		engine.Add(_talonLeft, leftConfigs);
+ *		engine.Add(_talonRght, rghtConfigs);
+ *		engine.Add(_pigeon, pigeonConfigs);
+ *		engine.Run(50);
+ *		for (const ConfigEngine::Result & result : engine.GetResults()) { ... }
+ */
+class ConfigEngine {
+public:
+	/**
+	 * Outcome of configuring a single device
+	 */
+	struct Result {
+		/**
+		 * Device type, such as "TalonSRX"
+		 */
+		std::string deviceType;
+		/**
+		 * CAN Device ID of the device
+		 */
+		int deviceID;
+		/**
+		 * Errors generated while configuring the device
+		 */
+		ErrorCollection errors;
+		/**
+		 * Time taken to configure the device in ms
+		 */
+		long long int durationMs;
+	};
+
+	ConfigEngine();
+
+	/**
+	 * Add a device and the settings to apply to it.
+	 * The settings are copied, the device must outlive Run().
+	 * @{
+	 */
+	void Add(motorcontrol::can::TalonSRX & talon, const motorcontrol::can::TalonSRXConfiguration & allConfigs);
+	void Add(motorcontrol::can::VictorSPX & victor, const motorcontrol::can::VictorSPXConfiguration & allConfigs);
+	void Add(sensors::PigeonIMU & pigeon, const sensors::PigeonIMUConfiguration & allConfigs);
+	void Add(CANifier & canifier, const CANifierConfiguration & allConfigs);
+	/** @} */
+
+	/**
+	 * Set the fraction of the CAN bus the engine may consume.
+	 * @param ceiling Bus utilization in (0, 1]. Defaults to 0.5.
+	 */
+	void SetBusUtilizationCeiling(double ceiling);
+	/**
+	 * Additionally cap the number of devices configured at once.
+	 * @param maxInFlight Device count, zero for no cap beyond the bus ceiling.
+	 */
+	void SetMaxInFlight(int maxInFlight);
+	/**
+	 * Motor controllers use ConfigReconcileAllSettings, which writes only
+	 * settings that differ from the device, instead of ConfigAllSettings.
+	 * @param reconcile true to reconcile. Defaults to false.
+	 */
+	void SetReconcile(bool reconcile);
+	/**
+	 * @return Number of devices that will be configured at once.
+	 */
+	int GetInFlightLimit() const;
+
+	/**
+	 * Configure every added device, blocking until all are done.
+	 * @param timeoutMs
+	 *              Timeout value in ms passed to each device's config routine.
+	 * @return Worst error across all devices. 0 indicates no error.
+	 */
+	ErrorCode Run(int timeoutMs = 50);
+	/**
+	 * @return Per-device results of the last Run(), in the order devices were added.
+	 */
+	const std::vector<Result> & GetResults() const;
+	/**
+	 * Remove all devices and results.
+	 */
+	void Clear();
+
+private:
+	struct Job {
+		std::function<ErrorCode(int timeoutMs, bool reconcile)> configure;
+		Result result;
+	};
+
+	void AddJob(const std::string & deviceType, int deviceID, std::function<ErrorCode(int, bool)> configure);
+
+	std::vector<Job> _jobs;
+	std::vector<Result> _results;
+	double _busCeiling;
+	int _maxInFlight;
+	bool _reconcile;
+};
+
+} // namespace phoenix
+} // namespace ctre
@@ -0,0 +1,159 @@
+#pragma once
+
+#include <vector>
+#include "ctre/phoenix/ErrorCode.h"
+#include "ctre/phoenix/paramEnum.h"
+#include "ctre/phoenix/Stopwatch.h"
+
+namespace ctre {
+namespace phoenix {
+
+/**
+ * Future-style handle for a batched config readback.
+ *
+ * Every parameter request is transmitted up front, then the responses are
+ * collected in whatever order they arrive.  This bounds the entire readback
+ * by a single timeout instead of one timeout per parameter.
+ *
+ * Devices create these through their GetAllConfigsAsync routines.  The
+ * configuration object passed to GetAllConfigsAsync is filled in as responses
+ * arrive, so it must outlive the readback.
+ *
+ *	Example:
+ *		TalonSRXConfiguration left, right;
+ *		ConfigReadback leftRb = _talonLeft.GetAllConfigsAsync(left, 50);
+ *		ConfigReadback rightRb = _talonRght.GetAllConfigsAsync(right, 50);
+ *		leftRb.Wait();
+ *		rightRb.Wait();
+ */
+class ConfigReadback {
+public:
+	/**
+	 * Low level routine used to request/read a single parameter.
+	 * @param handle Device handle
+	 * @param param Parameter enumeration
+	 * @param ordinal Ordinal of parameter
+	 * @param value Caller's value to fill
+	 * @param timeoutMs Timeout value in ms, zero for non-blocking.
+	 * @return Error Code generated by function. 0 indicates a response was received.
+	 */
+	typedef ErrorCode (*ParamGetter)(void * handle, ParamEnum param, int ordinal, double & value, int timeoutMs);
+
+	/**
+	 * Constructor, typically only called by devices.
+	 * @param handle Device handle passed to getter
+	 * @param getter Routine to read a single parameter
+	 * @param timeoutMs Timeout for the entire readback.  If zero, no blocking
+	 *            is performed and only responses already received are collected.
+	 */
+	ConfigReadback(void * handle, ParamGetter getter, int timeoutMs);
+
+	/**
+	 * Register a parameter to read back.
+	 * @param param Parameter enumeration
+	 * @param ordinal Ordinal of parameter
+	 * @param dest Caller's field to fill once the response arrives
+	 */
+	template <typename T>
+	void Add(ParamEnum param, int ordinal, T & dest) {
+		Entry entry;
+		entry.param = param;
+		entry.ordinal = ordinal;
+		entry.dest = &dest;
+		entry.assign = &Assign<T>;
+		entry.error = SigNotUpdated;
+		entry.received = false;
+		entry.requestedMs = 0;
+		_entries.push_back(entry);
+	}
+	/**
+	 * Transmit all parameter requests and start the timeout.
+	 */
+	void Send();
+	/**
+	 * Collect any responses that have already arrived without blocking.
+	 * Every non-blocking read also transmits the request again, so a
+	 * parameter is re-requested at most once per kRequestIntervalMs
+	 * however often this is called.
+	 * @return true if the readback is done (all responses received or timed out).
+	 */
+	bool Poll();
+	/**
+	 * Block until all responses are received or the timeout elapses.
+	 * @return Worst error of the readback. 0 indicates all parameters were read.
+	 */
+	ErrorCode Wait();
+	/**
+	 * @return true if the readback is done (all responses received or timed out).
+	 */
+	bool IsDone();
+	/**
+	 * @return number of parameters that have not been received yet.
+	 */
+	int GetPendingCount() const;
+	/**
+	 * @return number of parameters in the readback.
+	 */
+	int GetCount() const;
+	/**
+	 * @param index Index of parameter, in the order they were added.
+	 * @return true if the parameter has been received.
+	 */
+	bool IsReceived(int index) const;
+	/**
+	 * @param index Index of parameter, in the order they were added.
+	 * @return Parameter enumeration of the parameter.
+	 */
+	ParamEnum GetParam(int index) const { return _entries[index].param; }
+	/**
+	 * @param index Index of parameter, in the order they were added.
+	 * @return Ordinal of the parameter.
+	 */
+	int GetOrdinal(int index) const { return _entries[index].ordinal; }
+	/**
+	 * @return Worst error of the readback so far.
+	 */
+	ErrorCode GetError() const;
+
+private:
+	struct Entry {
+		ParamEnum param;
+		int ordinal;
+		void * dest;
+		void (*assign)(void * dest, double value);
+		ErrorCode error;
+		bool received;
+		/* time of the last request, relative to Send() */
+		long long int requestedMs;
+	};
+
+	/** Minimum time between requests of the same parameter while polling */
+	static const int kRequestIntervalMs = 10;
+
+	template <typename T>
+	static void Assign(void * dest, double value) {
+		*(T*)dest = (T)(int)value;
+	}
+
+	bool Collect(Entry & entry, int timeoutMs);
+	void Expire();
+	int RemainingMs();
+
+	void * _handle;
+	ParamGetter _getter;
+	int _timeoutMs;
+	int _pending = 0;
+	bool _sent = false;
+	bool _expired = false;
+	Stopwatch _stopwatch;
+	std::vector<Entry> _entries;
+};
+
+/** Floating point params are not truncated to integral values */
+template <>
+inline void ConfigReadback::Assign<double>(void * dest, double value) {
+	*(double*)dest = value;
+}
+
+} // namespace phoenix
+} // namespace ctre
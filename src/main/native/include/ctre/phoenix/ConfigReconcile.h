@@ -0,0 +1,172 @@
+#pragma once
+
+#include <cmath>
+#include <utility>
+#include <vector>
+#include "ctre/phoenix/ConfigReadback.h"
+#include "ctre/phoenix/ErrorCode.h"
+#include "ctre/phoenix/paramEnum.h"
+
+namespace ctre {
+namespace phoenix {
+
+/**
+ * Single parameter written by a reconcile config
+ */
+struct ConfigChange {
+	/**
+	 * Parameter enumeration
+	 */
+	ParamEnum param;
+	/**
+	 * Ordinal of parameter
+	 */
+	int ordinal;
+	/**
+	 * Value read back from the device, meaningless if the param is in unread
+	 */
+	double oldValue;
+	/**
+	 * Requested value that was written
+	 */
+	double newValue;
+};
+
+/**
+ * Report of what a reconcile config (ConfigReconcileAllSettings) changed on the device
+ */
+struct ConfigReconcileReport {
+	/**
+	 * Error reading back the device's current settings.
+	 * If nonzero, the parameters in unread are written without comparing.
+	 */
+	ErrorCode readbackError;
+	/**
+	 * (param, ordinal) of each parameter that was not read back
+	 */
+	std::vector<std::pair<ParamEnum, int>> unread;
+	/**
+	 * Number of parameters compared against the device
+	 */
+	int paramsCompared;
+	/**
+	 * Number of parameters that cannot be read back and are always written
+	 */
+	int paramsUnverified;
+	/**
+	 * Parameters that differed from the device and were written
+	 */
+	std::vector<ConfigChange> changes;
+
+	ConfigReconcileReport() :
+		readbackError(OK),
+		paramsCompared(0),
+		paramsUnverified(0)
+	{
+	}
+	/**
+	 * Reset the report so it can be reused
+	 */
+	void Clear() {
+		readbackError = OK;
+		paramsCompared = 0;
+		paramsUnverified = 0;
+		unread.clear();
+		changes.clear();
+	}
+};
+
+/**
+ * Util class to compare requested settings against the device's actual settings
+ */
+class ConfigReconcileUtil {
+public:
+	/**
+	 * Record the result of reading back the device's settings.
+	 * @param readback Completed readback of the device's settings
+	 * @param error Error Code returned by the readback
+	 * @param report Report to record the readback in
+	 */
+	static void Readback(const ConfigReadback & readback, ErrorCode error, ConfigReconcileReport & report) {
+		report.readbackError = error;
+		for (int i = 0; i < readback.GetCount(); ++i) {
+			if (!readback.IsReceived(i))
+				report.unread.push_back(std::make_pair(readback.GetParam(i), readback.GetOrdinal(i)));
+		}
+	}
+	/**
+	 * Determine if the requested value differs from the device, and record it in the report if so.
+	 * A value that was not read back is treated as different.
+	 * @param desired Requested value
+	 * @param actual Value read back from device
+	 * @param param Parameter enumeration
+	 * @param ordinal Ordinal of parameter
+	 * @param report Report to record the comparison in
+	 * @return if the requested value must be written
+	 */
+	template <typename T>
+	static bool Different(T desired, T actual, ParamEnum param, int ordinal, ConfigReconcileReport & report) {
+		return Record(!(desired == actual), param, ordinal, (double)(long long)desired, (double)(long long)actual,
+				report);
+	}
+	/**
+	 * Floating point params are stored in fixed point on the device, so the readback
+	 * will not exactly match the requested value.  Values within the relative tolerance
+	 * are the same, see IsClose().
+	 */
+	static bool Different(double desired, double actual, ParamEnum param, int ordinal, ConfigReconcileReport & report) {
+		return Record(!IsClose(desired, actual), param, ordinal, desired, actual, report);
+	}
+	/**
+	 * The tolerance is relative to the larger magnitude with no absolute floor, so a
+	 * small gain never compares equal to zero.  A param whose readback is rounded by
+	 * more than the tolerance is written on every reconcile, which is safe.
+	 *
+	 * @param desired Requested value
+	 * @param actual Value read back from device
+	 * @return if the values are the same within the relative tolerance
+	 */
+	static bool IsClose(double desired, double actual) {
+		double scale = std::fmax(std::fabs(desired), std::fabs(actual));
+		return std::fabs(desired - actual) <= kRelativeTolerance * scale;
+	}
+	/**
+	 * Record a parameter that cannot be read back and so is always written.
+	 * @param report Report to record the parameter in
+	 * @return true, as the value must be written
+	 */
+	static bool Unverified(ConfigReconcileReport & report) {
+		++report.paramsUnverified;
+		return true;
+	}
+
+private:
+	static constexpr double kRelativeTolerance = 0.001;
+
+	static bool IsUnread(ParamEnum param, int ordinal, const ConfigReconcileReport & report) {
+		for (const std::pair<ParamEnum, int> & key : report.unread) {
+			if (key.first == param && key.second == ordinal)
+				return true;
+		}
+		return false;
+	}
+
+	static bool Record(bool different, ParamEnum param, int ordinal, double newValue, double oldValue,
+			ConfigReconcileReport & report) {
+		++report.paramsCompared;
+		if (report.readbackError != OK && IsUnread(param, ordinal, report))
+			different = true;
+		if (different) {
+			ConfigChange change;
+			change.param = param;
+			change.ordinal = ordinal;
+			change.oldValue = oldValue;
+			change.newValue = newValue;
+			report.changes.push_back(change);
+		}
+		return different;
+	}
+};
+
+} // namespace phoenix
+} // namespace ctre
@@ -0,0 +1,156 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include "ctre/phoenix/ErrorCode.h"
+#include "ctre/phoenix/paramEnum.h"
+#include "ctre/phoenix/ConfigReadback.h"
+
+namespace ctre {
+namespace phoenix {
+
+/**
+ * Client-side shadow of a device's persistent configuration.
+ *
+ * Each acknowledged config write (nonzero timeout and no error) and each
+ * successful config read is recorded, keyed by parameter and ordinal.
+ * While an entry is fresh, the device's ConfigGetParameter() is served from
+ * the shadow and writing the same value again is skipped without any CAN
+ * traffic.
+ *
+ * The owning device polls for resets through Checked() before using the
+ * shadow, and invalidates it on a factory default.  Disabled by default, see
+ * the device's EnableConfigShadow().
+ */
+class ConfigShadow {
+public:
+	/**
+	 * Routine to poll a device for a reset
+	 * @param handle Device handle
+	 * @return true if the device has reset since the last poll
+	 */
+	typedef bool (*ResetGetter)(void * handle);
+
+	/**
+	 * Poll the device for a reset.  A reset drops every entry and is latched
+	 * for the device's next HasResetOccurred(), see TakeReset().
+	 * @param handle Device handle passed to getter
+	 * @param getter Routine to poll the device
+	 */
+	void PollReset(void * handle, ResetGetter getter);
+	/**
+	 * Poll the device for a reset if the shadow is enabled, so entries from
+	 * before a reset are never served.
+	 * @param handle Device handle passed to getter
+	 * @param getter Routine to poll the device
+	 * @return this shadow
+	 */
+	ConfigShadow & Checked(void * handle, ResetGetter getter);
+	/**
+	 * @return true if a reset was seen since the last call
+	 */
+	bool TakeReset();
+	/**
+	 * @return Number of resets seen since construction
+	 */
+	uint32_t GetResetCount() const;
+	/**
+	 * Enable or disable the shadow.  Disabling also clears it.
+	 * @param enable true to enable the shadow
+	 * @param maxAgeMs Entries older than this are not served. Zero to keep
+	 *            entries until the device resets.
+	 */
+	void Enable(bool enable, int maxAgeMs);
+	/**
+	 * @return true if the shadow is enabled
+	 */
+	bool IsEnabled() const;
+	/**
+	 * Get a parameter from the shadow.
+	 * @param param Parameter enumeration
+	 * @param ordinal Ordinal of parameter
+	 * @param value Caller's value to fill
+	 * @return true if a fresh entry was found
+	 */
+	bool Get(ParamEnum param, int ordinal, double & value);
+	/**
+	 * @param param Parameter enumeration
+	 * @param ordinal Ordinal of parameter
+	 * @param value Value about to be written
+	 * @return true if the device is already known to hold value, so the write can be skipped
+	 */
+	bool IsCurrent(ParamEnum param, int ordinal, double value);
+	/**
+	 * Record the result of a config write.  Only acknowledged writes
+	 * (no error and a nonzero timeout) are recorded, anything else drops the entry.
+	 * @param error Error Code returned by the write
+	 * @param param Parameter enumeration
+	 * @param ordinal Ordinal of parameter
+	 * @param value Value written
+	 * @param timeoutMs Timeout the write was performed with
+	 * @return error, so the caller can return the result directly
+	 */
+	ErrorCode RecordWrite(ErrorCode error, ParamEnum param, int ordinal, double value, int timeoutMs);
+	/**
+	 * Record the result of a config read.
+	 * @param error Error Code returned by the read
+	 * @param param Parameter enumeration
+	 * @param ordinal Ordinal of parameter
+	 * @param value Value read
+	 */
+	void RecordRead(ErrorCode error, ParamEnum param, int ordinal, double value);
+	/**
+	 * Drop every entry.
+	 */
+	void Invalidate();
+	/**
+	 * Drop a single entry.
+	 * @param param Parameter enumeration
+	 * @param ordinal Ordinal of parameter
+	 */
+	void Invalidate(ParamEnum param, int ordinal);
+	/**
+	 * @return number of entries in the shadow
+	 */
+	int GetCount();
+	/**
+	 * Checksum over every entry.  Save this after configuring and
+	 * compare later to detect that the shadowed config has changed.
+	 * @return FNV-1a checksum of the shadow contents
+	 */
+	uint32_t GetChecksum();
+	/**
+	 * Read back every shadowed parameter from the device in a single
+	 * batch and drop any entry that no longer matches.
+	 * @param handle Device handle passed to getter
+	 * @param getter Routine to read a single parameter
+	 * @param timeoutMs Timeout for the entire readback
+	 * @param mismatches Caller's value to fill with the number of dropped entries
+	 * @return Error Code of the readback. 0 indicates every entry was read.
+	 */
+	ErrorCode Verify(void * handle, ConfigReadback::ParamGetter getter, int timeoutMs, int & mismatches);
+
+private:
+	struct Entry {
+		double value;
+		std::chrono::steady_clock::time_point stamp;
+	};
+	typedef std::pair<int, int> Key;
+
+	bool IsFresh(const Entry & entry) const;
+
+	std::mutex _lck;
+	std::map<Key, Entry> _entries;
+	std::atomic<bool> _enabled{false};
+	int _maxAgeMs = 0;
+	std::atomic<bool> _resetLatched{false};
+	std::atomic<uint32_t> _resetCount{0};
+};
+
+} // namespace phoenix
+} // namespace ctre
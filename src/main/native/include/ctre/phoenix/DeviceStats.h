@@ -0,0 +1,249 @@
+#pragma once
+
+#include <atomic>
+#include <stdint.h>
+#include "ctre/phoenix/ErrorCode.h"
+#include "ctre/phoenix/Timestamped.h"
+
+namespace ctre {
+namespace phoenix {
+
+/**
+ * Error and latency statistics of a single device.
+ *
+ * The device records the outcome of each config call, and of each other
+ * call that reports an ErrorCode, with the API function that made it.
+ * Counts are kept by ErrorCode, by function and by timeout outcome, and the
+ * round-trip time of blocking config calls is kept in histograms.
+ *
+ * Storage is fixed at construction and recording is lock-free, so stats are
+ * safe to record and query from any thread.  Queries copy into caller-owned
+ * storage and never allocate, so they can be exported every loop.  Counts are
+ * read individually, so a query racing a call may see it partly counted.
+ *
+ *	Example:
+ *		DeviceStats::TimeoutStats timeouts;
+ *		_talon.GetStats().GetTimeoutStats(timeouts);
+ *		frc::SmartDashboard::PutNumber("Talon timeouts", timeouts.timedOut);
+ */
+class DeviceStats {
+public:
+	/** Number of distinct error codes counted */
+	static const int kMaxErrorCodes = 32;
+	/** Number of distinct API functions counted */
+	static const int kMaxFunctions = 96;
+	/** Number of latency histogram buckets */
+	static const int kLatencyBuckets = 16;
+
+	/**
+	 * Kind of API call
+	 */
+	enum CallType {
+		/** Any call other than a config call */
+		Call_General,
+		/** Config write */
+		Call_ConfigSet,
+		/** Config read */
+		Call_ConfigGet,
+	};
+
+	/**
+	 * Counts of a single API function
+	 */
+	struct FunctionStats {
+		/** Name of the function */
+		const char * function;
+		/** Number of calls */
+		uint32_t calls;
+		/** Calls that returned an error */
+		uint32_t errors;
+		/** Calls that returned a timeout error */
+		uint32_t timeouts;
+		/** Most recent error returned, OK if none */
+		ErrorCode lastError;
+	};
+
+	/**
+	 * Outcomes of calls by timeout
+	 */
+	struct TimeoutStats {
+		/** Calls made with a zero timeout, which do not wait for the device */
+		uint32_t nonBlocking;
+		/** Blocking calls that completed without error */
+		uint32_t completed;
+		/** Blocking calls that timed out (RxTimeout, TxTimeout or SigNotUpdated) */
+		uint32_t timedOut;
+		/** Blocking calls that failed with another error */
+		uint32_t failed;
+	};
+
+	/**
+	 * Round-trip times of blocking config calls.
+	 * Bucket 0 counts calls under 256us, bucket i calls under (256us << i),
+	 * and the last bucket every longer call.
+	 */
+	struct LatencyHistogram {
+		/** Calls per bucket */
+		uint32_t counts[kLatencyBuckets];
+		/** Total calls */
+		uint32_t total;
+		/** Sum of round-trip times in us */
+		int64_t sumUs;
+		/** Longest round-trip time in us */
+		int64_t maxUs;
+	};
+
+	/**
+	 * Times one call and records it when it returns.
+	 *
+	 *	DeviceStats::Call call(_stats, __func__, DeviceStats::Call_ConfigSet, timeoutMs);
+	 *	return call.Done(c_MotController_ConfigOpenLoopRamp(m_handle, secondsFromNeutralToFull, timeoutMs));
+	 */
+	class Call {
+	public:
+		/**
+		 * @param stats Stats to record in
+		 * @param function Name of the API function, must outlive the stats
+		 * @param type Kind of call
+		 * @param timeoutMs Timeout the call is made with
+		 */
+		Call(DeviceStats & stats, const char * function, CallType type, int timeoutMs) :
+				_stats(stats), _function(function), _type(type), _timeoutMs(timeoutMs), _startUs(
+						GetMonotonicUs()) {
+		}
+		/**
+		 * Record the outcome of the call
+		 * @param error Error Code returned by the call
+		 * @return error, so the caller can return the result directly
+		 */
+		ErrorCode Done(ErrorCode error) {
+			_stats.Record(error, _function, _type, _timeoutMs, GetMonotonicUs() - _startUs);
+			return error;
+		}
+	private:
+		DeviceStats & _stats;
+		const char * _function;
+		CallType _type;
+		int _timeoutMs;
+		int64_t _startUs;
+	};
+
+	DeviceStats();
+	DeviceStats(const DeviceStats &) = delete;
+	DeviceStats& operator=(const DeviceStats &) = delete;
+
+	/**
+	 * Record the outcome of a call.
+	 * @param error Error Code returned by the call
+	 * @param function Name of the API function, must outlive the stats
+	 * @param type Kind of call
+	 * @param timeoutMs Timeout the call was made with
+	 * @param latencyUs Round-trip time of the call, negative if not timed
+	 * @return error, so the caller can return the result directly
+	 */
+	ErrorCode Record(ErrorCode error, const char * function, CallType type = Call_General, int timeoutMs = 0,
+			int64_t latencyUs = -1);
+
+	/**
+	 * @return Number of calls recorded
+	 */
+	uint32_t GetCallCount() const;
+	/**
+	 * @param code Error Code to look up
+	 * @return Number of calls that returned the code
+	 */
+	uint32_t GetErrorCount(ErrorCode code) const;
+	/**
+	 * Copy the count of every error code returned so far.
+	 * @param codes Caller's array of codes to fill
+	 * @param counts Caller's array of counts to fill
+	 * @param capacity Size of the caller's arrays
+	 * @return Number of codes filled in
+	 */
+	int GetErrorCounts(ErrorCode * codes, uint32_t * counts, int capacity) const;
+	/**
+	 * @return Worst error returned so far, see ErrorCollection
+	 */
+	ErrorCode GetWorstError() const;
+	/**
+	 * @return Number of API functions recorded, valid indices for GetFunctionStats()
+	 */
+	int GetFunctionCount() const;
+	/**
+	 * @param idx Function index in [0, GetFunctionCount())
+	 * @param stats Caller's stats to fill
+	 * @return true if idx is valid
+	 */
+	bool GetFunctionStats(int idx, FunctionStats & stats) const;
+	/**
+	 * @param function Name of the API function
+	 * @param stats Caller's stats to fill
+	 * @return true if the function has been recorded
+	 */
+	bool GetFunctionStats(const char * function, FunctionStats & stats) const;
+	/**
+	 * @param stats Caller's stats to fill
+	 */
+	void GetTimeoutStats(TimeoutStats & stats) const;
+	/**
+	 * @param type Call_ConfigSet or Call_ConfigGet
+	 * @param histogram Caller's histogram to fill
+	 */
+	void GetLatencyHistogram(CallType type, LatencyHistogram & histogram) const;
+	/**
+	 * @param bucket Histogram bucket
+	 * @return Exclusive upper bound of the bucket in us, or -1 for the last bucket
+	 */
+	static int64_t GetBucketUpperUs(int bucket);
+	/**
+	 * @return Number of calls not counted by error code or function because the tables were full
+	 */
+	uint32_t GetDroppedCount() const;
+	/**
+	 * Zero every count.  Codes and functions seen so far keep their place.
+	 */
+	void Reset();
+
+private:
+	struct CodeSlot {
+		/* ErrorCode of the slot, OK while the slot is free */
+		std::atomic<int32_t> code;
+		std::atomic<uint32_t> count;
+	};
+	struct FunctionSlot {
+		std::atomic<const char *> function;
+		std::atomic<uint32_t> calls;
+		std::atomic<uint32_t> errors;
+		std::atomic<uint32_t> timeouts;
+		std::atomic<int32_t> lastError;
+	};
+	struct Histogram {
+		std::atomic<uint32_t> counts[kLatencyBuckets];
+		std::atomic<uint32_t> total;
+		std::atomic<int64_t> sumUs;
+		std::atomic<int64_t> maxUs;
+	};
+
+	static bool IsTimeout(ErrorCode error);
+	FunctionSlot * FindFunction(const char * function, bool claim);
+	const FunctionSlot * FindFunction(const char * function) const;
+	static void ResetHistogram(Histogram & histogram);
+	static void RecordLatency(Histogram & histogram, int64_t latencyUs);
+
+	std::atomic<uint32_t> _calls;
+	std::atomic<uint32_t> _dropped;
+	CodeSlot _codes[kMaxErrorCodes];
+	FunctionSlot _functions[kMaxFunctions];
+	std::atomic<int> _functionCount;
+	/* slot of each function in claim order, so functions can be queried by index */
+	std::atomic<int> _functionOrder[kMaxFunctions];
+	std::atomic<uint32_t> _nonBlocking;
+	std::atomic<uint32_t> _completed;
+	std::atomic<uint32_t> _timedOut;
+	std::atomic<uint32_t> _failed;
+	Histogram _configSetLatency;
+	Histogram _configGetLatency;
+};
+
+} // namespace phoenix
+} // namespace ctre
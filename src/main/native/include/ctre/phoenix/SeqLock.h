@@ -0,0 +1,72 @@
+#pragma once
+
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <type_traits>
+
+namespace ctre {
+namespace phoenix {
+
+/**
+ * Sequence lock around a plain data structure.
+ *
+ * Readers never block and never block the writer: they copy the data and
+ * retry if a write overlapped the copy, so every read returns a consistent
+ * snapshot.  Writers are serialized with each other.
+ */
+template <typename T>
+class SeqLock {
+	static_assert(std::is_trivially_copyable<T>::value, "SeqLock requires a trivially copyable type");
+public:
+	SeqLock() : _seq(0), _data() {
+	}
+	/**
+	 * Copy out a consistent snapshot.
+	 * @param value Caller's value to fill
+	 */
+	void Read(T & value) const {
+		for (;;) {
+			unsigned before = _seq.load(std::memory_order_acquire);
+			if (before & 1)
+				continue; /* write in progress */
+			std::memcpy(&value, &_data, sizeof(T));
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if (_seq.load(std::memory_order_relaxed) == before)
+				return;
+		}
+	}
+	/**
+	 * Replace the data.
+	 * @param value New value
+	 */
+	void Write(const T & value) {
+		Modify([&value](T & data) { data = value; });
+	}
+	/**
+	 * Modify the data in place.  The modifier is given a copy of the current
+	 * data, which is published once it returns.
+	 * @param modifier Callable taking T&
+	 */
+	template <typename F>
+	void Modify(F modifier) {
+		std::lock_guard<std::mutex> lock(_writeLck);
+		/* only writers touch _data, and we hold the writer lock */
+		T work = _data;
+		modifier(work);
+
+		unsigned seq = _seq.load(std::memory_order_relaxed);
+		_seq.store(seq + 1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		std::memcpy(&_data, &work, sizeof(T));
+		_seq.store(seq + 2, std::memory_order_release);
+	}
+
+private:
+	std::atomic<unsigned> _seq;
+	T _data;
+	std::mutex _writeLck;
+};
+
+} // namespace phoenix
+} // namespace ctre
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <atomic>
+#include <stddef.h>
+#include <vector>
+
+namespace ctre {
+namespace phoenix {
+
+/**
+ * Bounded lock-free queue for exactly one producer thread and one consumer
+ * thread.
+ *
+ * Neither side ever blocks: TryPush fails when the queue is full and TryPop
+ * fails when it is empty.  Storage is allocated once at construction.
+ */
+template <typename T>
+class SpscQueue {
+public:
+	/**
+	 * @param capacity Minimum number of elements held, rounded up to a power of two.
+	 */
+	explicit SpscQueue(size_t capacity) : _head(0), _tail(0) {
+		size_t size = 2;
+		while (size < capacity)
+			size <<= 1;
+		_buffer.resize(size);
+		_mask = size - 1;
+	}
+	SpscQueue(const SpscQueue &) = delete;
+	SpscQueue& operator=(const SpscQueue &) = delete;
+
+	/**
+	 * Append an element.  Producer thread only.
+	 * @param value Element to copy in
+	 * @return false if the queue is full.
+	 */
+	bool TryPush(const T & value) {
+		size_t tail = _tail.load(std::memory_order_relaxed);
+		if (tail - _head.load(std::memory_order_acquire) > _mask)
+			return false;
+		_buffer[tail & _mask] = value;
+		_tail.store(tail + 1, std::memory_order_release);
+		return true;
+	}
+	/**
+	 * Remove the oldest element.  Consumer thread only.
+	 * @param value Caller's element to fill
+	 * @return false if the queue is empty.
+	 */
+	bool TryPop(T & value) {
+		size_t head = _head.load(std::memory_order_relaxed);
+		if (head == _tail.load(std::memory_order_acquire))
+			return false;
+		value = _buffer[head & _mask];
+		_head.store(head + 1, std::memory_order_release);
+		return true;
+	}
+	/**
+	 * @return Number of elements queued, exact only from the producer or consumer thread.
+	 */
+	size_t Size() const {
+		return _tail.load(std::memory_order_acquire) - _head.load(std::memory_order_acquire);
+	}
+	/**
+	 * @return Number of elements the queue can hold.
+	 */
+	size_t Capacity() const {
+		return _mask + 1;
+	}
+
+private:
+	std::vector<T> _buffer;
+	size_t _mask;
+	/* producer and consumer indices on separate cache lines */
+	alignas(64) std::atomic<size_t> _head;
+	alignas(64) std::atomic<size_t> _tail;
+};
+
+} // namespace phoenix
+} // namespace ctre
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <chrono>
+#include <stdint.h>
+#include "ctre/phoenix/ErrorCode.h"
+
+namespace ctre {
+namespace phoenix {
+
+/**
+ * @return Monotonic time in microseconds, the time base of every Timestamped value.
+ */
+inline int64_t GetMonotonicUs() {
+	return std::chrono::duration_cast<std::chrono::microseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * A status signal with the monotonic time of the last fresh read.
+ *
+ * The device layer does not expose status frame receive times, so
+ * timestampUs is the time of the last read that reported the signal fresh
+ * (no error), not the time the frame arrived.  While frames keep arriving,
+ * GetAgeUs() stays near zero however old the frame is, so it detects a lost
+ * signal but is not a frame age for latency compensation.
+ *
+ * changedUs is the time of the first fresh read of the current value.  When
+ * the signal is read faster than its status frame period and the value is
+ * changing, the frame arrived at most one read interval before changedUs.
+ *
+ * Pass the same object on every call: a stale read keeps the previous
+ * timestamps, so the ages keep growing until the frame arrives again.
+ */
+template <typename T>
+struct Timestamped {
+	/**
+	 * Signal value
+	 */
+	T value = T();
+	/**
+	 * Monotonic time (see GetMonotonicUs) of the last fresh read, zero if never
+	 */
+	int64_t timestampUs = 0;
+	/**
+	 * Monotonic time of the first fresh read of the current value, zero if never
+	 */
+	int64_t changedUs = 0;
+	/**
+	 * Error Code of the last read. 0 indicates the value is fresh.
+	 */
+	ErrorCode error = OK;
+
+	/**
+	 * @return Time since the last fresh read in microseconds.
+	 */
+	int64_t GetAgeUs() const {
+		return GetMonotonicUs() - timestampUs;
+	}
+	/**
+	 * @return Time since the value last changed in microseconds.
+	 */
+	int64_t GetChangeAgeUs() const {
+		return GetMonotonicUs() - changedUs;
+	}
+	/**
+	 * Record a read of the signal.
+	 * @param newValue Value read
+	 * @param newError Error Code of the read
+	 * @param nowUs Monotonic time of the read
+	 */
+	void Update(T newValue, ErrorCode newError, int64_t nowUs) {
+		if (newError == OK) {
+			if (changedUs == 0 || !(newValue == value))
+				changedUs = nowUs;
+			timestampUs = nowUs;
+		}
+		value = newValue;
+		error = newError;
+	}
+};
+
+} // namespace phoenix
+} // namespace ctre
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <stdint.h>
+#include <ratio>
+
+namespace ctre {
+namespace phoenix {
+namespace units {
+
+/**
+ * A value tagged with its unit, so values of different units cannot be mixed
+ * up.  Arithmetic is only defined between values of the same unit, and by
+ * plain scalars.  Everything is constexpr and compiles to plain doubles.
+ */
+template <typename Tag>
+class Quantity {
+public:
+	constexpr Quantity() : _value(0) {
+	}
+	constexpr explicit Quantity(double value) : _value(value) {
+	}
+	/**
+	 * @return Value in the quantity's unit
+	 */
+	constexpr double Value() const { return _value; }
+
+	constexpr Quantity operator+(Quantity rhs) const { return Quantity(_value + rhs._value); }
+	constexpr Quantity operator-(Quantity rhs) const { return Quantity(_value - rhs._value); }
+	constexpr Quantity operator-() const { return Quantity(-_value); }
+	constexpr Quantity operator*(double scalar) const { return Quantity(_value * scalar); }
+	constexpr Quantity operator/(double scalar) const { return Quantity(_value / scalar); }
+	constexpr double operator/(Quantity rhs) const { return _value / rhs._value; }
+	constexpr bool operator<(Quantity rhs) const { return _value < rhs._value; }
+	constexpr bool operator>(Quantity rhs) const { return _value > rhs._value; }
+	constexpr bool operator<=(Quantity rhs) const { return _value <= rhs._value; }
+	constexpr bool operator>=(Quantity rhs) const { return _value >= rhs._value; }
+	constexpr bool operator==(Quantity rhs) const { return _value == rhs._value; }
+	constexpr bool operator!=(Quantity rhs) const { return _value != rhs._value; }
+
+private:
+	double _value;
+};
+
+template <typename Tag>
+constexpr Quantity<Tag> operator*(double scalar, Quantity<Tag> quantity) {
+	return quantity * scalar;
+}
+
+struct RotationsTag {};
+struct MetersTag {};
+struct RadiansPerSecondTag {};
+struct MetersPerSecondTag {};
+struct AmpsTag {};
+struct VoltsTag {};
+
+/** Mechanism rotations */
+typedef Quantity<RotationsTag> Rotations;
+/** Linear distance in meters */
+typedef Quantity<MetersTag> Meters;
+/** Mechanism angular velocity in radians per second */
+typedef Quantity<RadiansPerSecondTag> RadiansPerSecond;
+/** Linear velocity in meters per second */
+typedef Quantity<MetersPerSecondTag> MetersPerSecond;
+/** Current in amperes */
+typedef Quantity<AmpsTag> Amps;
+/** Voltage in volts */
+typedef Quantity<VoltsTag> Volts;
+
+/**
+ * Conversions between mechanism units and a sensor's raw units, with the
+ * sensor's scale fixed at compile time so every factor folds to a constant.
+ *
+ * Raw position is in sensor counts and raw velocity in counts per 100ms.
+ *
+ * @tparam CountsPerRotation Sensor counts per sensor rotation, such as 4096 for a CTRE Mag Encoder.
+ * @tparam SensorRotationsPerRotation Sensor rotations per mechanism rotation (gear ratio).
+ * @tparam MetersPerRotation Distance travelled per mechanism rotation, such as the wheel circumference.
+ *
+ *	Example:
+ *		// Mag Encoder on the motor, 10.71:1 gearbox, 6 inch wheel
+ *		typedef SensorScale<4096, std::ratio<1071, 100>, std::ratio<4788, 10000>> DriveScale;
+ *		_talon.Set(ControlMode::Velocity, DriveScale::ToNative(MetersPerSecond(2.5)));
+ */
+template <intmax_t CountsPerRotation, typename SensorRotationsPerRotation = std::ratio<1>,
+		typename MetersPerRotation = std::ratio<1>>
+struct SensorScale {
+	static_assert(CountsPerRotation > 0, "CountsPerRotation must be positive");
+
+	/**
+	 * @return Sensor counts per mechanism rotation
+	 */
+	static constexpr double CountsPerMechanismRotation() {
+		return (double)CountsPerRotation * SensorRotationsPerRotation::num / SensorRotationsPerRotation::den;
+	}
+	/**
+	 * @return Meters per mechanism rotation
+	 */
+	static constexpr double MetersPerMechanismRotation() {
+		return (double)MetersPerRotation::num / MetersPerRotation::den;
+	}
+
+	/**
+	 * @return Raw position of a mechanism position.
+	 */
+	static constexpr double ToNative(Rotations position) {
+		return position.Value() * CountsPerMechanismRotation();
+	}
+	/**
+	 * @return Raw position of a linear position.
+	 */
+	static constexpr double ToNative(Meters position) {
+		return position.Value() * (CountsPerMechanismRotation() / MetersPerMechanismRotation());
+	}
+	/**
+	 * @return Raw velocity of a mechanism angular velocity.
+	 */
+	static constexpr double ToNative(RadiansPerSecond velocity) {
+		return velocity.Value() * (CountsPerMechanismRotation() / (2 * kPi) / 10);
+	}
+	/**
+	 * @return Raw velocity of a linear velocity.
+	 */
+	static constexpr double ToNative(MetersPerSecond velocity) {
+		return velocity.Value() * (CountsPerMechanismRotation() / MetersPerMechanismRotation() / 10);
+	}
+
+	/**
+	 * @return Mechanism position of a raw position.
+	 */
+	static constexpr Rotations ToRotations(double nativePosition) {
+		return Rotations(nativePosition * (1 / CountsPerMechanismRotation()));
+	}
+	/**
+	 * @return Linear position of a raw position.
+	 */
+	static constexpr Meters ToMeters(double nativePosition) {
+		return Meters(nativePosition * (MetersPerMechanismRotation() / CountsPerMechanismRotation()));
+	}
+	/**
+	 * @return Mechanism angular velocity of a raw velocity.
+	 */
+	static constexpr RadiansPerSecond ToRadiansPerSecond(double nativeVelocity) {
+		return RadiansPerSecond(nativeVelocity * (10 * 2 * kPi / CountsPerMechanismRotation()));
+	}
+	/**
+	 * @return Linear velocity of a raw velocity.
+	 */
+	static constexpr MetersPerSecond ToMetersPerSecond(double nativeVelocity) {
+		return MetersPerSecond(nativeVelocity * (10 * MetersPerMechanismRotation() / CountsPerMechanismRotation()));
+	}
+
+private:
+	static constexpr double kPi = 3.14159265358979323846;
+};
+
+template <intmax_t CountsPerRotation, typename SensorRotationsPerRotation, typename MetersPerRotation>
+constexpr double SensorScale<CountsPerRotation, SensorRotationsPerRotation, MetersPerRotation>::kPi;
+
+} // namespace units
+} // namespace phoenix
+} // namespace ctre
@@ -1,13 +1,78 @@
 #pragma once
 #include <stdint.h>
+#include <vector>
 #include "ctre/phoenix/ErrorCode.h"
 #include "ctre/phoenix/cci/BuffTrajPointStream_CCI.h"
 #include "ctre/phoenix/motion/TrajectoryPoint.h"
 namespace ctre {
 	namespace phoenix {
 		namespace motion {
+			/**
+			 * Structure-of-arrays view of trajectory points for bulk writes.
+			 * Every non-null array must hold count elements.  Null arrays
+			 * write zero for that field.
+			 */
+			struct TrajectoryPointArrays {
+				/** Number of points */
+				uint32_t count = 0;
+				/** The positions to servo to (in sensor units). */
+				const double * position = nullptr;
+				/** The velocities to feed-forward (in sensor-units per 100ms). */
+				const double * velocity = nullptr;
+				/** Added to the output of PID[0], should be within [-1,+1] where 0.01 = 1%. */
+				const double * arbFeedFwd = nullptr;
+				/** The positions for auxiliary PID[1] to target (in sensor units). */
+				const double * auxiliaryPos = nullptr;
+				/** The velocities for auxiliary PID[1] to target (in sensor-units per 100ms). */
+				const double * auxiliaryVel = nullptr;
+				/** Added to the output of PID[1], should be within [-1,+1] where 0.01 = 1%. */
+				const double * auxiliaryArbFeedFwd = nullptr;
+				/** Duration of each point in ms.  If null, timeDur is used for every point. */
+				const uint32_t * timeDurs = nullptr;
+				/** Duration in ms applied to every point when timeDurs is null. */
+				uint32_t timeDur = 0;
+				/** Slot for PID[0] gains, applied to every point. */
+				uint32_t profileSlotSelect0 = 0;
+				/** Slot for PID[1] gains, applied to every point. */
+				uint32_t profileSlotSelect1 = 0;
+				/** Use auxiliary PID[1], applied to every point. */
+				bool useAuxPID = false;
+				/** Zero the selected sensor on the first point. */
+				bool zeroPos = false;
+				/** Mark the final point as the last point of the profile. */
+				bool isLastPoint = false;
+			};
+			/**
+			 * Fixed-point resolutions for packed stream storage.
+			 * Each field is the value of one count, so a resolution of 1
+			 * stores whole sensor units.
+			 */
+			struct TrajectoryPointPacking {
+				/** Resolution of position and auxiliaryPos (in sensor units). */
+				double positionResolution = 1;
+				/** Resolution of velocity and auxiliaryVel (in sensor-units per 100ms). */
+				double velocityResolution = 1;
+			};
 			/**
 			 * Stream of trajectory points for Talon/Victor motion profiling.
+			 *
+			 * The motor controller layer has no bulk write, so every point costs one
+			 * call into it whichever Write is used.  The array Writes only save the
+			 * caller's loop; loading a large profile takes as long as before.
+			 *
+			 * By default every Write goes straight to the motor controller layer.
+			 * With staging enabled (see SetStaging) every Write instead keeps the
+			 * points in the stream until Flush(), which StartMotionProfile() calls
+			 * automatically.  Call Flush() before using GetHandle() directly.
+			 * Flush() pays the same one call per point, staging only lets the
+			 * caller pick when.
+			 *
+			 * Staged points can optionally be held in a packed fixed-point
+			 * format (see SetPackedStorage), a third of the size.  This only saves
+			 * memory if the points are decoded as the controller consumes them,
+			 * by a MotionProfileFeeder or MotionProfileGroup.  Flush(), and so
+			 * StartMotionProfile(), decodes every point into the motor controller
+			 * layer's own full-size storage, which costs more than not packing.
 			 */
 			class BufferedTrajectoryPointStream {
 			public:
@@ -26,16 +91,108 @@ namespace ctre {
 				*/
 				ctre::phoenix::ErrorCode Write(const TrajectoryPoint & trajPt);
 				/**
-				* @brief Writes an array of trajectory point into the buffer.
-				* @return nonzero error code if operation fails.
+				* @brief Writes an array of trajectory point into the buffer, one point at a time.
+				* @return nonzero error code if any point fails, the first one reported.
 				*/
 				ctre::phoenix::ErrorCode Write(const TrajectoryPoint * trajPts, uint32_t trajPtCount);
+				/**
+				* @brief Writes a structure-of-arrays view of trajectory points, one point at a time.
+				* While staging, either every point is staged or none is.
+				* @return nonzero error code if any point fails, the first one reported.
+				*/
+				ctre::phoenix::ErrorCode Write(const TrajectoryPointArrays & trajPts);
+				/**
+				 * @brief Keep written points in the stream until Flush().
+				 * Can only be changed while no points are staged.  Disabling
+				 * staging also disables packed storage.
+				 * @param enable true to stage every Write.
+				 * @return nonzero error code if points are still staged.
+				 */
+				ctre::phoenix::ErrorCode SetStaging(bool enable);
+				/**
+				 * @return true if written points are staged.
+				 */
+				bool IsStaging() const { return _staging; }
+				/**
+				 * @brief Pre-size the staging storage so staged writes do not allocate.
+				 * Has no effect while not staging, the motor controller layer's own
+				 * storage cannot be pre-sized.
+				 * @param trajPtCount Number of points to make room for.
+				 */
+				void Reserve(uint32_t trajPtCount);
+				/**
+				 * @brief Hand every staged point to the motor controller layer.
+				 * @return nonzero error code if operation fails.
+				 */
+				ctre::phoenix::ErrorCode Flush();
+				/**
+				 * @brief Hand up to maxTrajPts staged points to the motor controller layer.
+				 * Use this to spread the cost of a large profile across several loops.
+				 * @param maxTrajPts Maximum number of points to hand over.
+				 * @return nonzero error code if operation fails.
+				 */
+				ctre::phoenix::ErrorCode Flush(uint32_t maxTrajPts);
+				/**
+				 * @return Number of points written but not yet flushed.
+				 */
+				uint32_t GetStagedCount() const;
+				/**
+				 * @brief Read back a staged point without consuming it.
+				 * @param index Index of the point, zero being the next point to be flushed.
+				 * @param trajPt Caller's point to fill.
+				 * @return nonzero error code if index is not less than GetStagedCount().
+				 */
+				ctre::phoenix::ErrorCode GetStagedPoint(uint32_t index, TrajectoryPoint & trajPt) const;
+				/**
+				 * @brief Select packed or full-precision storage for staged points.
+				 *
+				 * Packed points hold position and velocity as 32-bit counts of the
+				 * given resolutions, feed-forwards as 16-bit fractions of full scale,
+				 * and flags, slot selects (0-3) and timeDur (up to 65535ms) bit-packed.
+				 * Writes that cannot be represented are rejected with InvalidParamValue.
+				 * Enabling packed storage also enables staging.
+				 * Can only be changed while no points are staged.
+				 * @param enable true for packed storage.
+				 * @param packing Resolutions used while packed.
+				 * @return nonzero error code if points are still staged or the resolutions are not positive.
+				 */
+				ctre::phoenix::ErrorCode SetPackedStorage(bool enable, const TrajectoryPointPacking & packing = TrajectoryPointPacking());
+				/**
+				 * @return true if staged points are held packed.
+				 */
+				bool IsPackedStorage() const { return _packedStorage; }
 				/**
 				 * @return raw handle for resource management.
 				 */
 				void * GetHandle() { return _handle; }
 			private:
+				/** 24 bytes, versus 72 for a TrajectoryPoint */
+				struct PackedTrajectoryPoint {
+					int32_t position;
+					int32_t velocity;
+					int32_t auxiliaryPos;
+					int32_t auxiliaryVel;
+					int16_t arbFeedFwd;
+					int16_t auxiliaryArbFeedFwd;
+					uint16_t timeDur;
+					/** isLastPoint, zeroPos, useAuxPID, then two bits per slot select */
+					uint8_t flags;
+				};
+
+				ctre::phoenix::ErrorCode WriteToHandle(const TrajectoryPoint & trajPt);
+				ctre::phoenix::ErrorCode Stage(const TrajectoryPoint & trajPt);
+				void GetStaged(size_t index, TrajectoryPoint & trajPt) const;
+				size_t GetStagedSize() const;
+				void ClearStaged();
+
 				void * _handle;
+				/** points not yet handed to the handle, starting at _stagedHead */
+				std::vector<TrajectoryPoint> _staged;
+				std::vector<PackedTrajectoryPoint> _packed;
+				size_t _stagedHead = 0;
+				bool _staging = false;
+				bool _packedStorage = false;
+				TrajectoryPointPacking _packing;
 			};
 		} // namespace motion
 	} // namespace phoenix
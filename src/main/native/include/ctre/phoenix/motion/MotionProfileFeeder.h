@@ -0,0 +1,174 @@
+#pragma once
+#include <stdint.h>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "ctre/phoenix/ErrorCode.h"
+#include "ctre/phoenix/motion/BufferedTrajectoryPointStream.h"
+#include "ctre/phoenix/motorcontrol/IMotorController.h"
+
+namespace ctre {
+	namespace phoenix {
+		namespace motion {
+			/**
+			 * Statistics for a single controller serviced by a MotionProfileFeeder
+			 */
+			struct MotionProfileFeederStats {
+				/** Number of ProcessMotionProfileBuffer calls made for the controller. */
+				uint32_t processCalls = 0;
+				/** Times the bottom buffer was found below the low watermark, whether or not
+				 *  the top buffer had points, except while the last point is active. */
+				uint32_t lowWatermarkEvents = 0;
+				/** Times the controller entered underrun while serviced. */
+				uint32_t underrunEvents = 0;
+				/** Bottom buffer count at the last service. */
+				int lastBtmBufferCnt = 0;
+				/** Staged points pushed into the top buffer, when added with a stream. */
+				uint32_t pushedPts = 0;
+			};
+			/**
+			 * Timing statistics of a MotionProfileFeeder's service thread
+			 */
+			struct MotionProfileFeederTiming {
+				/** Number of service ticks run. */
+				uint32_t ticks = 0;
+				/** Ticks that started a full period or more after they were due. */
+				uint32_t missedDeadlines = 0;
+				/** Worst lateness of a tick start in microseconds. */
+				uint32_t maxLatenessUs = 0;
+				/** Mean lateness of a tick start in microseconds. */
+				uint32_t meanLatenessUs = 0;
+				/** Worst time taken to service every controller in microseconds. */
+				uint32_t maxServiceUs = 0;
+			};
+			/**
+			 * Library-owned replacement for calling ProcessMotionProfileBuffer from the
+			 * application's loop.
+			 *
+			 * A single thread wakes at a fixed period and services every added controller
+			 * that is in a motion profile control mode and has points in its top buffer.
+			 * A controller is serviced while its bottom buffer count (btmBufferCnt) is below
+			 * the high watermark; dropping below the low watermark is counted, as it means
+			 * the period is too slow for the profile.  Underrun and thread latency
+			 * statistics are kept for tuning.
+			 *
+			 * The feeder only applies to the legacy PushMotionProfileTrajectory API.
+			 * Profiles started with StartMotionProfile are already streamed in the background.
+			 * A controller added with a stream also has its top buffer refilled from the
+			 * stream's staged points, decoding packed points only as room frees up, so a
+			 * long packed profile never exists in full precision (see SetPackedStorage).
+			 *
+			 *	Example:
+			 *		MotionProfileFeeder feeder;
+			 *		feeder.Add(_talonLeft);
+			 *		feeder.Add(_talonRght);
+			 *		feeder.Start(5);
+			 */
+			class MotionProfileFeeder {
+			public:
+				MotionProfileFeeder();
+				~MotionProfileFeeder();
+				MotionProfileFeeder(const MotionProfileFeeder &) = delete;
+				MotionProfileFeeder& operator=(const MotionProfileFeeder &) = delete;
+
+				/**
+				 * @brief Service a controller.  Safe to call while running.
+				 * The feeder reads the controller's control mode from its own thread,
+				 * which BaseMotorController keeps atomic.
+				 * @param motor Controller to service, must outlive the feeder or be removed.
+				 */
+				void Add(ctre::phoenix::motorcontrol::IMotorController & motor);
+				/**
+				 * @brief Service a controller and refill its top buffer from a stream's
+				 * staged points, see BufferedTrajectoryPointStream::GetStagedPoint.
+				 * Points are pushed while the controller is in a motion profile control
+				 * mode, so set the mode (with Disable output) to begin buffering.
+				 * Safe to call while running.  Re-adding a controller restarts its stream.
+				 * @param motor Controller to service, must outlive the feeder or be removed.
+				 * @param stream Staged points to push, not read by StartMotionProfile
+				 *            and not written or flushed until the controller is removed.
+				 */
+				void Add(ctre::phoenix::motorcontrol::IMotorController & motor, BufferedTrajectoryPointStream & stream);
+				/**
+				 * @brief Stop servicing a controller.  Safe to call while running,
+				 * waits for a service tick in progress.
+				 * @param motor Controller to remove, can be destroyed once this returns.
+				 */
+				void Remove(ctre::phoenix::motorcontrol::IMotorController & motor);
+				/**
+				 * @brief Set the bottom buffer watermarks.
+				 * @param lowWatermark Bottom buffer count below which a low watermark event is counted.
+				 * @param highWatermark Bottom buffer count at or above which the controller is not serviced.
+				 * @return nonzero error code if the watermarks are not ordered.
+				 */
+				ctre::phoenix::ErrorCode SetWatermarks(int lowWatermark, int highWatermark);
+				/**
+				 * @brief Start the service thread.
+				 * @param periodMs Service period, typically half the trajectory point duration.
+				 * @return nonzero error code if already running or the period is not positive.
+				 */
+				ctre::phoenix::ErrorCode Start(int periodMs = 5);
+				/**
+				 * @brief Stop the service thread and wait for it to exit.
+				 */
+				void Stop();
+				/**
+				 * @return true if the service thread is running.
+				 */
+				bool IsRunning() const { return _running; }
+				/**
+				 * @brief Raise the service thread to real-time priority.
+				 * Requires the thread to be running, and on Linux the
+				 * privilege to use SCHED_FIFO.
+				 * @param priority SCHED_FIFO priority on Linux, ignored on Windows
+				 *            where the thread is set to time critical.
+				 * @return nonzero error code if the priority could not be set.
+				 */
+				ctre::phoenix::ErrorCode SetRealTimePriority(int priority);
+				/**
+				 * @brief Get the statistics for a controller.
+				 * @param motor Controller added to the feeder.
+				 * @param stats Caller's stats to fill.
+				 * @return nonzero error code if the controller was not added.
+				 */
+				ctre::phoenix::ErrorCode GetStats(ctre::phoenix::motorcontrol::IMotorController & motor, MotionProfileFeederStats & stats);
+				/**
+				 * @brief Get the timing statistics of the service thread.
+				 * @param timing Caller's timing to fill.
+				 */
+				void GetTiming(MotionProfileFeederTiming & timing);
+				/**
+				 * @brief Zero every statistic.
+				 */
+				void ClearStats();
+
+			private:
+				struct Entry {
+					ctre::phoenix::motorcontrol::IMotorController * motor;
+					BufferedTrajectoryPointStream * stream;
+					uint32_t nextIndex;
+					MotionProfileFeederStats stats;
+					bool wasUnderrun;
+				};
+
+				void AddEntry(ctre::phoenix::motorcontrol::IMotorController & motor, BufferedTrajectoryPointStream * stream);
+				void Run(int periodMs);
+				void Service(Entry & entry, int lowWatermark, int highWatermark);
+
+				/** held by the service thread across CAN calls, and to change _entries */
+				std::mutex _serviceLck;
+				/** guards statistics, watermarks and _entries */
+				std::mutex _lck;
+				std::vector<Entry> _entries;
+				MotionProfileFeederTiming _timing;
+				uint64_t _latenessSumUs = 0;
+				int _lowWatermark = 2;
+				int _highWatermark = 8;
+
+				std::thread _thread;
+				std::atomic<bool> _running;
+			};
+		} // namespace motion
+	} // namespace phoenix
+} // namespace ctre
@@ -0,0 +1,123 @@
+#pragma once
+#include <stdint.h>
+#include <vector>
+#include "ctre/phoenix/ErrorCode.h"
+#include "ctre/phoenix/motion/BufferedTrajectoryPointStream.h"
+#include "ctre/phoenix/motorcontrol/IMotorController.h"
+
+namespace ctre {
+	namespace phoenix {
+		namespace motion {
+			/**
+			 * Start result of a single axis in a MotionProfileGroup
+			 */
+			struct MotionProfileAxisStart {
+				/** First error generated for the axis. 0 indicates no error. */
+				ctre::phoenix::ErrorCode error = OK;
+				/** Time the axis was enabled, relative to the first axis, in microseconds. */
+				uint32_t releaseOffsetUs = 0;
+				/**
+				 * Time the axis reported an active enabled point, relative to the first
+				 * axis to report one, in microseconds.  -1 if not observed before the timeout.
+				 * Resolution is the period of the controller's motion profile status frame.
+				 */
+				int32_t startSkewUs = -1;
+			};
+			/**
+			 * Starts the motion profiles of several controllers together.
+			 *
+			 * StartMotionProfile starts each controller as soon as its own points are
+			 * buffered, so axes started one after another drift apart by however long
+			 * each call takes.  The group instead holds every axis disabled while it
+			 * fills each controller's firmware (bottom) buffer to minBufferedPts, then
+			 * enables every axis back to back, so all enables land in the same control
+			 * frame period.  An axis is released only once its controller reports
+			 * the disabled hold.
+			 *
+			 * Points are read from each stream's staged points (see
+			 * BufferedTrajectoryPointStream::GetStagedPoint) without consuming them, so
+			 * the same streams can be started again.  Enable staging on each stream
+			 * before filling it, then any Write, TrajectoryFile::WriteTo or
+			 * TrajectoryGenerator::WriteTo can be used (see Add).
+			 * After Start, call Process() periodically (or from a background thread) to
+			 * keep streaming the remaining points.
+			 *
+			 *	Example:
+			 *		_leftStream.SetStaging(true);
+			 *		_rghtStream.SetStaging(true);
+			 *		_leftFile.WriteTo(_leftStream);
+			 *		_rghtFile.WriteTo(_rghtStream);
+			 *		MotionProfileGroup group;
+			 *		group.Add(_talonLeft, _leftStream);
+			 *		group.Add(_talonRght, _rghtStream);
+			 *		group.Start(10, ControlMode::MotionProfile, 100);
+			 *		...
+			 *		group.Process();	// every loop until group.IsFinished()
+			 */
+			class MotionProfileGroup {
+			public:
+				/**
+				 * @brief Add an axis to the group.
+				 *
+				 * Only staged points are streamed, as points handed to the stream's
+				 * handle cannot be read back.  Enable staging on the stream
+				 * (BufferedTrajectoryPointStream::SetStaging) before filling it; every
+				 * Write and the WriteTo helpers then stage.
+				 *
+				 * @param motor Controller of the axis.
+				 * @param stream Points for the axis, must outlive the group's use of it.
+				 */
+				void Add(ctre::phoenix::motorcontrol::IMotorController & motor, BufferedTrajectoryPointStream & stream);
+				/**
+				 * @brief Remove every axis.
+				 */
+				void Clear();
+				/**
+				 * @brief Pre-buffer every axis, then enable them together.
+				 * Blocks until every axis is buffered and enabled, and the start of
+				 * each axis is observed, or until timeoutMs elapses.
+				 * Must not be called with an OutputTransaction open on the calling
+				 * thread, as it would defer both the hold and the release to the commit.
+				 * @param minBufferedPts Points each firmware buffer must hold before release.
+				 *            Do not exceed the firmware buffer capacity (120 for Motion Profile,
+				 *            or 60 for Motion Profile Arc).
+				 * @param motionProfControlMode Pass MotionProfile or MotionProfileArc.
+				 * @param timeoutMs Time allowed for buffering and for observing the start.
+				 * @return Worst error across all axes. 0 indicates every axis was released.
+				 *         InvalidParamValue if a stream is not staging, has no staged
+				 *         points, or an OutputTransaction is open.
+				 */
+				ctre::phoenix::ErrorCode Start(uint32_t minBufferedPts, ctre::phoenix::motorcontrol::ControlMode motionProfControlMode, int timeoutMs = 100);
+				/**
+				 * @brief Stream remaining points into every axis.  Call periodically after Start().
+				 * @return Worst error across all axes. 0 indicates no error.
+				 */
+				ctre::phoenix::ErrorCode Process();
+				/**
+				 * @return true once every axis has streamed all of its points and reached its last point.
+				 */
+				bool IsFinished();
+				/**
+				 * @return Per-axis results of the last Start(), in the order axes were added.
+				 */
+				const std::vector<MotionProfileAxisStart> & GetStartResults() const { return _results; }
+				/**
+				 * @return Largest startSkewUs of the last Start(), -1 if any axis was not observed.
+				 */
+				int32_t GetMaxStartSkewUs() const;
+
+			private:
+				struct Axis {
+					ctre::phoenix::motorcontrol::IMotorController * motor;
+					BufferedTrajectoryPointStream * stream;
+					uint32_t nextIndex;
+				};
+
+				ctre::phoenix::ErrorCode Feed(Axis & axis);
+
+				std::vector<Axis> _axes;
+				std::vector<MotionProfileAxisStart> _results;
+			};
+		} // namespace motion
+	} // namespace phoenix
+} // namespace ctre
@@ -0,0 +1,129 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include "ctre/phoenix/ErrorCode.h"
+#include "ctre/phoenix/motion/TrajectoryPoint.h"
+#include "ctre/phoenix/motion/BufferedTrajectoryPointStream.h"
+
+/* forward proto's */
+namespace ctre {
+	namespace phoenix {
+		namespace motorcontrol {
+			namespace can {
+				class BaseMotorController;
+			}
+		}
+	}
+}
+
+namespace ctre {
+	namespace phoenix {
+		namespace motion {
+			/**
+			 * Binary trajectory file, memory mapped for loading.
+			 *
+			 * Profiles generated offline are saved with Save() and opened at robot
+			 * start with Open(), which maps the file and validates it once.  Points
+			 * are then decoded one at a time straight out of the mapping as they are
+			 * written into a stream or pushed to a motor controller, so no parsing
+			 * pass or intermediate container is needed.
+			 *
+			 * File layout (host byte order, little-endian on every supported platform):
+			 *
+			 *		Header, 32 bytes
+			 *			char[8]  magic "CTRETRAJ"
+			 *			uint16   version (kVersion)
+			 *			uint16   header size in bytes
+			 *			uint32   point count
+			 *			uint32   point record size in bytes
+			 *			uint32   reserved, zero
+			 *			uint32   CRC-32 of the point records
+			 *			uint32   CRC-32 of the preceding 28 header bytes
+			 *		Point records, 72 bytes each
+			 *			double   position, velocity, arbFeedFwd, headingDeg,
+			 *			         auxiliaryPos, auxiliaryVel, auxiliaryArbFeedFwd
+			 *			uint32   profileSlotSelect0, profileSlotSelect1, timeDur
+			 *			uint8    flags: isLastPoint, zeroPos, useAuxPID
+			 *			uint8[3] reserved, zero
+			 *
+			 *	Example:
+			 *		TrajectoryFile file;
+			 *		if (file.Open("/home/lvuser/auton/leftSide.traj") == OK) {
+			 *			file.WriteTo(_stream);
+			 *			_talon.StartMotionProfile(_stream, 10, ControlMode::MotionProfile);
+			 *		}
+			 */
+			class TrajectoryFile {
+			public:
+				/** Current file format version */
+				static const uint16_t kVersion = 1;
+
+				TrajectoryFile();
+				~TrajectoryFile();
+				TrajectoryFile(const TrajectoryFile &) = delete;
+				TrajectoryFile& operator=(const TrajectoryFile &) = delete;
+
+				/**
+				 * @brief Save trajectory points to a file in the binary format.
+				 * @param path File to create or overwrite.
+				 * @param trajPts Points to save.
+				 * @param trajPtCount Number of points.
+				 * @return nonzero error code if the file cannot be written.
+				 */
+				static ctre::phoenix::ErrorCode Save(const char * path, const TrajectoryPoint * trajPts, uint32_t trajPtCount);
+				/**
+				 * @brief Map a trajectory file and validate its header and checksums.
+				 * Any previously opened file is closed first.
+				 * @param path File to open.
+				 * @return GeneralError if the file cannot be opened or mapped,
+				 *         InvalidParamValue if it is not a valid trajectory file
+				 *         (bad magic, unsupported version, wrong size or checksum mismatch).
+				 */
+				ctre::phoenix::ErrorCode Open(const char * path);
+				/**
+				 * @brief Unmap the file.
+				 */
+				void Close();
+				/**
+				 * @return true if a valid file is mapped.
+				 */
+				bool IsOpen() const { return _data != nullptr; }
+				/**
+				 * @return Number of points in the file, zero if not open.
+				 */
+				uint32_t GetCount() const { return _count; }
+				/**
+				 * @brief Decode a single point.
+				 * @param index Index of the point.
+				 * @param trajPt Caller's point to fill.
+				 * @return nonzero error code if not open or index is out of range.
+				 */
+				ctre::phoenix::ErrorCode GetPoint(uint32_t index, TrajectoryPoint & trajPt) const;
+				/**
+				 * @brief Write points from the file into a stream.
+				 * Points are staged if the stream is staging, see BufferedTrajectoryPointStream::SetStaging.
+				 * @param stream Stream to write into.
+				 * @param first Index of the first point to write.
+				 * @param maxTrajPts Maximum number of points to write.
+				 * @return nonzero error code if operation fails.
+				 */
+				ctre::phoenix::ErrorCode WriteTo(BufferedTrajectoryPointStream & stream, uint32_t first = 0, uint32_t maxTrajPts = UINT32_MAX) const;
+				/**
+				 * @brief Push points from the file into a motor controller's top level buffer.
+				 * Stops at the first failed push, such as a full top buffer, so the caller
+				 * can resume from nextIndex once ProcessMotionProfileBuffer() has made room.
+				 * @param motor Motor controller to push into.
+				 * @param nextIndex Index of the next point to push, advanced past every point pushed.
+				 * @param maxTrajPts Maximum number of points to push.
+				 * @return nonzero error code if operation fails.
+				 */
+				ctre::phoenix::ErrorCode PushTo(ctre::phoenix::motorcontrol::can::BaseMotorController & motor, uint32_t & nextIndex, uint32_t maxTrajPts = UINT32_MAX) const;
+
+			private:
+				const uint8_t * _data;
+				size_t _size;
+				uint32_t _count;
+			};
+		} // namespace motion
+	} // namespace phoenix
+} // namespace ctre
@@ -0,0 +1,134 @@
+#pragma once
+#include <stdint.h>
+#include <vector>
+#include "ctre/phoenix/ErrorCode.h"
+#include "ctre/phoenix/motion/TrajectoryPoint.h"
+#include "ctre/phoenix/motion/BufferedTrajectoryPointStream.h"
+
+/* forward proto's */
+namespace ctre {
+	namespace phoenix {
+		namespace motorcontrol {
+			class IMotorController;
+		}
+	}
+}
+
+namespace ctre {
+	namespace phoenix {
+		namespace motion {
+			/**
+			 * Streaming trapezoidal/S-curve trajectory generator.
+			 *
+			 * Produces the points of a single move one at a time, in constant time per
+			 * point, so execution can start after the first few points instead of after
+			 * the whole profile is computed.
+			 *
+			 * The profile is the cruise velocity step passed through two cascaded
+			 * moving-average filters.  The first filter spans the time to reach cruise
+			 * velocity at the given acceleration, giving a trapezoidal profile.  The second
+			 * spans sCurveStrength/8 of the first, rounding the corners into an S-curve,
+			 * so strength 0 is trapezoidal and 8 is the smoothest, as with
+			 * ConfigMotionSCurveStrength.  The filters preserve area, so the final point
+			 * lands exactly on the end position.
+			 *
+			 * For incremental generation while the profile executes, feed the controller
+			 * with PushTo() and service it with ProcessMotionProfileBuffer or a
+			 * MotionProfileFeeder.  WriteTo() fills a BufferedTrajectoryPointStream for
+			 * StartMotionProfile.
+			 *
+			 *	Example:
+			 *		TrajectoryGenerator gen;
+			 *		gen.Configure(0, 40960, 2000, 4000, 4, 10);
+			 *		gen.PushTo(_talon, 20);
+			 *		_talon.Set(ControlMode::MotionProfile, SetValueMotionProfile::Enable);
+			 *		...
+			 *		gen.PushTo(_talon, 20);	// every loop until gen.IsDone()
+			 */
+			class TrajectoryGenerator {
+			public:
+				/** Most points allowed to reach cruise velocity, bounds the filter memory. */
+				static const uint32_t kMaxAccelPoints = 65536;
+
+				TrajectoryGenerator();
+
+				/**
+				 * @brief Configure a move and restart generation.
+				 * @param startPos Position at the start of the move (in sensor units).
+				 * @param endPos Position at the end of the move (in sensor units).
+				 * @param cruiseVelocity Peak velocity magnitude (in sensor-units per 100ms).
+				 * @param acceleration Acceleration magnitude (in sensor-units per 100ms per second).
+				 * @param sCurveStrength Zero for trapezoidal, [1,8] for S-curve, higher for greater smoothing.
+				 * @param timeDurMs Duration of each point in ms.
+				 * @param profileSlotSelect0 Slot for PID[0] gains applied to every point.
+				 * @return nonzero error code if any parameter is out of range, or reaching
+				 *         cruise velocity takes more than kMaxAccelPoints points.
+				 */
+				ctre::phoenix::ErrorCode Configure(double startPos, double endPos, double cruiseVelocity, double acceleration,
+					int sCurveStrength, uint32_t timeDurMs, uint32_t profileSlotSelect0 = 0);
+				/**
+				 * @return Number of points in the configured move.
+				 */
+				uint32_t GetTotalCount() const { return _totalCount; }
+				/**
+				 * @return Number of points generated so far.
+				 */
+				uint32_t GetGeneratedCount() const { return _index; }
+				/**
+				 * @return true once every point has been generated.
+				 */
+				bool IsDone() const { return _index >= _totalCount && !_pending; }
+				/**
+				 * @brief Generate the next point.
+				 * @param trajPt Caller's point to fill.
+				 * @return false if every point has already been generated.
+				 */
+				bool Next(TrajectoryPoint & trajPt);
+				/**
+				 * @brief Generate points into a stream.
+				 * Points are staged if the stream is staging, see BufferedTrajectoryPointStream::SetStaging.
+				 * @param stream Stream to write into.
+				 * @param maxTrajPts Maximum number of points to generate.
+				 * @return nonzero error code if operation fails.
+				 */
+				ctre::phoenix::ErrorCode WriteTo(BufferedTrajectoryPointStream & stream, uint32_t maxTrajPts = UINT32_MAX);
+				/**
+				 * @brief Generate points into a motor controller's top level buffer.
+				 * Stops when the top buffer is full, so call again once it has drained.
+				 * @param motor Motor controller to push into.
+				 * @param maxTrajPts Maximum number of points to generate.
+				 * @return nonzero error code if operation fails.
+				 */
+				ctre::phoenix::ErrorCode PushTo(ctre::phoenix::motorcontrol::IMotorController & motor, uint32_t maxTrajPts = UINT32_MAX);
+
+			private:
+				/* moving average over a fixed window, one sample at a time */
+				struct Filter {
+					std::vector<double> window;
+					size_t next = 0;
+					double sum = 0;
+
+					void Reset(size_t length);
+					double Step(double input);
+				};
+
+				double _startPos = 0;
+				double _endPos = 0;
+				double _inputVelocity = 0;
+				uint32_t _inputCount = 0;
+				uint32_t _timeDurMs = 0;
+				uint32_t _profileSlotSelect0 = 0;
+				uint32_t _totalCount = 0;
+
+				Filter _filter1;
+				Filter _filter2;
+				uint32_t _index = 0;
+				double _position = 0;
+				double _velocity = 0;
+				/* point generated but not yet accepted by a full top buffer */
+				bool _pending = false;
+				TrajectoryPoint _pendingPt;
+			};
+		} // namespace motion
+	} // namespace phoenix
+} // namespace ctre
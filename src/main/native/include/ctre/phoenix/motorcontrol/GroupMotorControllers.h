@@ -9,6 +9,8 @@ namespace motorcontrol {
 
 /**
  * Group of motor controllers
+ *
+ * To drive a master and its followers as one mechanism, see MotorGroup.
  */
 class GroupMotorControllers {
 public:
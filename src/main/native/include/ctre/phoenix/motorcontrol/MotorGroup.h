@@ -0,0 +1,127 @@
+#pragma once
+
+#include "ctre/phoenix/ErrorCode.h"
+#include "ctre/phoenix/motorcontrol/ControlMode.h"
+#include "ctre/phoenix/motorcontrol/DemandType.h"
+#include "ctre/phoenix/motorcontrol/FollowerType.h"
+#include "ctre/phoenix/motorcontrol/InvertType.h"
+#include "ctre/phoenix/motorcontrol/NeutralMode.h"
+#include <vector>
+
+namespace ctre {
+namespace phoenix {
+namespace motorcontrol {
+
+namespace can {
+class BaseMotorController;
+}
+
+/**
+ * A master motor controller and its followers, driven as one mechanism.
+ *
+ * Members are held in contiguous storage with the master first.  Output,
+ * neutral mode, invert and ramps are applied to every member in one call,
+ * and all outputs of a call are sent together through an OutputTransaction
+ * (joining the caller's transaction if one is open).
+ *
+ * Followers are engaged with Follow() on the first Set() and re-engaged
+ * after NeutralOutput(), so a Set() normally sends only the master's demand.
+ * Call RefreshFollowers() to resend every follow demand in one burst, such
+ * as after a follower resets.
+ *
+ *	Example:
+ *		MotorGroup elevator(_talonMaster);
+ *		elevator.AddFollower(_victor1);
+ *		elevator.AddFollower(_victor2, InvertType::OpposeMaster);
+ *		elevator.SetNeutralMode(NeutralMode::Brake);
+ *		elevator.ConfigOpenloopRamp(0.2);
+ *		...
+ *		elevator.Set(ControlMode::PercentOutput, joy);
+ */
+class MotorGroup {
+public:
+	/**
+	 * @param master Master of the group, must outlive the group.
+	 */
+	MotorGroup(can::BaseMotorController & master);
+
+	/**
+	 * @brief Add a follower.
+	 * @param follower Follower to add, must outlive the group.
+	 * @param invertType FollowMaster or OpposeMaster to invert relative to the master,
+	 *            or None/InvertMotorOutput for an absolute invert.
+	 * @param followerType Type of following, see FollowerType.
+	 */
+	void AddFollower(can::BaseMotorController & follower, InvertType invertType = InvertType::FollowMaster,
+			FollowerType followerType = FollowerType_PercentOutput);
+	/**
+	 * @return Number of members, including the master.
+	 */
+	size_t Count() const { return _members.size(); }
+	/**
+	 * @param idx Member index, 0 is the master.
+	 * @return Member at the index.
+	 */
+	can::BaseMotorController & Get(size_t idx) { return *_members[idx].motor; }
+	/**
+	 * @return Master of the group.
+	 */
+	can::BaseMotorController & GetMaster() { return *_members[0].motor; }
+
+	/**
+	 * @brief Set the master's output and engage any disengaged followers.
+	 * @param mode Control mode of the master.
+	 * @param demand0 Output value, see BaseMotorController::Set.
+	 * @param demand1Type The demand type for demand1.
+	 * @param demand1 Supplemental output value.
+	 */
+	void Set(ControlMode mode, double demand0, DemandType demand1Type = DemandType_Neutral, double demand1 = 0);
+	/**
+	 * @brief Neutral every member.
+	 */
+	void NeutralOutput();
+	/**
+	 * @brief Resend every follower's follow demand in one burst.
+	 */
+	void RefreshFollowers();
+	/**
+	 * @brief Set the neutral mode of every member.
+	 * @param neutralMode The desired mode of operation when the group is neutral.
+	 */
+	void SetNeutralMode(NeutralMode neutralMode);
+	/**
+	 * @brief Invert the master, and reapply each follower's invert type.
+	 * @param invert Invert state of the master.
+	 */
+	void SetInverted(bool invert);
+	/**
+	 * @brief Configure the open-loop ramp of every member.
+	 * @param secondsFromNeutralToFull Minimum desired time to go from neutral to full throttle.
+	 * @param timeoutMs Timeout value in ms for each config.
+	 * @return Worst error across members. 0 indicates no error.
+	 */
+	ErrorCode ConfigOpenloopRamp(double secondsFromNeutralToFull, int timeoutMs = 0);
+	/**
+	 * @brief Configure the closed-loop ramp of every member.
+	 * @param secondsFromNeutralToFull Minimum desired time to go from neutral to full throttle.
+	 * @param timeoutMs Timeout value in ms for each config.
+	 * @return Worst error across members. 0 indicates no error.
+	 */
+	ErrorCode ConfigClosedloopRamp(double secondsFromNeutralToFull, int timeoutMs = 0);
+
+private:
+	struct Member {
+		can::BaseMotorController * motor;
+		InvertType invertType;
+		FollowerType followerType;
+	};
+
+	void EngageFollowers();
+
+	std::vector<Member> _members;
+	bool _followersEngaged = false;
+};
+
+} // namespace motorcontrol
+} // namespace phoenix
+} // namespace ctre
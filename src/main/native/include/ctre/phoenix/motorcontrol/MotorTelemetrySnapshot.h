@@ -0,0 +1,63 @@
+#pragma once
+
+#include "ctre/phoenix/ErrorCode.h"
+#include "ctre/phoenix/Timestamped.h"
+
+namespace ctre {
+namespace phoenix {
+namespace motorcontrol {
+
+/**
+ * Status signals of a motor controller captured in one call.
+ * Every value carries the time of its last fresh read, see Timestamped.
+ */
+struct MotorTelemetrySnapshot {
+	/**
+	 * Selected sensor position of PID[0] (in raw sensor units)
+	 */
+	Timestamped<int> selectedSensorPosition;
+	/**
+	 * Selected sensor velocity of PID[0] (in raw sensor units per 100ms)
+	 */
+	Timestamped<int> selectedSensorVelocity;
+	/**
+	 * Output current (in amps)
+	 */
+	Timestamped<double> outputCurrent;
+	/**
+	 * Bus voltage (in volts)
+	 */
+	Timestamped<double> busVoltage;
+	/**
+	 * Temperature (in 'C)
+	 */
+	Timestamped<double> temperature;
+	/**
+	 * Motor output [-1,+1]
+	 */
+	Timestamped<double> motorOutputPercent;
+	/**
+	 * Closed-loop error of PID[0] (in raw sensor units)
+	 */
+	Timestamped<int> closedLoopError;
+	/**
+	 * Fault bits, see Faults
+	 */
+	Timestamped<int> faults;
+	/**
+	 * Sticky fault bits, see StickyFaults
+	 */
+	Timestamped<int> stickyFaults;
+	/**
+	 * Monotonic time the snapshot was taken, zero if never
+	 */
+	int64_t snapshotUs = 0;
+	/**
+	 * First error reading the signals. 0 indicates every signal is fresh.
+	 */
+	ErrorCode error = OK;
+};
+
+} // namespace motorcontrol
+} // namespace phoenix
+} // namespace ctre
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "ctre/phoenix/ErrorCode.h"
+#include <vector>
+
+namespace ctre {
+namespace phoenix {
+namespace motorcontrol {
+
+namespace can {
+class BaseMotorController;
+}
+
+/**
+ * Coalesces motor controller outputs so they are sent together.
+ *
+ * While a transaction is open on a thread, every Set() and NeutralOutput()
+ * made from that thread is staged in the motor controller instead of being
+ * sent.  A motor controller set more than once keeps only its last demand.
+ * Commit() then sends every staged demand back to back, in the order the
+ * motor controllers were first set, so all outputs of a loop go out as one
+ * burst at a point the caller chooses.
+ *
+ *	Example:
+ *		OutputTransaction txn;
+ *		txn.Begin();
+ *		_talonLeft.Set(ControlMode::PercentOutput, leftJoy);
+ *		_talonRght.Set(ControlMode::PercentOutput, rghtJoy);
+ *		txn.Commit();
+ */
+class OutputTransaction {
+public:
+	OutputTransaction();
+	/**
+	 * Commits the transaction if it is still open.
+	 */
+	~OutputTransaction();
+	OutputTransaction(const OutputTransaction &) = delete;
+	OutputTransaction& operator=(const OutputTransaction &) = delete;
+
+	/**
+	 * Open the transaction on the calling thread.
+	 * @return nonzero error code if a transaction is already open on this thread.
+	 */
+	ErrorCode Begin();
+	/**
+	 * Send every staged demand and close the transaction.
+	 */
+	void Commit();
+	/**
+	 * Drop every staged demand and close the transaction.
+	 * Motor controllers keep their previous output.
+	 */
+	void Abort();
+	/**
+	 * @return true if the transaction is open.
+	 */
+	bool IsOpen() const;
+	/**
+	 * @return number of motor controllers with a staged demand.
+	 */
+	size_t GetStagedCount() const;
+	/**
+	 * @return transaction open on the calling thread, or nullptr.
+	 */
+	static OutputTransaction * GetCurrent();
+
+private:
+	friend class can::BaseMotorController;
+
+	void Add(can::BaseMotorController * motor);
+	void Remove(can::BaseMotorController * motor);
+	void Close();
+
+	std::vector<can::BaseMotorController *> _motors;
+	bool _open = false;
+};
+
+} // namespace motorcontrol
+} // namespace phoenix
+} // namespace ctre
@@ -0,0 +1,170 @@
+#pragma once
+
+#include "ctre/phoenix/Units.h"
+#include "ctre/phoenix/motorcontrol/can/BaseMotorController.h"
+#include "ctre/phoenix/motorcontrol/can/TalonSRX.h"
+
+namespace ctre {
+namespace phoenix {
+namespace motorcontrol {
+
+/**
+ * Typed view of a motor controller in mechanism units.
+ *
+ * Setpoints and sensor values are converted with the compile-time factors of
+ * Scale (see units::SensorScale), so a hot loop pays one multiply per value and
+ * passing meters where rotations are expected does not compile.
+ *
+ *	Example:
+ *		typedef units::SensorScale<4096, std::ratio<1071, 100>, std::ratio<4788, 10000>> DriveScale;
+ *		ScaledMotorController<DriveScale> drive(_talon);
+ *		drive.SetVelocity(units::MetersPerSecond(2.5));
+ *		units::Meters travelled = drive.GetDistance();
+ */
+template <typename Scale>
+class ScaledMotorController {
+public:
+	/**
+	 * @param motor Controller to drive, must outlive the view.
+	 */
+	explicit ScaledMotorController(can::BaseMotorController & motor) : _motor(motor) {
+	}
+	/**
+	 * @return Underlying controller.
+	 */
+	can::BaseMotorController & GetMotor() { return _motor; }
+
+	/**
+	 * @brief Closed-loop position to a mechanism position.
+	 */
+	void SetPosition(units::Rotations position) {
+		_motor.Set(ControlMode::Position, Scale::ToNative(position));
+	}
+	/**
+	 * @brief Closed-loop position to a linear position.
+	 */
+	void SetPosition(units::Meters position) {
+		_motor.Set(ControlMode::Position, Scale::ToNative(position));
+	}
+	/**
+	 * @brief Motion Magic to a mechanism position.
+	 */
+	void SetMotionMagic(units::Rotations position) {
+		_motor.Set(ControlMode::MotionMagic, Scale::ToNative(position));
+	}
+	/**
+	 * @brief Motion Magic to a linear position.
+	 */
+	void SetMotionMagic(units::Meters position) {
+		_motor.Set(ControlMode::MotionMagic, Scale::ToNative(position));
+	}
+	/**
+	 * @brief Closed-loop velocity at a mechanism angular velocity.
+	 */
+	void SetVelocity(units::RadiansPerSecond velocity) {
+		_motor.Set(ControlMode::Velocity, Scale::ToNative(velocity));
+	}
+	/**
+	 * @brief Closed-loop velocity at a linear velocity.
+	 */
+	void SetVelocity(units::MetersPerSecond velocity) {
+		_motor.Set(ControlMode::Velocity, Scale::ToNative(velocity));
+	}
+	/**
+	 * @brief Closed-loop current.
+	 */
+	void SetCurrent(units::Amps current) {
+		_motor.Set(ControlMode::Current, current.Value());
+	}
+
+	/**
+	 * @param pidIdx 0 for Primary closed-loop. 1 for auxiliary closed-loop.
+	 * @return Mechanism position of the selected sensor.
+	 */
+	units::Rotations GetPosition(int pidIdx = 0) {
+		return Scale::ToRotations(_motor.GetSelectedSensorPosition(pidIdx));
+	}
+	/**
+	 * @param pidIdx 0 for Primary closed-loop. 1 for auxiliary closed-loop.
+	 * @return Linear position of the selected sensor.
+	 */
+	units::Meters GetDistance(int pidIdx = 0) {
+		return Scale::ToMeters(_motor.GetSelectedSensorPosition(pidIdx));
+	}
+	/**
+	 * @param pidIdx 0 for Primary closed-loop. 1 for auxiliary closed-loop.
+	 * @return Mechanism angular velocity of the selected sensor.
+	 */
+	units::RadiansPerSecond GetVelocity(int pidIdx = 0) {
+		return Scale::ToRadiansPerSecond(_motor.GetSelectedSensorVelocity(pidIdx));
+	}
+	/**
+	 * @param pidIdx 0 for Primary closed-loop. 1 for auxiliary closed-loop.
+	 * @return Linear velocity of the selected sensor.
+	 */
+	units::MetersPerSecond GetLinearVelocity(int pidIdx = 0) {
+		return Scale::ToMetersPerSecond(_motor.GetSelectedSensorVelocity(pidIdx));
+	}
+	/**
+	 * @return Bus voltage.
+	 */
+	units::Volts GetBusVoltage() {
+		return units::Volts(_motor.GetBusVoltage());
+	}
+	/**
+	 * @brief Set the selected sensor to a mechanism position.
+	 * @return Error Code generated by function. 0 indicates no error.
+	 */
+	ErrorCode SetSelectedSensorPosition(units::Rotations position, int pidIdx = 0, int timeoutMs = 50) {
+		return _motor.SetSelectedSensorPosition((int)Round(Scale::ToNative(position)), pidIdx, timeoutMs);
+	}
+	/**
+	 * @brief Set the selected sensor to a linear position.
+	 * @return Error Code generated by function. 0 indicates no error.
+	 */
+	ErrorCode SetSelectedSensorPosition(units::Meters position, int pidIdx = 0, int timeoutMs = 50) {
+		return _motor.SetSelectedSensorPosition((int)Round(Scale::ToNative(position)), pidIdx, timeoutMs);
+	}
+
+private:
+	static double Round(double value) {
+		return value >= 0 ? value + 0.5 : value - 0.5;
+	}
+
+	can::BaseMotorController & _motor;
+};
+
+/**
+ * ScaledMotorController of a Talon SRX, which also measures output current.
+ *
+ *	Example:
+ *		ScaledTalonSRX<DriveScale> drive(_talon);
+ *		units::Amps current = drive.GetOutputCurrent();
+ */
+template <typename Scale>
+class ScaledTalonSRX : public ScaledMotorController<Scale> {
+public:
+	/**
+	 * @param talon Talon to drive, must outlive the view.
+	 */
+	explicit ScaledTalonSRX(can::TalonSRX & talon) :
+			ScaledMotorController<Scale>(talon), _talon(talon) {
+	}
+	/**
+	 * @return Underlying Talon.
+	 */
+	can::TalonSRX & GetTalon() { return _talon; }
+	/**
+	 * @return Output current.
+	 */
+	units::Amps GetOutputCurrent() {
+		return units::Amps(_talon.GetOutputCurrent());
+	}
+
+private:
+	can::TalonSRX & _talon;
+};
+
+} // namespace motorcontrol
+} // namespace phoenix
+} // namespace ctre
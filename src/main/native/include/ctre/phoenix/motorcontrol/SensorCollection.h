@@ -1,6 +1,8 @@
 #pragma once
 
 #include "ctre/phoenix/ErrorCode.h"
+#include "ctre/phoenix/Timestamped.h"
+#include "ctre/phoenix/motorcontrol/StatusFrameDemand.h"
 
 namespace ctre {
 namespace phoenix {
@@ -25,6 +27,7 @@ namespace motorcontrol {
   * Particularly if you are seeding one sensor based on another, or need to circumvent sensor-phase.
   *
   * Use the getSensorCollection() routine inside your motor controller to create a sensor collection.
+  * To keep every sample between reads, capture the collection with a SensorHistory.
   */
 class SensorCollection {
 public:
@@ -40,6 +43,14 @@ public:
 
 	int GetAnalogIn();
 
+	/**
+	 * Gets the analog in position (24bit) with the time of the read, see Timestamped.
+	 *
+	 * @param value Caller's value to update.
+	 * @return Error Code of the read. 0 indicates the value is fresh.
+	 */
+	ErrorCode GetAnalogIn(Timestamped<int> & value);
+
 	/**
 	 * Sets analog position.
 	 *
@@ -72,6 +83,14 @@ public:
 
 	int GetAnalogInVel();
 
+	/**
+	 * Gets the analog in velocity (in units per 100ms) with the time of the read, see Timestamped.
+	 *
+	 * @param value Caller's value to update.
+	 * @return Error Code of the read. 0 indicates the value is fresh.
+	 */
+	ErrorCode GetAnalogInVel(Timestamped<int> & value);
+
 	/**
 	 * Get the quadrature position of the Talon, regardless of whether
 	 *   it is actually being used for feedback.
@@ -81,6 +100,14 @@ public:
 
 	int GetQuadraturePosition();
 
+	/**
+	 * Gets the quadrature position with the time of the read, see Timestamped.
+	 *
+	 * @param value Caller's value to update.
+	 * @return Error Code of the read. 0 indicates the value is fresh.
+	 */
+	ErrorCode GetQuadraturePosition(Timestamped<int> & value);
+
 	/**
 	 * Change the quadrature reported position.  Typically this is used to "zero" the
 	 *   sensor. This only works with Quadrature sensor.  To set the selected sensor position
@@ -128,6 +155,14 @@ public:
 
 	int GetQuadratureVelocity();
 
+	/**
+	 * Gets the quadrature velocity (in units per 100ms) with the time of the read, see Timestamped.
+	 *
+	 * @param value Caller's value to update.
+	 * @return Error Code of the read. 0 indicates the value is fresh.
+	 */
+	ErrorCode GetQuadratureVelocity(Timestamped<int> & value);
+
 	/**
 	 * Gets pulse width position, regardless of whether
 	 *   it is actually being used for feedback.
@@ -137,6 +172,14 @@ public:
 
 	int GetPulseWidthPosition();
 
+	/**
+	 * Gets the pulse width position with the time of the read, see Timestamped.
+	 *
+	 * @param value Caller's value to update.
+	 * @return Error Code of the read. 0 indicates the value is fresh.
+	 */
+	ErrorCode GetPulseWidthPosition(Timestamped<int> & value);
+
 	/**
 	 * Sets pulse width position.
 	 *
@@ -159,6 +202,14 @@ public:
 
 	int GetPulseWidthVelocity();
 
+	/**
+	 * Gets the pulse width velocity (in units per 100ms) with the time of the read, see Timestamped.
+	 *
+	 * @param value Caller's value to update.
+	 * @return Error Code of the read. 0 indicates the value is fresh.
+	 */
+	ErrorCode GetPulseWidthVelocity(Timestamped<int> & value);
+
 	/**
 	 * Gets pulse width rise to fall time.
 	 *
@@ -218,9 +269,16 @@ public:
 	int IsRevLimitSwitchClosed();
 
 private:
-	SensorCollection(void * handle);
+	SensorCollection(void * handle, StatusFrameDemand * demand);
 	friend class ctre::phoenix::motorcontrol::can::TalonSRX;
 	void* _handle;
+	/* getter calls of the owning controller, see StatusFramePeriodManager */
+	StatusFrameDemand * _demand;
+
+	void NoteDemand(StatusFrameEnhanced frame) {
+		if (_demand)
+			_demand->Note(frame);
+	}
 
 };
 
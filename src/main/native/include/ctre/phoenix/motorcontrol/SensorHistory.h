@@ -0,0 +1,170 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "ctre/phoenix/ErrorCode.h"
+
+namespace ctre {
+namespace phoenix {
+namespace motorcontrol {
+
+class SensorCollection;
+
+/**
+ * Sensor signals of a SensorCollection captured together.
+ */
+struct SensorSample {
+	/**
+	 * Monotonic time of the capture (see GetMonotonicUs)
+	 */
+	int64_t timestampUs = 0;
+	/**
+	 * Quadrature position
+	 */
+	int quadraturePosition = 0;
+	/**
+	 * Quadrature velocity (in units per 100ms)
+	 */
+	int quadratureVelocity = 0;
+	/**
+	 * Pulse width position
+	 */
+	int pulseWidthPosition = 0;
+	/**
+	 * Pulse width velocity (in units per 100ms)
+	 */
+	int pulseWidthVelocity = 0;
+	/**
+	 * Analog in position (24bit)
+	 */
+	int analogIn = 0;
+	/**
+	 * Analog in velocity (in units per 100ms)
+	 */
+	int analogInVel = 0;
+};
+
+/**
+ * Opt-in history of a SensorCollection's signals, captured at a fixed rate
+ * by a background thread into a ring sized at construction.
+ *
+ * The application loop can run slower than the sensor status frames and
+ * still see every sample, for velocity estimation or latency-corrected
+ * filtering.  Only fresh captures are recorded, so raise the matching status
+ * frame (Status_3_Quadrature, Status_8_PulseWidth or Status_4_AinTempVbat)
+ * to the capture period.
+ *
+ * A capture whose signals all match the previous sample is dropped, as
+ * polling faster than the status frame reads the same frame again.  Each
+ * sample is then the first capture of a new frame, so derivatives between
+ * samples do not alternate between zero and a jump.  Pass the status frame
+ * period to Start() so a stationary sensor still records a sample once per
+ * frame period.  GetLastCaptureUs() tells a stopped mechanism, which keeps
+ * capturing, from a silent bus, which does not.
+ *
+ * ReadSince() is wait-free and may be called from any number of threads,
+ * each with its own cursor.  A reader that falls more than a ring behind
+ * skips the overwritten samples and is told how many.
+ *
+ *	Example:
+ *		SensorHistory history(_talon.GetSensorCollection(), 256, SensorHistory::kQuadrature);
+ *		history.Start(1, 10);	// Status_3_Quadrature at 10ms
+ *		uint64_t cursor = history.GetCursor();
+ *		...
+ *		SensorSample samples[64];
+ *		size_t count = history.ReadSince(cursor, samples, 64);	// every loop
+ */
+class SensorHistory {
+public:
+	/**
+	 * Signals to capture, combine with bitwise or.
+	 */
+	enum Signals {
+		kQuadrature = 1, //!< quadraturePosition and quadratureVelocity
+		kPulseWidth = 2, //!< pulseWidthPosition and pulseWidthVelocity
+		kAnalog = 4, //!< analogIn and analogInVel
+		kAll = 7, //!< every signal
+	};
+
+	/**
+	 * @param sensors Sensors to capture, must outlive the history.
+	 * @param capacity Number of samples held before the oldest is overwritten.
+	 * @param signals Signals to capture, see Signals.  Signals not captured read as zero.
+	 */
+	SensorHistory(SensorCollection & sensors, size_t capacity, int signals = kAll);
+	~SensorHistory();
+	SensorHistory(const SensorHistory &) = delete;
+	SensorHistory& operator=(const SensorHistory &) = delete;
+
+	/**
+	 * Start the capture thread.
+	 * @param periodMs Capture period, typically the status frame period.
+	 * @param framePeriodMs Status frame period.  A capture that repeats the
+	 *            previous sample is still recorded once this long has passed
+	 *            since it.  If zero, repeats are never recorded.
+	 * @return nonzero error code if already running or a period is not valid.
+	 */
+	ErrorCode Start(int periodMs = 1, int framePeriodMs = 0);
+	/**
+	 * Stop the capture thread and wait for it to exit.
+	 */
+	void Stop();
+	/**
+	 * @return true if the capture thread is running.
+	 */
+	bool IsRunning() const { return _running; }
+	/**
+	 * @return Cursor positioned after the newest sample, to read only samples captured from now on.
+	 */
+	uint64_t GetCursor() const { return _written.load(std::memory_order_acquire); }
+	/**
+	 * @return Monotonic time of the last fresh capture (see GetMonotonicUs),
+	 *         recorded or not, zero if none.
+	 */
+	int64_t GetLastCaptureUs() const { return _lastCaptureUs.load(std::memory_order_relaxed); }
+	/**
+	 * @return Number of samples the ring holds.
+	 */
+	size_t GetCapacity() const { return _slots.size(); }
+	/**
+	 * Copy out samples captured since the cursor, oldest first.  Wait-free.
+	 *
+	 * @param cursor Caller's cursor, start at zero or GetCursor().  Advanced past the samples read.
+	 * @param samples Caller's array to fill.
+	 * @param maxSamples Capacity of the array.
+	 * @param skipped If not null, set to the number of samples overwritten before they could be read.
+	 * @return Number of samples copied.
+	 */
+	size_t ReadSince(uint64_t & cursor, SensorSample * samples, size_t maxSamples, uint64_t * skipped = nullptr) const;
+
+private:
+	struct Slot {
+		/* 2*(index+1) once sample index is committed, odd while being written */
+		std::atomic<uint64_t> seq;
+		SensorSample sample;
+	};
+
+	void Run(int periodMs, int framePeriodMs);
+	bool Capture(SensorSample & sample);
+	bool IsRepeat(const SensorSample & sample, int framePeriodMs) const;
+	void Append(const SensorSample & sample);
+
+	SensorCollection & _sensors;
+	int _signals;
+	std::vector<Slot> _slots;
+	std::atomic<uint64_t> _written;
+	std::atomic<int64_t> _lastCaptureUs;
+	/* last recorded sample, only touched by the capture thread */
+	SensorSample _last;
+	bool _haveLast = false;
+
+	std::thread _thread;
+	std::atomic<bool> _running;
+};
+
+} // namespace motorcontrol
+} // namespace phoenix
+} // namespace ctre
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <stdint.h>
+#include <atomic>
+#include "ctre/phoenix/Timestamped.h"
+#include "ctre/phoenix/motorcontrol/StatusFrame.h"
+
+namespace ctre {
+namespace phoenix {
+namespace motorcontrol {
+
+/**
+ * Counts the read instants of each status frame of a motor controller, for
+ * StatusFramePeriodManager.
+ *
+ * A loop tick that reads several signals of the same frame (position,
+ * velocity and current of Status_2, say) needs one fresh frame, not one per
+ * getter.  So reads of a frame within kReadGapUs of the last counted read
+ * count once, and the count does not depend on which getters were used.
+ * Counting is a clock read and relaxed atomics, so getters stay cheap
+ * whether or not a manager is attached.
+ */
+class StatusFrameDemand {
+public:
+	/**
+	 * Number of tracked frames
+	 */
+	static const int kFrameCount = 9;
+	/**
+	 * Reads of a frame closer than this to the last counted read are the same read instant
+	 */
+	static const int64_t kReadGapUs = 1000;
+
+	StatusFrameDemand() {
+		for (int i = 0; i < kFrameCount; ++i) {
+			_calls[i].store(0, std::memory_order_relaxed);
+			_lastUs[i].store(INT64_MIN / 2, std::memory_order_relaxed);
+		}
+	}
+	/**
+	 * @param index Tracked frame index [0, kFrameCount)
+	 * @return Frame at the index.
+	 */
+	static StatusFrameEnhanced FrameAt(int index) {
+		static const StatusFrameEnhanced frames[kFrameCount] = {
+			StatusFrameEnhanced::Status_1_General,
+			StatusFrameEnhanced::Status_2_Feedback0,
+			StatusFrameEnhanced::Status_3_Quadrature,
+			StatusFrameEnhanced::Status_4_AinTempVbat,
+			StatusFrameEnhanced::Status_8_PulseWidth,
+			StatusFrameEnhanced::Status_10_Targets,
+			StatusFrameEnhanced::Status_12_Feedback1,
+			StatusFrameEnhanced::Status_13_Base_PIDF0,
+			StatusFrameEnhanced::Status_14_Turn_PIDF1,
+		};
+		return frames[index];
+	}
+	/**
+	 * @param frame Frame to look up.
+	 * @return Tracked frame index, -1 if the frame is not tracked.
+	 */
+	static int IndexOf(StatusFrameEnhanced frame) {
+		for (int i = 0; i < kFrameCount; ++i) {
+			if (FrameAt(i) == frame)
+				return i;
+		}
+		return -1;
+	}
+	/**
+	 * @param pidIdx 0 for Primary closed-loop. 1 for auxiliary closed-loop.
+	 * @return Frame carrying the selected sensor of the loop.
+	 */
+	static StatusFrameEnhanced FeedbackFrame(int pidIdx) {
+		return pidIdx == 0 ? StatusFrameEnhanced::Status_2_Feedback0 : StatusFrameEnhanced::Status_12_Feedback1;
+	}
+	/**
+	 * @param pidIdx 0 for Primary closed-loop. 1 for auxiliary closed-loop.
+	 * @return Frame carrying the closed-loop terms of the loop.
+	 */
+	static StatusFrameEnhanced PidfFrame(int pidIdx) {
+		return pidIdx == 0 ? StatusFrameEnhanced::Status_13_Base_PIDF0 : StatusFrameEnhanced::Status_14_Turn_PIDF1;
+	}
+	/**
+	 * Count a read of a frame, unless it is part of the last counted read
+	 * instant.  Untracked frames are ignored.
+	 * @param frame Frame read.
+	 */
+	void Note(StatusFrameEnhanced frame) {
+		int index = IndexOf(frame);
+		if (index < 0)
+			return;
+		int64_t nowUs = GetMonotonicUs();
+		int64_t lastUs = _lastUs[index].load(std::memory_order_relaxed);
+		if (nowUs - lastUs < kReadGapUs)
+			return;
+		/* a racing read of the same instant loses and is not counted */
+		if (_lastUs[index].compare_exchange_strong(lastUs, nowUs, std::memory_order_relaxed))
+			_calls[index].fetch_add(1, std::memory_order_relaxed);
+	}
+	/**
+	 * @param index Tracked frame index [0, kFrameCount)
+	 * @return Read instants counted since the last Take, and restart the count.
+	 */
+	uint32_t Take(int index) {
+		return _calls[index].exchange(0, std::memory_order_relaxed);
+	}
+
+private:
+	std::atomic<uint32_t> _calls[kFrameCount];
+	/* monotonic time of the last counted read of each frame */
+	std::atomic<int64_t> _lastUs[kFrameCount];
+};
+
+} // namespace motorcontrol
+} // namespace phoenix
+} // namespace ctre
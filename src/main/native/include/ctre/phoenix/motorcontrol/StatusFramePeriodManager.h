@@ -0,0 +1,129 @@
+#pragma once
+
+#include <stdint.h>
+#include <chrono>
+#include <vector>
+#include "ctre/phoenix/ErrorCode.h"
+#include "ctre/phoenix/motorcontrol/StatusFrame.h"
+#include "ctre/phoenix/motorcontrol/StatusFrameDemand.h"
+#include "ctre/phoenix/tasking/IProcessable.h"
+
+namespace ctre {
+namespace phoenix {
+namespace motorcontrol {
+
+namespace can {
+class BaseMotorController;
+}
+
+/**
+ * Sets each status frame period from how often the application reads it.
+ *
+ * Every getter of a motor controller (and of its SensorCollection) counts a
+ * read of the status frame carrying the signal, with reads of the same frame
+ * in one loop tick counted once (see StatusFrameDemand).  Once per evaluation period
+ * the manager turns each frame's read rate into a period of half the
+ * interval between reads, so every read sees a fresh frame, then clamps it to
+ * the frame's bounds.  Frames that are never read are slowed to their upper
+ * bound.  A period is only resent when it moves by more than a quarter, or
+ * after the device resets and loses its periods.
+ *
+ * Call Process() periodically (such as once per loop), or add the manager to
+ * a scheduler as an IProcessable.
+ *
+ * Followers mirror their master's Status_1_General, so its default upper
+ * bound is kept at 20ms.
+ *
+ *	Example:
+ *		StatusFramePeriodManager manager;
+ *		manager.Add(_talonLeft);
+ *		manager.Add(_talonRght);
+ *		manager.SetBounds(StatusFrameEnhanced::Status_2_Feedback0, 5, 100);
+ *		...
+ *		manager.Process();	// every loop
+ */
+class StatusFramePeriodManager : public ctre::phoenix::tasking::IProcessable {
+public:
+	/**
+	 * Fastest period the manager will set, in ms.
+	 */
+	static const int kMinPeriodMs = 1;
+	/**
+	 * Slowest period the device supports, in ms.
+	 */
+	static const int kMaxPeriodMs = 255;
+
+	StatusFramePeriodManager();
+	virtual ~StatusFramePeriodManager() {}
+
+	/**
+	 * @brief Manage a controller's status frames, using the current default bounds.
+	 * @param motor Controller to manage, must outlive the manager or be removed.
+	 */
+	void Add(can::BaseMotorController & motor);
+	/**
+	 * @brief Stop managing a controller.  Its periods are left as last set.
+	 * @param motor Controller to remove.
+	 */
+	void Remove(can::BaseMotorController & motor);
+	/**
+	 * @brief Set the period bounds of a frame for every controller, including ones added later.
+	 * @param frame Frame to bound.
+	 * @param minPeriodMs Fastest period allowed.
+	 * @param maxPeriodMs Slowest period allowed, used when the frame is not read.
+	 * @return nonzero error code if the frame is not managed or the bounds are invalid.
+	 */
+	ErrorCode SetBounds(StatusFrameEnhanced frame, int minPeriodMs, int maxPeriodMs);
+	/**
+	 * @brief Set the period bounds of a frame for one controller.
+	 * @param motor Managed controller.
+	 * @param frame Frame to bound.
+	 * @param minPeriodMs Fastest period allowed.
+	 * @param maxPeriodMs Slowest period allowed, used when the frame is not read.
+	 * @return nonzero error code if the controller or frame is not managed or the bounds are invalid.
+	 */
+	ErrorCode SetBounds(can::BaseMotorController & motor, StatusFrameEnhanced frame, int minPeriodMs, int maxPeriodMs);
+	/**
+	 * @brief Set how often read rates are evaluated.
+	 * @param periodMs Evaluation period, long enough to average over many loops.
+	 * @return nonzero error code if the period is not positive.
+	 */
+	ErrorCode SetEvaluationPeriod(int periodMs);
+	/**
+	 * @param motor Managed controller.
+	 * @param frame Frame to look up.
+	 * @return Period last set for the frame in ms, 0 if not set yet.
+	 */
+	int GetPeriod(can::BaseMotorController & motor, StatusFrameEnhanced frame) const;
+	/**
+	 * @brief Evaluate read rates and update periods of every controller whose evaluation period has elapsed.
+	 */
+	virtual void Process();
+
+private:
+	typedef std::chrono::steady_clock Clock;
+
+	struct Bounds {
+		int minPeriodMs;
+		int maxPeriodMs;
+	};
+	struct Entry {
+		can::BaseMotorController * motor;
+		Bounds bounds[StatusFrameDemand::kFrameCount];
+		/* 0 until set, or after a reset */
+		int periodMs[StatusFrameDemand::kFrameCount];
+		uint32_t resetCount;
+		Clock::time_point windowStart;
+	};
+
+	static bool IsValid(int minPeriodMs, int maxPeriodMs);
+	void Evaluate(Entry & entry, int64_t windowMs);
+
+	std::vector<Entry> _entries;
+	Bounds _defaults[StatusFrameDemand::kFrameCount];
+	Clock::duration _evaluationPeriod;
+};
+
+} // namespace motorcontrol
+} // namespace phoenix
+} // namespace ctre
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <stdint.h>
+#include "ctre/phoenix/ErrorCode.h"
+#include "ctre/phoenix/motorcontrol/StatusFrame.h"
+
+namespace ctre {
+namespace phoenix {
+namespace motorcontrol {
+
+/**
+ * Signals of one motor controller status frame, decoded by
+ * BaseMotorController::GetStatusFrameSample.
+ * Only the signals carried by the sampled frame are filled, the rest are zero.
+ */
+struct StatusFrameSample {
+	/**
+	 * Frame the signals were decoded from
+	 */
+	StatusFrameEnhanced frame = StatusFrameEnhanced::Status_1_General;
+	/**
+	 * Monotonic time of the read (see GetMonotonicUs)
+	 */
+	int64_t timestampUs = 0;
+	/**
+	 * Error Code of the read. 0 indicates every signal is fresh.
+	 */
+	ErrorCode error = OK;
+
+	/**
+	 * Status_1_General: Motor output [-1,+1]
+	 */
+	double motorOutputPercent = 0;
+	/**
+	 * Status_1_General: Fault bits, see Faults
+	 */
+	int faults = 0;
+	/**
+	 * Status_2_Feedback0: Output current (in amps)
+	 */
+	double outputCurrent = 0;
+	/**
+	 * Status_2_Feedback0: Sticky fault bits, see StickyFaults
+	 */
+	int stickyFaults = 0;
+	/**
+	 * Status_2_Feedback0 (PID[0]) or Status_12_Feedback1 (PID[1]):
+	 * Selected sensor position (in raw sensor units)
+	 */
+	int selectedSensorPosition = 0;
+	/**
+	 * Status_2_Feedback0 (PID[0]) or Status_12_Feedback1 (PID[1]):
+	 * Selected sensor velocity (in raw sensor units per 100ms)
+	 */
+	int selectedSensorVelocity = 0;
+	/**
+	 * Status_3_Quadrature: Quadrature position
+	 */
+	int quadraturePosition = 0;
+	/**
+	 * Status_3_Quadrature: Quadrature velocity (in units per 100ms)
+	 */
+	int quadratureVelocity = 0;
+	/**
+	 * Status_4_AinTempVbat: Analog in position (24bit)
+	 */
+	int analogIn = 0;
+	/**
+	 * Status_4_AinTempVbat: Temperature (in 'C)
+	 */
+	double temperature = 0;
+	/**
+	 * Status_4_AinTempVbat: Bus voltage (in volts)
+	 */
+	double busVoltage = 0;
+	/**
+	 * Status_8_PulseWidth: Pulse width position
+	 */
+	int pulseWidthPosition = 0;
+	/**
+	 * Status_8_PulseWidth: Pulse width velocity (in units per 100ms)
+	 */
+	int pulseWidthVelocity = 0;
+	/**
+	 * Status_10_Targets: Active trajectory position of PID[0]
+	 */
+	int activeTrajectoryPosition = 0;
+	/**
+	 * Status_10_Targets: Active trajectory velocity of PID[0]
+	 */
+	int activeTrajectoryVelocity = 0;
+	/**
+	 * Status_13_Base_PIDF0 (PID[0]) or Status_14_Turn_PIDF1 (PID[1]):
+	 * Closed-loop error (in raw sensor units)
+	 */
+	int closedLoopError = 0;
+	/**
+	 * Status_13_Base_PIDF0 (PID[0]) or Status_14_Turn_PIDF1 (PID[1]):
+	 * Integral accumulator (in raw sensor units)
+	 */
+	double integralAccumulator = 0;
+	/**
+	 * Status_13_Base_PIDF0 (PID[0]) or Status_14_Turn_PIDF1 (PID[1]):
+	 * Error derivative (in raw sensor units per 1ms)
+	 */
+	double errorDerivative = 0;
+};
+
+} // namespace motorcontrol
+} // namespace phoenix
+} // namespace ctre
@@ -0,0 +1,183 @@
+#pragma once
+
+#include <stdint.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "ctre/phoenix/ErrorCode.h"
+#include "ctre/phoenix/SpscQueue.h"
+#include "ctre/phoenix/motorcontrol/StatusFrame.h"
+#include "ctre/phoenix/motorcontrol/StatusFrameSample.h"
+
+namespace ctre {
+namespace phoenix {
+namespace motorcontrol {
+
+namespace can {
+class BaseMotorController;
+}
+
+/**
+ * Delivers decoded status frames to subscribers at the frame's own rate,
+ * so control loops can be driven by data instead of polling getters on an
+ * unrelated schedule.
+ *
+ * Each subscription is one (controller, status frame) pair with either a
+ * callback or a SpscQueue.  A single thread samples every subscription once
+ * per frame period with BaseMotorController::GetStatusFrameSample and
+ * delivers the sample if the read was fresh.  Stale reads (the frame did not
+ * arrive) are not delivered.
+ *
+ * The device layer reports the latest frame but not when it arrived, so
+ * delivery follows the configured frame period rather than each arrival.
+ * Keep the period passed here equal to the one set with SetStatusFramePeriod.
+ * As the sampling phase drifts against the device, a frame can be read
+ * twice; a sample whose signals all match the last one delivered is
+ * dropped, unless two periods have passed since that delivery.  A
+ * stationary signal is then still delivered at half the frame rate, while
+ * a silent device delivers nothing.
+ *
+ * Frames are read and delivered without holding the subscription lock, so
+ * Subscribe and Unsubscribe do not wait behind the reads.  Removing or
+ * replacing a subscription that is being read waits for that read, so its
+ * controller and queue can be destroyed once the call returns.
+ *
+ * Callbacks run on the subscriber's thread and must not call Subscribe or
+ * Unsubscribe.  A queue's consumer must be a single thread.
+ *
+ *	Example:
+ *		StatusFrameSubscriber::Queue queue(16);
+ *		StatusFrameSubscriber subscriber;
+ *		subscriber.Subscribe(_talon, StatusFrameEnhanced::Status_2_Feedback0, queue, 10);
+ *		subscriber.Start();
+ *		...
+ *		StatusFrameSample sample;
+ *		while (queue.TryPop(sample)) { ... }
+ */
+class StatusFrameSubscriber {
+public:
+	/**
+	 * Callback invoked with each fresh sample
+	 */
+	typedef std::function<void(const StatusFrameSample &)> Callback;
+	/**
+	 * Queue receiving each fresh sample
+	 */
+	typedef ctre::phoenix::SpscQueue<StatusFrameSample> Queue;
+
+	StatusFrameSubscriber();
+	~StatusFrameSubscriber();
+	StatusFrameSubscriber(const StatusFrameSubscriber &) = delete;
+	StatusFrameSubscriber& operator=(const StatusFrameSubscriber &) = delete;
+
+	/**
+	 * Subscribe a callback to a status frame, replacing any existing
+	 * subscription for the pair.  Safe to call while running.
+	 *
+	 * @param motor Controller to sample, must outlive the subscription.
+	 * @param frame Frame to sample.
+	 * @param callback Callback invoked on the subscriber's thread.
+	 * @param periodMs Frame period in ms.  If zero, the period is read from the
+	 *            controller, which blocks for up to kPeriodTimeoutMs.
+	 * @return nonzero error code if the period is invalid or could not be read.
+	 */
+	ErrorCode Subscribe(can::BaseMotorController & motor, StatusFrameEnhanced frame, Callback callback, int periodMs = 0);
+	/**
+	 * Subscribe a queue to a status frame, replacing any existing
+	 * subscription for the pair.  Safe to call while running.
+	 * Samples are dropped and counted while the queue is full.
+	 *
+	 * @param motor Controller to sample, must outlive the subscription.
+	 * @param frame Frame to sample.
+	 * @param queue Queue to push into, must outlive the subscription.
+	 * @param periodMs Frame period in ms.  If zero, the period is read from the
+	 *            controller, which blocks for up to kPeriodTimeoutMs.
+	 * @return nonzero error code if the period is invalid or could not be read.
+	 */
+	ErrorCode Subscribe(can::BaseMotorController & motor, StatusFrameEnhanced frame, Queue & queue, int periodMs = 0);
+	/**
+	 * Subscribe a callback to a status frame.  See the StatusFrameEnhanced overload.
+	 */
+	ErrorCode Subscribe(can::BaseMotorController & motor, StatusFrame frame, Callback callback, int periodMs = 0);
+	/**
+	 * Subscribe a queue to a status frame.  See the StatusFrameEnhanced overload.
+	 */
+	ErrorCode Subscribe(can::BaseMotorController & motor, StatusFrame frame, Queue & queue, int periodMs = 0);
+	/**
+	 * Remove the subscription for a (controller, frame) pair.  Safe to call while running.
+	 * @param motor Subscribed controller.
+	 * @param frame Subscribed frame.
+	 */
+	void Unsubscribe(can::BaseMotorController & motor, StatusFrameEnhanced frame);
+	/**
+	 * Remove every subscription of a controller.  Safe to call while running.
+	 * @param motor Subscribed controller.
+	 */
+	void Unsubscribe(can::BaseMotorController & motor);
+	/**
+	 * Start the delivery thread.
+	 * @return nonzero error code if already running.
+	 */
+	ErrorCode Start();
+	/**
+	 * Stop the delivery thread and wait for it to exit.
+	 */
+	void Stop();
+	/**
+	 * @return true if the delivery thread is running.
+	 */
+	bool IsRunning() const { return _running; }
+	/**
+	 * @return Number of samples dropped because a queue was full.
+	 */
+	uint32_t GetDroppedCount() const { return _dropped; }
+
+	/**
+	 * Timeout when reading a frame period from the controller.
+	 */
+	static const int kPeriodTimeoutMs = 10;
+
+private:
+	typedef std::chrono::steady_clock Clock;
+
+	struct Subscription {
+		can::BaseMotorController * motor;
+		StatusFrameEnhanced frame;
+		Clock::duration period;
+		Callback callback;
+		Queue * queue;
+		/* only touched by the delivery thread */
+		Clock::time_point due;
+		StatusFrameSample last;
+		bool haveLast;
+		Clock::time_point lastDelivered;
+	};
+	typedef std::shared_ptr<Subscription> SubscriptionPtr;
+
+	ErrorCode Add(can::BaseMotorController & motor, StatusFrameEnhanced frame, Callback callback, Queue * queue, int periodMs);
+	void WaitForSample(std::unique_lock<std::mutex> & lock, const Subscription * subscription);
+	void Sample(Subscription & subscription, Clock::time_point now);
+	void Run();
+
+	std::mutex _lck;
+	/* wakes the thread when subscriptions change or on Stop */
+	std::condition_variable _changed;
+	/* signalled when the subscriptions in _sampling have been read */
+	std::condition_variable _sampled;
+	std::vector<SubscriptionPtr> _subscriptions;
+	/* subscriptions being read without the lock */
+	std::vector<const Subscription *> _sampling;
+	std::atomic<uint32_t> _dropped;
+
+	std::thread _thread;
+	std::atomic<bool> _running;
+};
+
+} // namespace motorcontrol
+} // namespace phoenix
+} // namespace ctre
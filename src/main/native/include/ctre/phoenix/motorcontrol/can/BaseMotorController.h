@@ -9,6 +9,10 @@
 #include "ctre/phoenix/motorcontrol/Faults.h"
 #include "ctre/phoenix/motorcontrol/FollowerType.h"
 #include "ctre/phoenix/motorcontrol/InvertType.h"
+#include "ctre/phoenix/motorcontrol/MotorTelemetrySnapshot.h"
+#include "ctre/phoenix/motorcontrol/OutputTransaction.h"
+#include "ctre/phoenix/motorcontrol/StatusFrameDemand.h"
+#include "ctre/phoenix/motorcontrol/StatusFrameSample.h"
 #include "ctre/phoenix/motorcontrol/StickyFaults.h"
 #include "ctre/phoenix/motorcontrol/VelocityMeasPeriod.h"
 #include "ctre/phoenix/motion/TrajectoryPoint.h"
@@ -16,7 +20,15 @@
 #include "ctre/phoenix/motion/BufferedTrajectoryPointStream.h"
 #include "ctre/phoenix/CANBusAddressable.h"
 #include "ctre/phoenix/CustomParamConfiguration.h"
+#include "ctre/phoenix/ConfigReadback.h"
+#include "ctre/phoenix/ConfigReconcile.h"
+#include "ctre/phoenix/ConfigShadow.h"
+#include "ctre/phoenix/DeviceStats.h"
+#include "ctre/phoenix/SeqLock.h"
+#include "ctre/phoenix/Timestamped.h"
 
+#include <atomic>
+#include <chrono>
 #include <string>
 
 /* forward proto's */
@@ -574,15 +586,50 @@ class BaseMotorControllerUtil : public ctre::phoenix::CustomParamConfigUtil {
  */
 class BaseMotorController: public virtual IMotorController {
 private:
-	ControlMode m_controlMode = ControlMode::PercentOutput;
+	/* atomic, a MotionProfileFeeder reads it from its own thread */
+	std::atomic<ControlMode> m_controlMode{ControlMode::PercentOutput};
 	ControlMode m_sendMode = ControlMode::PercentOutput;
 
 	int _arbId = 0;
 	double m_setPoint = 0;
 	InvertType _invert = InvertType::None;
 
+	ctre::phoenix::ConfigShadow _configShadow;
+	ctre::phoenix::DeviceStats _stats;
+
+	ctre::phoenix::motorcontrol::StatusFrameDemand _frameDemand;
+
+	friend class ctre::phoenix::motorcontrol::OutputTransaction;
+	/* demand staged by an open OutputTransaction */
+	ctre::phoenix::motorcontrol::OutputTransaction * _transaction = nullptr;
+	ControlMode _stagedMode = ControlMode::Disabled;
+	double _stagedDemand0 = 0;
+	DemandType _stagedDemand1Type = DemandType_Neutral;
+	double _stagedDemand1 = 0;
+
+	void SendDemand(ControlMode mode, double demand0, DemandType demand1Type, double demand1);
+	void SendStagedDemand();
+
+	/* last demand forwarded, for skipping unchanged Set() calls */
+	bool _suppressSets = false;
+	int _setKeepaliveMs = 100;
+	bool _lastSentValid = false;
+	ControlMode _lastSentMode = ControlMode::Disabled;
+	double _lastSentDemand0 = 0;
+	DemandType _lastSentDemand1Type = DemandType_Neutral;
+	double _lastSentDemand1 = 0;
+	std::chrono::steady_clock::time_point _lastSentTime;
+	uint32_t _setsForwarded = 0;
+	uint32_t _setsSuppressed = 0;
+
+	ctre::phoenix::SeqLock<MotorTelemetrySnapshot> _telemetry;
+
 	ctre::phoenix::ErrorCode ConfigureSlot(const SlotConfiguration &slot, int slotIdx, int timeoutMs, bool enableOptimizations);
 	ctre::phoenix::ErrorCode ConfigureFilter(const FilterConfiguration &filter, int ordinal, int timeoutMs, bool enableOptimizations);
+	void AddSlotConfigs(ctre::phoenix::ConfigReadback &readback, SlotConfiguration &slot, int slotIdx);
+	void AddFilterConfigs(ctre::phoenix::ConfigReadback &readback, FilterConfiguration &filter, int ordinal);
+	ctre::phoenix::ErrorCode ReconcileSlot(const SlotConfiguration &slot, const SlotConfiguration &actual, int slotIdx, ctre::phoenix::ConfigReconcileReport &report, int timeoutMs);
+	ctre::phoenix::ErrorCode ReconcileFilter(const FilterConfiguration &filter, const FilterConfiguration &actual, int ordinal, ctre::phoenix::ConfigReconcileReport &report, int timeoutMs);
 
 protected:
 	/**
@@ -593,6 +640,25 @@ protected:
 	 * @return CCI handle for child classes.
 	 */
 	void* GetHandle();
+	/**
+	 * @return config shadow, invalidated first if the device has reset.
+	 */
+	ctre::phoenix::ConfigShadow & Shadow();
+	/**
+	 * Configures a limit switch source and records it in the config shadow.
+	 *
+	 * @param ordinal           0 for forward limit switch, 1 for reverse.
+	 * @param type              Limit switch source.
+	 * @param normalOpenOrClose Setting for normally open, normally closed, or disabled.
+	 * @param deviceID          Device ID of remote source, -1 if local.
+	 * @param timeoutMs
+	 *              Timeout value in ms. If nonzero, function will wait for
+	 *              config success and report an error if it times out.
+	 *              If zero, no blocking or checking is performed.
+	 * @return Error Code generated by function. 0 indicates no error.
+	 */
+	ctre::phoenix::ErrorCode ConfigLimitSwitchSourceShadowed(int ordinal, LimitSwitchSource type,
+			LimitSwitchNormal normalOpenOrClose, int deviceID, int timeoutMs);
     /**
      * Configures all base persistant settings.
      *
@@ -626,6 +692,46 @@ protected:
      *              If zero, no blocking or checking is performed.
      */
 	virtual void BaseGetPIDConfigs(BasePIDSetConfiguration &pid, int pidIdx, int timeoutMs);
+	/**
+	 * Creates an empty batched config readback for this device.
+	 *
+	 * @param timeoutMs
+	 *              Timeout value in ms for the entire readback.
+	 *              If zero, no blocking is performed.
+	 * @return Readback to register parameters with.
+	 */
+	ctre::phoenix::ConfigReadback NewConfigReadback(int timeoutMs);
+	/**
+	 * Registers all base persistant settings with a batched readback.
+	 *
+	 * @param readback          Readback to register parameters with
+	 * @param allConfigs        Object to fill with all of the base persistant settings
+	 */
+	void BaseGetAllConfigsAsync(ctre::phoenix::ConfigReadback &readback, BaseMotorControllerConfiguration &allConfigs);
+	/**
+	 * Registers all base PID set persistant settings with a batched readback.
+	 *
+	 * @param readback      Readback to register parameters with
+	 * @param pid           Object to fill with all of the base PID set persistant settings
+	 * @param pidIdx        0 for Primary closed-loop. 1 for auxiliary closed-loop.
+	 */
+	void BaseGetPIDConfigsAsync(ctre::phoenix::ConfigReadback &readback, BasePIDSetConfiguration &pid, int pidIdx);
+	/**
+	 * Writes only the base persistant settings that differ from the device's
+	 * actual settings.  No factory default is performed.
+	 *
+	 * @param allConfigs        Object with all of the requested base persistant settings
+	 * @param actual            Object with the base persistant settings read back from the device
+	 * @param report            Report to record the changed parameters in
+	 * @param timeoutMs
+	 *              Timeout value in ms. If nonzero, function will wait for
+	 *              config success and report an error if it times out.
+	 *              If zero, no blocking or checking is performed.
+	 *
+	 * @return Error Code generated by function. 0 indicates no error.
+	 */
+	ctre::phoenix::ErrorCode BaseReconcileAllSettings(const BaseMotorControllerConfiguration &allConfigs,
+			const BaseMotorControllerConfiguration &actual, ctre::phoenix::ConfigReconcileReport &report, int timeoutMs);
 	
     //------ General Status ----------//
 	/**
@@ -634,6 +740,13 @@ protected:
 	 * @return The output current (in amps).
 	 */
 	virtual double GetOutputCurrent();
+	/**
+	 * Gets the output current (in amps) with the time of the read, see Timestamped.
+	 *
+	 * @param outputCurrent Caller's value to update.
+	 * @return Error Code of the read. 0 indicates the value is fresh.
+	 */
+	ctre::phoenix::ErrorCode GetOutputCurrent(Timestamped<double> & outputCurrent);
 public:
 	/**
 	 * Constructor for motor controllers.
@@ -731,12 +844,39 @@ public:
 	 *	Note: Other configurations (sensor selection, PID gains, etc.) need to be set.
 	 *		_talonLeft.follow(_talonRght, FollwerType.AuxOutput1);
 	 *		_talonRght.set(ControlMode.MotionMagic, targetDistance, DemandType.AuxPID, desiredRobotHeading);
+	 *
+	 *	If an OutputTransaction is open on the calling thread, the demand is
+	 *	staged and sent when the transaction commits.
 	 */
 	virtual void Set(ControlMode mode, double demand0, DemandType demand1Type, double demand1);
 	/**
 	 * Neutral the motor output by setting control mode to disabled.
 	 */
 	virtual void NeutralOutput();
+	/**
+	 * Skips Set() calls that repeat the last demand sent, avoiding the
+	 * lower-level encode and dispatch.  The demand is still forwarded at
+	 * least every keepaliveMs, and after anything that changes the control
+	 * mode behind Set(), such as StartMotionProfile().
+	 *
+	 * @param enable
+	 *            true to skip unchanged demands. Disabled by default.
+	 * @param keepaliveMs
+	 *            Longest time an unchanged demand is skipped for.
+	 */
+	void EnableSetSuppression(bool enable, int keepaliveMs = 100);
+	/**
+	 * @return Number of Set() calls forwarded to the lower level.
+	 */
+	uint32_t GetSetsForwarded() const;
+	/**
+	 * @return Number of Set() calls skipped as unchanged.
+	 */
+	uint32_t GetSetsSuppressed() const;
+	/**
+	 * Zeroes the forwarded and suppressed Set() counters.
+	 */
+	void ClearSetCounters();
 	/**
 	 * Sets the mode of operation during neutral throttle output.
 	 *
@@ -960,12 +1100,26 @@ public:
 	 * @return The bus voltage value (in volts).
 	 */
 	virtual double GetBusVoltage();
+	/**
+	 * Gets the bus voltage (in volts) with the time of the read, see Timestamped.
+	 *
+	 * @param busVoltage Caller's value to update.
+	 * @return Error Code of the read. 0 indicates the value is fresh.
+	 */
+	ctre::phoenix::ErrorCode GetBusVoltage(Timestamped<double> & busVoltage);
 	/**
 	 * Gets the output percentage of the motor controller.
 	 *
 	 * @return Output of the motor controller (in percent).
 	 */
 	virtual double GetMotorOutputPercent();
+	/**
+	 * Gets the motor output [-1,+1] with the time of the read, see Timestamped.
+	 *
+	 * @param motorOutputPercent Caller's value to update.
+	 * @return Error Code of the read. 0 indicates the value is fresh.
+	 */
+	ctre::phoenix::ErrorCode GetMotorOutputPercent(Timestamped<double> & motorOutputPercent);
 	/**
 	 * @return applied voltage to motor  in volts.
 	 */
@@ -976,6 +1130,32 @@ public:
 	 * @return Temperature of the motor controller (in 'C)
 	 */
 	virtual double GetTemperature();
+	/**
+	 * Gets the temperature (in 'C) with the time of the read, see Timestamped.
+	 *
+	 * @param temperature Caller's value to update.
+	 * @return Error Code of the read. 0 indicates the value is fresh.
+	 */
+	ctre::phoenix::ErrorCode GetTemperature(Timestamped<double> & temperature);
+	/**
+	 * Reads position, velocity, current, bus voltage, temperature, output,
+	 * closed-loop error and faults in one call, and publishes them as the
+	 * latest snapshot for GetLastTelemetry().
+	 *
+	 * @param snapshot
+	 *            Caller's snapshot to fill.
+	 * @return First error reading the signals. 0 indicates every signal is fresh.
+	 */
+	ctre::phoenix::ErrorCode GetTelemetry(MotorTelemetrySnapshot & snapshot);
+	/**
+	 * Copies the snapshot last taken by GetTelemetry() without any reads.
+	 * Lock-free and consistent, so another thread (such as a logger) can
+	 * read while GetTelemetry() runs.
+	 *
+	 * @param snapshot
+	 *            Caller's snapshot to fill.
+	 */
+	void GetLastTelemetry(MotorTelemetrySnapshot & snapshot) const;
 	//------ sensor selection ----------//
 	/**
 	 * Select the remote feedback device for the motor controller.
@@ -1096,6 +1276,15 @@ public:
 	 * @return Position of selected sensor (in raw sensor units).
 	 */
 	virtual int GetSelectedSensorPosition(int pidIdx = 0);
+	/**
+	 * Gets the selected sensor position (in raw sensor units) with the time of the read, see Timestamped.
+	 *
+	 * @param position Caller's value to update.
+	 * @param pidIdx
+	 *            0 for Primary closed-loop. 1 for auxiliary closed-loop.
+	 * @return Error Code of the read. 0 indicates the value is fresh.
+	 */
+	ctre::phoenix::ErrorCode GetSelectedSensorPosition(Timestamped<int> & position, int pidIdx = 0);
 	/**
 	 * Get the selected sensor velocity.
 	 *
@@ -1105,6 +1294,15 @@ public:
 	 * See Phoenix-Documentation for how to interpret.
 	 */
 	virtual int GetSelectedSensorVelocity(int pidIdx = 0);
+	/**
+	 * Gets the selected sensor velocity (in raw sensor units per 100ms) with the time of the read, see Timestamped.
+	 *
+	 * @param velocity Caller's value to update.
+	 * @param pidIdx
+	 *            0 for Primary closed-loop. 1 for auxiliary closed-loop.
+	 * @return Error Code of the read. 0 indicates the value is fresh.
+	 */
+	ctre::phoenix::ErrorCode GetSelectedSensorVelocity(Timestamped<int> & velocity, int pidIdx = 0);
 	/**
 	 * Sets the sensor position to the given value.
 	 *
@@ -1196,6 +1394,23 @@ public:
 	 * @return Period of the given status frame.
 	 */
 	virtual int GetStatusFramePeriod(StatusFrameEnhanced frame, int timeoutMs = 0);
+	/**
+	 * Reads the signals carried by a status frame in one call.
+	 *
+	 * @param frame
+	 *            Frame to decode.  Status_1_General, Status_2_Feedback0,
+	 *            Status_3_Quadrature, Status_4_AinTempVbat, Status_8_PulseWidth,
+	 *            Status_10_Targets, Status_12_Feedback1, Status_13_Base_PIDF0
+	 *            and Status_14_Turn_PIDF1 are supported.
+	 * @param sample
+	 *            Caller's sample to fill.
+	 * @return Error Code of the reads. 0 indicates every signal is fresh.
+	 */
+	ctre::phoenix::ErrorCode GetStatusFrameSample(StatusFrameEnhanced frame, StatusFrameSample & sample);
+	/**
+	 * @return Counts of getter calls per status frame, see StatusFramePeriodManager.
+	 */
+	ctre::phoenix::motorcontrol::StatusFrameDemand & GetStatusFrameDemand() { return _frameDemand; }
 	//----- velocity signal conditionaing ------//
 	/**
 	 * Sets the period over which velocity measurements are taken.
@@ -1607,6 +1822,15 @@ public:
 	 * @return Closed-loop error value.
 	 */
 	virtual int GetClosedLoopError(int pidIdx = 0);
+	/**
+	 * Gets the closed-loop error (in raw sensor units) with the time of the read, see Timestamped.
+	 *
+	 * @param closedLoopError Caller's value to update.
+	 * @param pidIdx
+	 *            0 for Primary closed-loop. 1 for auxiliary closed-loop.
+	 * @return Error Code of the read. 0 indicates the value is fresh.
+	 */
+	ctre::phoenix::ErrorCode GetClosedLoopError(Timestamped<int> & closedLoopError, int pidIdx = 0);
 	/**
 	 * Gets the iaccum value.
 	 *
@@ -1787,6 +2011,10 @@ public:
 	 * The legacy API from previous years requires the calling application to pass points via the ProcessMotionProfileBuffer and PushMotionProfileTrajectory.
 	 * This is no longer required if using this StartMotionProfile/IsMotionProfileFinished API.
 	 *
+	 * Any points still staged in the stream are flushed first, one motor controller layer
+	 * call per point, see BufferedTrajectoryPointStream::Flush().  Packed points are all
+	 * decoded at this time, so use a MotionProfileFeeder to decode them as they are consumed.
+	 *
 	 * @param stream	A buffer that will be used to stream the trajectory points.  Caller can fill this container with the entire trajectory point, regardless of size.
 	 * @param minBufferedPts	Minimum number of firmware buffered points before starting MP.  
 	 *							Do not exceed device's firmware buffer capacity or MP will never fire (120 for Motion Profile, or 60 for Motion Profile Arc).
@@ -1822,7 +2050,8 @@ public:
 	 * profile. So if MP is running with 20ms trajectory points, try calling
 	 * this routine every 10ms. All motion profile functions are thread-safe
 	 * through the use of a mutex, so there is no harm in having the caller
-	 * utilize threading.
+	 * utilize threading.  Alternatively, add the controller to a
+	 * MotionProfileFeeder to have this serviced from a library thread.
 	 */
 	virtual void ProcessMotionProfileBuffer();
 	/**
@@ -2051,6 +2280,14 @@ public:
 	 * @return Last Error Code generated by a function.
 	 */
 	virtual ctre::phoenix::ErrorCode GetLastError();
+	/**
+	 * Gets the error and latency statistics of this object.  Every config
+	 * call, and every other call that returns an Error Code, is counted by
+	 * Error Code, function and timeout outcome.
+	 *
+	 * @return Statistics of this object, see DeviceStats.
+	 */
+	ctre::phoenix::DeviceStats & GetStats() { return _stats; }
 	//------ Faults ----------//
 	/**
 	 * Polls the various fault flags.
@@ -2092,6 +2329,44 @@ public:
 	 * @return Has a Device Reset Occurred?
 	 */
 	virtual bool HasResetOccurred();
+	/**
+	 * Counts device resets without consuming HasResetOccurred(), so several
+	 * helpers (such as StatusFramePeriodManager) can each detect a reset.
+	 *
+	 * @return Number of device resets observed since construction.
+	 */
+	uint32_t GetResetCount();
+	//------ Config Shadow ----------//
+	/**
+	 * Enables the client-side config shadow, see ConfigShadow.
+	 *
+	 * @param enable
+	 *            true to enable the shadow, false to disable and clear it.
+	 * @param maxAgeMs
+	 *            Entries older than this are read from the device again.
+	 *            Zero to keep entries until the device resets.
+	 */
+	void EnableConfigShadow(bool enable, int maxAgeMs = 0);
+	/**
+	 * Clears the config shadow so the next config reads go to the device.
+	 */
+	void InvalidateConfigShadow();
+	/**
+	 * @return Checksum over the config shadow. Compare against a previously
+	 *         saved checksum to detect that the shadowed configuration changed.
+	 */
+	uint32_t GetConfigShadowChecksum();
+	/**
+	 * Reads back every shadowed parameter in a single batch and drops any entry
+	 * that no longer matches the device, so the next write of it goes through.
+	 *
+	 * @param mismatches
+	 *            Filled with the number of shadowed parameters that did not match.
+	 * @param timeoutMs
+	 *            Timeout value in ms for the entire readback.
+	 * @return Error Code generated by function. 0 indicates every parameter was read.
+	 */
+	ctre::phoenix::ErrorCode VerifyConfigShadow(int & mismatches, int timeoutMs = 50);
 	//------ Custom Persistent Params ----------//
 	/**
 	 * Sets the value of a custom parameter. This is for arbitrary use.
@@ -261,6 +261,7 @@ private:
 	ctre::phoenix::motorcontrol::SensorCollection * _sensorColl;
 
 	ctre::phoenix::ErrorCode ConfigurePID(const TalonSRXPIDSetConfiguration &pid, int pidIdx, int timeoutMs, bool enableOptimizations);
+	ctre::phoenix::ErrorCode ReconcilePID(const TalonSRXPIDSetConfiguration &pid, const TalonSRXPIDSetConfiguration &actual, int pidIdx, ctre::phoenix::ConfigReconcileReport &report, int timeoutMs);
 public:
 	/**
 	 * Constructor for a Talon
@@ -376,6 +377,8 @@ public:
 	 * @return The output current (in amps).
 	 */
     virtual double GetOutputCurrent();
+	/* keep the timestamped overload visible, see BaseMotorController */
+	using BaseMotorController::GetOutputCurrent;
 
 	//------ Velocity measurement ----------//
 	/**
@@ -620,6 +623,24 @@ public:
      * @return Error Code generated by function. 0 indicates no error. 
      */
 	ctre::phoenix::ErrorCode ConfigAllSettings(const TalonSRXConfiguration &allConfigs, int timeoutMs = 50);
+    /**
+     * Configures all peristant settings by reconciling against the device's
+     * actual settings.  The current settings are read back in one batch, then
+     * only the parameters that differ are written.  Unlike ConfigAllSettings,
+     * no factory default is performed, so a device that already holds the
+     * requested settings generates no config writes.
+     *
+	 * @param allConfigs        Object with all of the persistant settings
+	 * @param report            Report filled with the parameters that were changed
+     * @param timeoutMs
+     *              Timeout value in ms. If nonzero, function will wait for
+     *              config success and report an error if it times out.
+     *              If zero, the readback cannot complete and every
+     *              parameter is written without blocking or checking.
+     *
+     * @return Error Code generated by function. 0 indicates no error.
+     */
+	ctre::phoenix::ErrorCode ConfigReconcileAllSettings(const TalonSRXConfiguration &allConfigs, ctre::phoenix::ConfigReconcileReport &report, int timeoutMs = 50);
     /**
      * Gets all persistant settings.
      *
@@ -630,6 +651,21 @@ public:
      *              If zero, no blocking or checking is performed.
      */
 	void GetAllConfigs(TalonSRXConfiguration &allConfigs, int timeoutMs = 50);
+    /**
+     * Gets all persistant settings using a single batched readback.
+     * All parameter requests are sent immediately, and the returned readback
+     * collects the responses in any order.  The entire readback is bounded by
+     * timeoutMs rather than one timeout per parameter.
+     *
+	 * @param allConfigs        Object to fill with all of the persistant settings.
+	 *                          Must outlive the returned readback.
+     * @param timeoutMs
+     *              Timeout value in ms for the entire readback.
+     *              If zero, no blocking is performed.
+     *
+     * @return Readback to Poll() or Wait() on.
+     */
+	ctre::phoenix::ConfigReadback GetAllConfigsAsync(TalonSRXConfiguration &allConfigs, int timeoutMs = 50);
 };// class TalonSRX
 
 
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <array>
+#include <stdint.h>
+#include "ctre/phoenix/ErrorCode.h"
+#include "ctre/phoenix/Timestamped.h"
+
+namespace ctre {
+namespace phoenix {
+namespace sensors {
+
+/**
+ * Orientation, rates and acceleration of a Pigeon IMU captured in one call.
+ * Every value carries the time of its last fresh read, see Timestamped.
+ * Values read fresh by the same snapshot share one timestamp, snapshotUs.
+ */
+struct ImuSnapshot {
+	/**
+	 * 6d quaternion w[0], x[1], y[2], z[3]
+	 */
+	Timestamped<std::array<double, 4>> quaternion;
+	/**
+	 * Yaw[0], pitch[1] and roll[2] (in degrees)
+	 */
+	Timestamped<std::array<double, 3>> yawPitchRoll;
+	/**
+	 * Raw gyro x[0], y[1] and z[2] (in degrees per second)
+	 */
+	Timestamped<std::array<double, 3>> rawGyro;
+	/**
+	 * AccumGyro x[0], y[1] and z[2] (in degrees)
+	 */
+	Timestamped<std::array<double, 3>> accumGyro;
+	/**
+	 * Biased accelerometer x[0], y[1] and z[2] (Q2.14, 16384 = 1G)
+	 */
+	Timestamped<std::array<int16_t, 3>> biasedAccelerometer;
+	/**
+	 * Fused heading (in degrees)
+	 */
+	Timestamped<double> fusedHeading;
+	/**
+	 * Fused heading is fusing compass, see PigeonIMU::FusionStatus
+	 */
+	bool isFusing = false;
+	/**
+	 * Fused heading is valid, see PigeonIMU::FusionStatus
+	 */
+	bool isFusionValid = false;
+	/**
+	 * True if no new quaternion arrived while the signals were read.  Only
+	 * bounds the read time, the other signals come from their own frames.
+	 * Always false when taken with a single attempt, which skips the check.
+	 */
+	bool consistent = false;
+	/**
+	 * Number of times the signals were read, see GetImuSnapshot()
+	 */
+	int attempts = 0;
+	/**
+	 * Monotonic time the snapshot was taken, zero if never
+	 */
+	int64_t snapshotUs = 0;
+	/**
+	 * First error reading the signals. 0 indicates every signal is fresh.
+	 */
+	ErrorCode error = OK;
+};
+
+} // namespace sensors
+} // namespace phoenix
+} // namespace ctre
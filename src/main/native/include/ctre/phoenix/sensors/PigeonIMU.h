@@ -23,11 +23,18 @@
 
 #pragma once
 
+#include <array>
 #include <string>
 #include "ctre/phoenix/CANBusAddressable.h"
 #include "ctre/phoenix/CustomParamConfiguration.h"
+#include "ctre/phoenix/ConfigReadback.h"
+#include "ctre/phoenix/ConfigShadow.h"
+#include "ctre/phoenix/DeviceStats.h"
 #include "ctre/phoenix/paramEnum.h"
 #include "ctre/phoenix/ErrorCode.h"
+#include "ctre/phoenix/SeqLock.h"
+#include "ctre/phoenix/Timestamped.h"
+#include "ctre/phoenix/sensors/ImuSnapshot.h"
 #include "ctre/phoenix/sensors/PigeonIMU_ControlFrame.h"
 #include "ctre/phoenix/sensors/PigeonIMU_Faults.h"
 #include "ctre/phoenix/sensors/PigeonIMU_StatusFrame.h"
@@ -168,6 +175,32 @@ public:
 		 */
 		UserCalibration,
 	};
+	/**
+	 * Identifies the description of a general status,
+	 * see GetGeneralStatusDescription().
+	 */
+	enum GeneralStatusDescription {
+		/** Status frame was not received */
+		Description_NoComm,
+		/** Boot-calibrating before entering a calibration mode */
+		Description_CalIsBooting,
+		/** Boot-calibration: gyro and accelerometer are being biased */
+		Description_CalBootTareGyroAccel,
+		/** Temperature calibration */
+		Description_CalTemperature,
+		/** Magnetometer level 1 (12 point) calibration */
+		Description_CalMagnetometer12Pt,
+		/** Magnetometer level 2 (360) calibration */
+		Description_CalMagnetometer360,
+		/** Accelerometer calibration */
+		Description_CalAccelerometer,
+		/** Running normally */
+		Description_Ready,
+		/** Boot-calibrating after power up */
+		Description_Initializing,
+		/** Not enough data to determine status */
+		Description_Unknown,
+	};
 	/**
 	 * Data object for status on current calibration and general status.
 	 *
@@ -250,6 +283,32 @@ public:
 		 */
 		int lastError;
 	};
+	/**
+	 * Numeric form of GeneralStatus, filled without any heap allocation.
+	 * The description is an ID, see GetGeneralStatusDescription() for its text.
+	 */
+	struct GeneralStatusData {
+		/** See GeneralStatus::state */
+		PigeonIMU::PigeonState state;
+		/** See GeneralStatus::currentMode */
+		PigeonIMU::CalibrationMode currentMode;
+		/** See GeneralStatus::calibrationError */
+		int calibrationError;
+		/** See GeneralStatus::bCalIsBooting */
+		bool bCalIsBooting;
+		/** Identifies the description of the status */
+		GeneralStatusDescription description;
+		/** See GeneralStatus::tempC */
+		double tempC;
+		/** See GeneralStatus::upTimeSec */
+		int upTimeSec;
+		/** See GeneralStatus::noMotionBiasCount */
+		int noMotionBiasCount;
+		/** See GeneralStatus::tempCompensationCount */
+		int tempCompensationCount;
+		/** Same as GetLastError() */
+		int lastError;
+	};
 
 	/**
 	 * Create a Pigeon object that communicates with Pigeon on CAN Bus.
@@ -428,6 +487,23 @@ public:
 	 * @return Error Code generated by function. 0 indicates no error.
 	 */
 	int GetGeneralStatus(PigeonIMU::GeneralStatus & statusToFill);
+	/**
+	 * Get the status of the current (or previousley complete) calibration,
+	 * without building the description text.  Does no heap allocation, so it
+	 * is suitable for periodic health checks.
+	 *
+	 * @param [out] statusToFill Container for the status information.
+	 * @return Error Code generated by function. 0 indicates no error.
+	 */
+	int GetGeneralStatus(PigeonIMU::GeneralStatusData & statusToFill);
+	/**
+	 * Build the description text of a general status, the same text as
+	 * GeneralStatus::description.
+	 *
+	 * @param status Status filled by GetGeneralStatus().
+	 * @return Human-readable description.
+	 */
+	static std::string GetGeneralStatusDescription(const PigeonIMU::GeneralStatusData & status);
 	/**
 	 * Call GetLastError() generated by this object.
 	 * Not all functions return an error code but can
@@ -438,6 +514,14 @@ public:
 	 * @return The last ErrorCode generated.
 	 */
 	ErrorCode GetLastError();
+	/**
+	 * Gets the error and latency statistics of this object.  Every config
+	 * call, and every other call that returns an Error Code, is counted by
+	 * Error Code, function and timeout outcome.
+	 *
+	 * @return Statistics of this object, see DeviceStats.
+	 */
+	DeviceStats & GetStats() { return _stats; }
 	/**
 	 * Get 6d Quaternion data.
 	 *
@@ -455,6 +539,13 @@ public:
 	 * @return The last ErrorCode generated.
 	 */
 	int GetYawPitchRoll(double ypr[3]);
+	/**
+	 * Gets yaw[0], pitch[1] and roll[2] (in degrees) with the time of the read, see Timestamped.
+	 *
+	 * @param ypr Caller's value to update.
+	 * @return Error Code of the read. 0 indicates the value is fresh.
+	 */
+	ErrorCode GetYawPitchRoll(Timestamped<std::array<double, 3>> & ypr);
 	/**
 	 * Get AccumGyro data.
 	 * AccumGyro is the integrated gyro value on each axis.
@@ -463,6 +554,13 @@ public:
 	 * @return The last ErrorCode generated.
 	 */
 	int GetAccumGyro(double xyz_deg[3]);
+	/**
+	 * Gets the AccumGyro x[0], y[1] and z[2] (in degrees) with the time of the read, see Timestamped.
+	 *
+	 * @param xyz_deg Caller's value to update.
+	 * @return Error Code of the read. 0 indicates the value is fresh.
+	 */
+	ErrorCode GetAccumGyro(Timestamped<std::array<double, 3>> & xyz_deg);
 	/**
 	 * Get the absolute compass heading.
 	 * @return compass heading [0,360) degrees.
@@ -523,6 +621,13 @@ public:
 	 * @return The last ErrorCode generated.
 	 */
 	int GetBiasedAccelerometer(int16_t ba_xyz[3]);
+	/**
+	 * Gets the biased accelerometer x[0], y[1] and z[2] (Q2.14, 16384 = 1G) with the time of the read, see Timestamped.
+	 *
+	 * @param ba_xyz Caller's value to update.
+	 * @return Error Code of the read. 0 indicates the value is fresh.
+	 */
+	ErrorCode GetBiasedAccelerometer(Timestamped<std::array<int16_t, 3>> & ba_xyz);
 	/**
 	 * Get Raw Gyro data.
 	 *
@@ -530,6 +635,13 @@ public:
 	 * @return The last ErrorCode generated.
 	 */
 	int GetRawGyro(double xyz_dps[3]);
+	/**
+	 * Gets the raw gyro x[0], y[1] and z[2] (in degrees per second) with the time of the read, see Timestamped.
+	 *
+	 * @param xyz_dps Caller's value to update.
+	 * @return Error Code of the read. 0 indicates the value is fresh.
+	 */
+	ErrorCode GetRawGyro(Timestamped<std::array<double, 3>> & xyz_dps);
 	/**
 	 * Get Accelerometer tilt angles.
 	 *
@@ -551,6 +663,42 @@ public:
 	 * @return The fused heading in degrees.
 	 */
 	double GetFusedHeading();
+	/**
+	 * Gets the fused heading (in degrees) with the time of the read, see Timestamped.
+	 *
+	 * @param fusedHeading Caller's value to update.
+	 * @return Error Code of the read. 0 indicates the value is fresh.
+	 */
+	ErrorCode GetFusedHeading(Timestamped<double> & fusedHeading);
+	/**
+	 * Reads the quaternion, yaw/pitch/roll, raw gyro, AccumGyro, biased
+	 * accelerometer and fused heading with its fusion status in one call,
+	 * and publishes them as the latest snapshot for GetLastImuSnapshot().
+	 *
+	 * By default each signal is read once, six reads in all, the same as the
+	 * individual getters, and the snapshot is not checked for consistency.
+	 *
+	 * With maxAttempts above one the quaternion is read again after the other
+	 * signals, and the signals are re-read while it changed.  A consistent
+	 * snapshot only means no new quaternion frame arrived while the signals
+	 * were read, which bounds the read time to one quaternion frame period;
+	 * yaw/pitch/roll, gyro, accelerometer and fused heading come from other
+	 * status frames with their own periods and ages.  Each attempt then costs
+	 * seven reads.
+	 *
+	 * @param snapshot Caller's snapshot to fill.
+	 * @param maxAttempts Most times to read the signals, at least once.
+	 * @return First error reading the signals. 0 indicates every signal is fresh.
+	 */
+	ErrorCode GetImuSnapshot(ImuSnapshot & snapshot, int maxAttempts = 1);
+	/**
+	 * Copies the snapshot last taken by GetImuSnapshot() without any reads.
+	 * Lock-free and consistent, so another thread (such as a logger) can
+	 * read while GetImuSnapshot() runs.
+	 *
+	 * @param snapshot Caller's snapshot to fill.
+	 */
+	void GetLastImuSnapshot(ImuSnapshot & snapshot) const;
 	/**
 	 * @return number of times Pigeon Reset
 	 */
@@ -568,6 +716,32 @@ public:
 	 * @return true iff a reset has occurred since last call.
 	 */
 	bool HasResetOccurred();
+	/**
+	 * Enables the client-side config shadow, see ConfigShadow.
+	 *
+	 * @param enable      true to enable the shadow, false to disable and clear it.
+	 * @param maxAgeMs    Entries older than this are read from the device again.
+	 *                    Zero to keep entries until the device resets.
+	 */
+	void EnableConfigShadow(bool enable, int maxAgeMs = 0);
+	/**
+	 * Clears the config shadow so the next config reads go to the device.
+	 */
+	void InvalidateConfigShadow();
+	/**
+	 * @return Checksum over the config shadow. Compare against a previously
+	 *         saved checksum to detect that the shadowed configuration changed.
+	 */
+	uint32_t GetConfigShadowChecksum();
+	/**
+	 * Reads back every shadowed parameter in a single batch and drops any entry
+	 * that no longer matches the device, so the next write of it goes through.
+	 *
+	 * @param mismatches  Filled with the number of shadowed parameters that did not match.
+	 * @param timeoutMs   Timeout value in ms for the entire readback.
+	 * @return Error Code generated by function. 0 indicates every parameter was read.
+	 */
+	ctre::phoenix::ErrorCode VerifyConfigShadow(int & mismatches, int timeoutMs = 50);
 
 	/**
 	 * Gets the string representation of a PigeonState
@@ -780,6 +954,21 @@ public:
      *              If zero, no blocking or checking is performed.
      */
     virtual void GetAllConfigs(PigeonIMUConfiguration &allConfigs, int timeoutMs = 50);
+    /**
+     * Gets all persistant settings using a single batched readback.
+     * All parameter requests are sent immediately, and the returned readback
+     * collects the responses in any order.  The entire readback is bounded by
+     * timeoutMs rather than one timeout per parameter.
+     *
+	 * @param allConfigs        Object to fill with all of the persistant settings.
+	 *                          Must outlive the returned readback.
+     * @param timeoutMs
+     *              Timeout value in ms for the entire readback.
+     *              If zero, no blocking is performed.
+     *
+     * @return Readback to Poll() or Wait() on.
+     */
+    ctre::phoenix::ConfigReadback GetAllConfigsAsync(PigeonIMUConfiguration &allConfigs, int timeoutMs = 50);
     /**
      * Configures all peristant settings to defaults.
      *
@@ -832,6 +1021,10 @@ private:
 	uint32_t _usageHist = 0;
 	uint64_t _cache;
 	uint32_t _len;
+	ctre::phoenix::ConfigShadow _configShadow;
+	ctre::phoenix::DeviceStats _stats;
+	ctre::phoenix::SeqLock<ImuSnapshot> _imuSnapshot;
+	ctre::phoenix::ConfigShadow & Shadow();
 
 	/** overall threshold for when frame data is too old */
 	const uint32_t EXPECTED_RESPONSE_TIMEOUT_MS = (200);